@@ -0,0 +1,1013 @@
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <list>
+#include <mutex>
+#include <numeric>
+#include <random>
+#include <set>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+#include "../s21_containers.h"
+#include "../s21_containersplus.h"
+
+namespace {
+
+using bench_clock = std::chrono::steady_clock;
+
+// Results are written here so the measured loops are not optimized away.
+volatile long long sink;
+
+template <typename F>
+double seconds(F&& f) {
+  const auto start = bench_clock::now();
+  f();
+  return std::chrono::duration<double>(bench_clock::now() - start).count();
+}
+
+void report(const char* name, std::size_t threads, std::size_t ops,
+            double sec) {
+  std::printf("%-44s threads=%-3zu %10.2f Mops/s %9.3f s\n", name, threads,
+              double(ops) / sec / 1e6, sec);
+}
+
+// 1, 2, 4, ... up to max (inclusive, max itself always present).
+std::vector<std::size_t> thread_counts(std::size_t max) {
+  std::vector<std::size_t> res;
+
+  for (std::size_t i = 1; i < max; i *= 2) {
+    res.push_back(i);
+  }
+  res.push_back(max);
+
+  return res;
+}
+
+std::size_t max_threads() {
+  return std::max<std::size_t>(2, std::thread::hardware_concurrency());
+}
+
+void spin_wait(std::size_t& misses) {
+  if (++misses % 64 == 0) {
+    std::this_thread::yield();
+  }
+}
+
+// queue benchmarks
+
+template <typename Queue>
+void bench_queue_push_pop(const char* name) {
+  constexpr std::size_t n = 10000000;
+  Queue queue;
+  long long sum = 0;
+
+  const double sec = seconds([&] {
+    for (std::size_t i = 0; i < n; ++i) {
+      queue.push(int(i));
+      if (queue.size() > 64) {
+        sum += queue.front();
+        queue.pop();
+      }
+    }
+  });
+  sink = sum;
+  report(name, 1, n, sec);
+}
+
+void bench_spsc_queue() {
+  constexpr std::size_t n = 20000000;
+  s21::spsc_queue<std::size_t> queue(4096);
+  std::size_t sum = 0;
+
+  const double sec = seconds([&] {
+    std::thread producer([&] {
+      std::size_t misses = 0;
+
+      for (std::size_t i = 0; i < n;) {
+        if (queue.try_push(i)) {
+          ++i;
+        } else {
+          spin_wait(misses);
+        }
+      }
+    });
+
+    std::size_t misses = 0;
+    std::size_t buf[64];
+
+    for (std::size_t got = 0; got < n;) {
+      const std::size_t k = queue.pop_bulk(buf, 64);
+
+      if (k == 0) {
+        spin_wait(misses);
+      }
+      for (std::size_t j = 0; j < k; ++j) {
+        sum += buf[j];
+      }
+      got += k;
+    }
+    producer.join();
+  });
+  sink = (long long)sum;
+  report("spsc_queue try_push/pop_bulk", 2, n, sec);
+}
+
+// Runs producers pushing per_thread items each and as many consumers popping
+// until everything has been seen.
+template <typename Push, typename Pop>
+double run_producers_consumers(std::size_t threads, std::size_t per_thread,
+                               Push push, Pop pop) {
+  std::atomic<std::size_t> popped{0};
+  const std::size_t n = threads * per_thread;
+
+  return seconds([&] {
+    std::vector<std::thread> workers;
+
+    for (std::size_t t = 0; t < threads; ++t) {
+      workers.emplace_back([&] {
+        std::size_t misses = 0;
+
+        for (std::size_t i = 0; i < per_thread;) {
+          if (push(i)) {
+            ++i;
+          } else {
+            spin_wait(misses);
+          }
+        }
+      });
+      workers.emplace_back([&] {
+        std::size_t misses = 0;
+        std::size_t val = 0;
+
+        while (popped.load(std::memory_order_relaxed) < n) {
+          if (pop(val)) {
+            popped.fetch_add(1, std::memory_order_relaxed);
+          } else {
+            spin_wait(misses);
+          }
+        }
+      });
+    }
+
+    for (auto& worker : workers) {
+      worker.join();
+    }
+  });
+}
+
+void bench_mpmc_vs_mutex_queue() {
+  constexpr std::size_t total = 4000000;
+
+  for (std::size_t threads : thread_counts(max_threads())) {
+    const std::size_t per_thread = total / threads;
+
+    s21::mpmc_queue<std::size_t> mpmc(4096);
+    report("mpmc_queue try_push/try_pop", threads * 2, per_thread * threads,
+           run_producers_consumers(
+               threads, per_thread,
+               [&](std::size_t v) { return mpmc.try_push(v); },
+               [&](std::size_t& v) { return mpmc.try_pop(v); }));
+
+    std::mutex mutex;
+    s21::queue<std::size_t> locked;
+    report("std::mutex + s21::queue", threads * 2, per_thread * threads,
+           run_producers_consumers(
+               threads, per_thread,
+               [&](std::size_t v) {
+                 std::lock_guard<std::mutex> lock(mutex);
+                 return locked.push(v), true;
+               },
+               [&](std::size_t& v) {
+                 std::lock_guard<std::mutex> lock(mutex);
+                 if (locked.empty()) {
+                   return false;
+                 }
+                 v = locked.front();
+                 locked.pop();
+                 return true;
+               }));
+  }
+}
+
+// list benchmarks
+
+template <typename List>
+void bench_list_sort(const char* name) {
+  constexpr std::size_t n = 1000000;
+  List list;
+
+  for (std::size_t i = 0; i < n; ++i) {
+    list.push_back(int(i * 2654435761u % 1000003));
+  }
+
+  const double sec = seconds([&] { list.sort(); });
+  sink = list.front();
+  report(name, 1, n, sec);
+}
+
+// push_back, then sum the whole list a few times.
+template <typename List>
+void bench_list_iterate(const char* name) {
+  constexpr std::size_t n = 1000000;
+  constexpr std::size_t passes = 20;
+  List list;
+
+  const double fill = seconds([&] {
+    for (std::size_t i = 0; i < n; ++i) {
+      list.push_back(int(i));
+    }
+  });
+  report((std::string(name) + " push_back").c_str(), 1, n, fill);
+
+  const double sec = seconds([&] {
+    long long sum = 0;
+
+    for (std::size_t pass = 0; pass < passes; ++pass) {
+      for (int val : list) {
+        sum += val;
+      }
+    }
+    sink = sum;
+  });
+  report((std::string(name) + " iterate").c_str(), 1, n * passes, sec);
+}
+
+// Inserts through a cursor that drifts towards the end, so insertions land
+// in the middle of the list rather than at either end.
+template <typename List>
+void bench_list_insert(const char* name) {
+  constexpr std::size_t n = 1000000;
+  List list{0};
+  auto it = list.begin();
+
+  const double sec = seconds([&] {
+    for (std::size_t i = 0; i < n; ++i) {
+      it = list.insert(it, int(i));
+      if (i % 3 == 0) {
+        ++it;
+      }
+    }
+  });
+  sink = list.back();
+  report((std::string(name) + " insert").c_str(), 1, n, sec);
+}
+
+// Many short lists of small ids, filled round-robin, then iterated.
+void bench_compact_list() {
+  constexpr std::size_t lists = 10000;
+  constexpr std::size_t n = 1000000;
+  s21::compact_list_pool<int> pool;
+  std::vector<s21::compact_list<int>> compact;
+  std::vector<s21::list<int>> plain(lists);
+
+  compact.reserve(lists);
+  for (std::size_t i = 0; i < lists; ++i) {
+    compact.emplace_back(pool);
+  }
+
+  report("s21::compact_list push_back", 1, n, seconds([&] {
+           for (std::size_t i = 0; i < n; ++i) {
+             compact[i % lists].push_back(int(i));
+           }
+         }));
+  report("s21::list push_back", 1, n, seconds([&] {
+           for (std::size_t i = 0; i < n; ++i) {
+             plain[i % lists].push_back(int(i));
+           }
+         }));
+
+  long long sum = 0;
+  report("s21::compact_list iterate", 1, n, seconds([&] {
+           for (const auto& list : compact) {
+             for (int val : list) {
+               sum += val;
+             }
+           }
+         }));
+  report("s21::list iterate", 1, n, seconds([&] {
+           for (const auto& list : plain) {
+             for (int val : list) {
+               sum += val;
+             }
+           }
+         }));
+  sink = sum;
+
+  std::printf("link+value bytes per element: compact_list %zu, list %zu\n",
+              pool.node_size(), sizeof(s21::details::list_node<int>));
+}
+
+// parallel algorithm benchmarks
+
+void bench_par_algorithms() {
+  constexpr std::size_t n = 10000000;
+  const std::size_t threads =
+      s21::thread_pool::instance().concurrency();
+  s21::vector<int> vec;
+  std::vector<int> copy(n);
+
+  for (std::size_t i = 0; i < n; ++i) {
+    vec.push_back(int(i * 2654435761u % 1000003));
+  }
+
+  report("s21::reduce(par, vector)", threads, n,
+         seconds([&] { sink = s21::reduce(s21::par, vec, 0LL); }));
+  report("std::accumulate(vector)", 1, n, seconds([&] {
+           sink = std::accumulate(vec.begin(), vec.end(), 0LL);
+         }));
+  report("s21::copy(par, vector)", threads, n,
+         seconds([&] { s21::copy(s21::par, vec, copy.begin()); }));
+  report("s21::sort(par, vector)", threads, n,
+         seconds([&] { s21::sort(s21::par, vec); }));
+  report("std::sort(vector)", 1, n,
+         seconds([&] { std::sort(copy.begin(), copy.end()); }));
+
+  s21::set<int> set;
+  for (std::size_t i = 0; i < n / 10; ++i) {
+    set.insert(int(i));
+  }
+  report("s21::count_if(par, set)", threads, n / 10, seconds([&] {
+           sink = s21::count_if(s21::par, set, [](int val) { return val & 1; });
+         }));
+  report("std::count_if(set)", 1, n / 10, seconds([&] {
+           sink = std::count_if(set.begin(), set.end(),
+                                [](int val) { return val & 1; });
+         }));
+}
+
+// thread pool benchmarks
+
+// Fork-join sum over [from, to) cut down to single elements: measures the
+// cost of spawning, stealing and joining tasks.
+long long fork_join_sum(s21::thread_pool& pool, long long from, long long to) {
+  if (to - from == 1) {
+    return from;
+  }
+
+  const long long mid = from + (to - from) / 2;
+  long long left = 0;
+  s21::wait_group group(pool);
+
+  group.run([&] { left = fork_join_sum(pool, from, mid); });
+  const long long right = fork_join_sum(pool, mid, to);
+  group.wait();
+
+  return left + right;
+}
+
+template <typename Iterator>
+void fork_join_sort(s21::thread_pool& pool, Iterator first, Iterator last) {
+  if (last - first <= 1 << 14) {
+    std::sort(first, last);
+    return;
+  }
+
+  const Iterator mid = first + (last - first) / 2;
+  s21::wait_group group(pool);
+
+  group.run([&] { fork_join_sort(pool, first, mid); });
+  fork_join_sort(pool, mid, last);
+  group.wait();
+  std::inplace_merge(first, mid, last);
+}
+
+void bench_thread_pool() {
+  constexpr std::size_t tasks = 1 << 20;
+  constexpr std::size_t n = 4000000;
+  constexpr std::size_t sets = 64;
+  constexpr std::size_t keys = n / 4;
+
+  for (std::size_t threads : thread_counts(max_threads())) {
+    s21::thread_pool pool(threads - 1);
+
+    report("thread_pool fork-join tasks", threads, tasks, seconds([&] {
+             sink = fork_join_sum(pool, 0, tasks);
+           }));
+
+    s21::vector<int> vec;
+    for (std::size_t i = 0; i < n; ++i) {
+      vec.push_back(int(i * 2654435761u % 1000003));
+    }
+    report("thread_pool merge sort", threads, n, seconds([&] {
+             fork_join_sort(pool, vec.begin(), vec.end());
+           }));
+
+    // Build sets in parallel, then merge them pairwise, one parallel_for
+    // per level of the merge tree.
+    std::vector<s21::set<int>> parts(sets);
+    report("thread_pool tree merge", threads, keys, seconds([&] {
+             pool.parallel_for(std::size_t(0), sets, [&](std::size_t i) {
+               for (std::size_t j = i; j < keys; j += sets) {
+                 parts[i].insert(int(j * 2654435761u % keys));
+               }
+             });
+             for (std::size_t step = 1; step < sets; step *= 2) {
+               pool.parallel_for(std::size_t(0), sets / (2 * step),
+                                 [&](std::size_t i) {
+                                   parts[2 * step * i].merge(
+                                       parts[2 * step * i + step]);
+                                 });
+             }
+           }));
+    sink = parts[0].size();
+  }
+}
+
+void bench_par_sort() {
+  constexpr std::size_t n = 10000000;
+  const std::size_t threads = s21::thread_pool::instance().concurrency();
+  s21::vector<long long> keys;
+  s21::vector<long long> work;
+  s21::vector<long long> scratch;
+  std::vector<long long> std_work;
+
+  std::mt19937_64 gen(39);
+
+  for (std::size_t i = 0; i < n; ++i) {
+    keys.push_back((long long)gen());
+  }
+  auto reset = [&] {
+    work = keys;
+    std_work.assign(keys.begin(), keys.end());
+  };
+
+  reset();
+  report("s21::sort(par, vector<int64>) radix", threads, n,
+         seconds([&] { s21::sort(s21::par, work, std::less<>(), scratch); }));
+  reset();
+  report("s21::sort(par, vector<int64>) merge", threads, n, seconds([&] {
+           s21::sort(s21::par, work, std::greater<>(), scratch);
+         }));
+  report("std::sort(vector<int64>)", 1, n,
+         seconds([&] { std::sort(std_work.begin(), std_work.end()); }));
+  reset();
+  report("s21::stable_sort(par, vector<int64>)", threads, n, seconds([&] {
+           s21::stable_sort(s21::par, work, std::less<>(), scratch);
+         }));
+  report("std::stable_sort(vector<int64>)", 1, n, seconds([&] {
+           std::stable_sort(std_work.begin(), std_work.end());
+         }));
+
+  s21::vector<double> doubles;
+  for (std::size_t i = 0; i < n; ++i) {
+    doubles.push_back(double(keys[i] % 1000000007) / 3.0);
+  }
+  std::vector<double> std_doubles(doubles.begin(), doubles.end());
+  report("s21::radix_sort(par, vector<double>)", threads, n,
+         seconds([&] { s21::radix_sort(s21::par, doubles); }));
+  report("std::sort(vector<double>)", 1, n,
+         seconds([&] { std::sort(std_doubles.begin(), std_doubles.end()); }));
+}
+
+// aligned storage benchmarks
+
+// y += a * x over n floats, the inner loop of many vectorized kernels. Align
+// is what the compiler may assume about x and y.
+template <std::size_t Align>
+void saxpy(float* y, const float* x, float a, std::size_t n) {
+  y = s21::assume_aligned<Align>(y);
+  x = s21::assume_aligned<Align>(x);
+  for (std::size_t i = 0; i < n; ++i) {
+    y[i] += a * x[i];
+  }
+}
+
+void bench_aligned_vector() {
+  constexpr std::size_t n = 4096;
+  constexpr std::size_t rounds = 20000;
+  s21::aligned_vector<float> x(n + 16, 1.0f);
+  s21::aligned_vector<float> y(n + 16, 0.0f);
+
+  // Both loops are short and compute bound, so take the best of a few runs
+  // to keep clock ramp-up out of the comparison.
+  auto best_of = [&](auto kernel) {
+    double best = seconds(kernel);
+
+    for (int i = 0; i < 4; ++i) {
+      best = std::min(best, seconds(kernel));
+    }
+    return best;
+  };
+
+  report("saxpy on 64-byte aligned data()", 1, n * rounds, best_of([&] {
+           for (std::size_t r = 0; r < rounds; ++r) {
+             saxpy<64>(y.data(), x.data(), 0.5f, n);
+           }
+         }));
+  // One float in, every 64-byte vector load straddles two cache lines.
+  report("saxpy on data() + 1", 1, n * rounds, best_of([&] {
+           for (std::size_t r = 0; r < rounds; ++r) {
+             saxpy<alignof(float)>(y.data() + 1, x.data() + 1, 0.5f, n);
+           }
+         }));
+  sink = static_cast<long long>(y[n / 2]);
+}
+
+// mdspan benchmarks
+
+// b(j, i) = a(i, j) visited in a's storage order. Row-major writes to b jump
+// a whole row per element; with tiles both sides stay inside one 8 KiB tile.
+template <typename Layout>
+double transpose_seconds(std::size_t n, std::size_t rounds) {
+  s21::mdarray<double, s21::dextents<2>, Layout> a(n, n);
+  s21::mdarray<double, s21::dextents<2>, Layout> b(n, n);
+
+  s21::for_each_index(a, [&](std::size_t i, std::size_t j) {
+    a(i, j) = double(i * n + j);
+  });
+
+  const double res = seconds([&] {
+    for (std::size_t r = 0; r < rounds; ++r) {
+      s21::for_each_index(a, [&](std::size_t i, std::size_t j) {
+        b(j, i) = a(i, j);
+      });
+    }
+  });
+  sink = static_cast<long long>(b(1, 0));
+  return res;
+}
+
+void bench_mdspan() {
+  constexpr std::size_t n = 2048;
+  constexpr std::size_t rounds = 10;
+
+  report("transpose mdarray<layout_right>", 1, n * n * rounds,
+         transpose_seconds<s21::layout_right>(n, rounds));
+  report("transpose mdarray<layout_tiled<32, 32>>", 1, n * n * rounds,
+         transpose_seconds<s21::layout_tiled<32, 32>>(n, rounds));
+}
+
+// soa_vector benchmarks
+
+struct particle {
+  float x, y, z;
+  float vx, vy, vz;
+  float mass, charge;
+};
+
+// Total mass: one field out of eight. The vector of structs reads whole
+// 32-byte particles, the soa_vector only the masses.
+void bench_soa_vector() {
+  constexpr std::size_t n = 1 << 22;
+  constexpr std::size_t rounds = 20;
+  s21::vector<particle> aos;
+  s21::soa_vector<float, float, float, float, float, float, float, float> soa;
+
+  aos.reserve(n);
+  soa.reserve(n);
+  for (std::size_t i = 0; i < n; ++i) {
+    const float f = float(i % 1000);
+    aos.push_back({f, f, f, f, f, f, f, f});
+    soa.emplace_back(f, f, f, f, f, f, f, f);
+  }
+
+  double total = 0;
+  report("sum of mass in vector<particle>", 1, n * rounds, seconds([&] {
+           for (std::size_t r = 0; r < rounds; ++r) {
+             float sum = 0;
+             for (const particle& p : aos) {
+               sum += p.mass;
+             }
+             total += sum;
+           }
+         }));
+  report("sum of mass in soa_vector::field<6>()", 1, n * rounds, seconds([&] {
+           for (std::size_t r = 0; r < rounds; ++r) {
+             float sum = 0;
+             for (float mass : soa.field<6>()) {
+               sum += mass;
+             }
+             total += sum;
+           }
+         }));
+  sink = static_cast<long long>(total);
+}
+
+// stack benchmarks
+
+// Every thread pushes and then pops per_thread times, so all of them fight
+// over the top of the stack.
+template <typename Push, typename Pop>
+double run_push_pop_pairs(std::size_t threads, std::size_t per_thread,
+                          Push push, Pop pop) {
+  return seconds([&] {
+    std::vector<std::thread> workers;
+
+    for (std::size_t t = 0; t < threads; ++t) {
+      workers.emplace_back([&] {
+        std::size_t misses = 0;
+        std::size_t val = 0;
+        long long sum = 0;
+
+        for (std::size_t i = 0; i < per_thread; ++i) {
+          push(i);
+          while (!pop(val)) {
+            spin_wait(misses);
+          }
+          sum += (long long)val;
+        }
+        sink = sum;
+      });
+    }
+
+    for (auto& worker : workers) {
+      worker.join();
+    }
+  });
+}
+
+template <bool Elimination>
+void bench_concurrent_stack(const char* name) {
+  constexpr std::size_t total = 2000000;
+
+  for (std::size_t threads : thread_counts(64)) {
+    const std::size_t per_thread = total / threads;
+    s21::concurrent_stack<std::size_t, Elimination> stack;
+
+    report(name, threads, per_thread * threads * 2,
+           run_push_pop_pairs(
+               threads, per_thread, [&](std::size_t v) { stack.push(v); },
+               [&](std::size_t& v) { return stack.try_pop(v); }));
+  }
+}
+
+void bench_mutex_stack() {
+  constexpr std::size_t total = 2000000;
+
+  for (std::size_t threads : thread_counts(64)) {
+    const std::size_t per_thread = total / threads;
+    std::mutex mutex;
+    s21::stack<std::size_t> stack;
+
+    report("std::mutex + s21::stack", threads, per_thread * threads * 2,
+           run_push_pop_pairs(
+               threads, per_thread,
+               [&](std::size_t v) {
+                 std::lock_guard<std::mutex> lock(mutex);
+                 stack.push(v);
+               },
+               [&](std::size_t& v) {
+                 std::lock_guard<std::mutex> lock(mutex);
+                 if (stack.empty()) {
+                   return false;
+                 }
+                 v = stack.top();
+                 stack.pop();
+                 return true;
+               }));
+  }
+}
+
+// map benchmarks
+
+// Every thread inserts per_thread keys of its own, looks each of them up and
+// erases half of them again. Keys are scattered so threads do not follow each
+// other through the same part of the map.
+template <typename Insert, typename Find, typename Erase>
+double run_map_workload(std::size_t threads, std::size_t per_thread,
+                        Insert insert, Find find, Erase erase) {
+  return seconds([&] {
+    std::vector<std::thread> workers;
+
+    for (std::size_t t = 0; t < threads; ++t) {
+      workers.emplace_back([&, t] {
+        const auto key = [&](std::size_t i) {
+          return (i * threads + t) * 2654435761u % 4294967291u;
+        };
+        long long found = 0;
+
+        for (std::size_t i = 0; i < per_thread; ++i) {
+          insert(key(i));
+        }
+        for (std::size_t i = 0; i < per_thread; ++i) {
+          found += find(key(i));
+        }
+        for (std::size_t i = 0; i < per_thread; i += 2) {
+          erase(key(i));
+        }
+        sink = found;
+      });
+    }
+
+    for (auto& worker : workers) {
+      worker.join();
+    }
+  });
+}
+
+void bench_concurrent_map() {
+  constexpr std::size_t total = 400000;
+
+  for (std::size_t threads : thread_counts(max_threads())) {
+    const std::size_t per_thread = total / threads;
+    const std::size_t ops = per_thread * threads * 5 / 2;
+
+    s21::concurrent_map<std::size_t, std::size_t> skip_list;
+    report("concurrent_map insert/find/erase", threads, ops,
+           run_map_workload(
+               threads, per_thread,
+               [&](std::size_t k) { skip_list.insert(k, k); },
+               [&](std::size_t k) { return skip_list.contains(k); },
+               [&](std::size_t k) { skip_list.erase(k); }));
+
+    std::mutex mutex;
+    s21::map<std::size_t, std::size_t> locked;
+    report("std::mutex + s21::map", threads, ops,
+           run_map_workload(
+               threads, per_thread,
+               [&](std::size_t k) {
+                 std::lock_guard<std::mutex> lock(mutex);
+                 locked.insert(k, k);
+               },
+               [&](std::size_t k) {
+                 std::lock_guard<std::mutex> lock(mutex);
+                 return locked.contains(k);
+               },
+               [&](std::size_t k) {
+                 std::lock_guard<std::mutex> lock(mutex);
+                 locked.erase(k);
+               }));
+  }
+}
+
+void bench_set_bulk_load() {
+  constexpr std::size_t n = 2000000;
+  std::mt19937_64 gen(40);
+  std::vector<std::uint64_t> keys(n);
+
+  for (auto& key : keys) {
+    key = gen();
+  }
+
+  s21::set<std::uint64_t> inserted;
+  report("s21::set insert loop", 1, n, seconds([&] {
+           for (std::uint64_t key : keys) {
+             inserted.insert(key);
+           }
+         }));
+  s21::set<std::uint64_t> loaded;
+  report("s21::set::assign_unsorted", 1, n, seconds([&] {
+           loaded.assign_unsorted(keys.begin(), keys.end());
+         }));
+  report("std::set range constructor", 1, n, seconds([&] {
+           sink = std::set<std::uint64_t>(keys.begin(), keys.end()).size();
+         }));
+  sink = loaded.size() == inserted.size();
+}
+
+// Snapshot and restore of a map and a vector through an in-memory stream.
+// The map is restored by a linear-time sorted build; the baseline rebuilds
+// it with one insert per element.
+void bench_serialize() {
+  constexpr std::size_t n = 1000000;
+  std::mt19937_64 gen(46);
+  s21::map<std::uint64_t, double> tree;
+  s21::vector<double> values(16 * n, 0.5);
+
+  for (std::size_t i = 0; i < n; ++i) {
+    tree.insert(gen(), double(i));
+  }
+
+  std::stringstream stream;
+  report("s21::serialize(map<u64, double>)", 1, n,
+         seconds([&] { s21::serialize(stream, tree); }));
+  s21::map<std::uint64_t, double> restored;
+  report("s21::deserialize(map<u64, double>)", 1, n,
+         seconds([&] { s21::deserialize(stream, restored); }));
+  s21::map<std::uint64_t, double> rebuilt;
+  report("map insert loop over the same pairs", 1, n, seconds([&] {
+           for (const auto& item : tree) {
+             rebuilt.insert(item);
+           }
+         }));
+
+  std::stringstream bulk;
+  report("s21::serialize(vector<double>)", 1, values.size(),
+         seconds([&] { s21::serialize(bulk, values); }));
+  s21::vector<double> values_in;
+  report("s21::deserialize(vector<double>)", 1, values.size(),
+         seconds([&] { s21::deserialize(bulk, values_in); }));
+  sink = restored.size() + rebuilt.size() + values_in.size();
+}
+
+// Startup and lookups of a read-only table: rebuilding the tree from a
+// snapshot against mapping a frozen file, then random finds in each.
+void bench_frozen_map() {
+  constexpr std::size_t n = 2000000;
+  constexpr std::size_t queries = 4000000;
+  std::mt19937_64 gen(47);
+  s21::map<std::uint64_t, std::uint64_t> tree;
+  std::vector<std::uint64_t> keys;
+
+  for (std::size_t i = 0; i < n; ++i) {
+    keys.push_back(gen());
+    tree.insert(keys.back(), i);
+  }
+  for (std::size_t i = 0; i < queries; ++i) {
+    keys.push_back(keys[gen() % n]);
+  }
+  keys.erase(keys.begin(), keys.begin() + n);
+
+  const std::string path = "/tmp/s21_bench_frozen_map";
+  std::stringstream snapshot;
+  s21::serialize(snapshot, tree);
+  tree.write_frozen(path + ".sorted", s21::frozen_layout::sorted);
+  tree.write_frozen(path);
+
+  s21::map<std::uint64_t, std::uint64_t> restored;
+  report("startup: s21::deserialize(map)", 1, n,
+         seconds([&] { s21::deserialize(snapshot, restored); }));
+  using view_type = s21::frozen_map_view<std::uint64_t, std::uint64_t>;
+  report("startup: frozen_map_view(path)", 1, n,
+         seconds([&] { sink = view_type(path).size(); }));
+
+  auto lookups = [&](const auto& table) {
+    return seconds([&] {
+      std::uint64_t sum = 0;
+      for (std::uint64_t key : keys) {
+        sum += table.find(key)->second;
+      }
+      sink = static_cast<long long>(sum);
+    });
+  };
+  const view_type sorted(path + ".sorted");
+  const view_type eytzinger(path);
+  report("s21::map::find", 1, queries, lookups(restored));
+  report("frozen_map_view::find, sorted", 1, queries, lookups(sorted));
+  report("frozen_map_view::find, eytzinger", 1, queries, lookups(eytzinger));
+  std::remove((path + ".sorted").c_str());
+  std::remove(path.c_str());
+}
+
+// Churn scatters the nodes of a long-lived map over the heap; compact()
+// puts them back together without rebuilding the tree.
+void bench_tree_compact() {
+  constexpr std::size_t n = 1000000;
+  constexpr std::size_t queries = 4000000;
+  std::mt19937_64 gen(50);
+  s21::map<std::uint64_t, std::uint64_t> tree;
+  std::vector<std::uint64_t> keys;
+  std::vector<char*> noise;
+
+  for (std::size_t i = 0; i < n; ++i) {
+    keys.push_back(gen());
+    tree.insert(keys.back(), i);
+    noise.push_back(new char[gen() % 256 + 1]);
+  }
+  for (std::size_t i = 0; i < n; ++i) {
+    const std::size_t pos = gen() % n;
+    tree.erase(keys[pos]);
+    keys[pos] = gen();
+    tree.insert(keys[pos], i);
+  }
+  for (char* p : noise) {
+    delete[] p;
+  }
+
+  std::vector<std::uint64_t> lookup_keys;
+  for (std::size_t i = 0; i < queries; ++i) {
+    lookup_keys.push_back(keys[gen() % n]);
+  }
+  auto lookups = [&] {
+    return seconds([&] {
+      std::uint64_t sum = 0;
+      for (std::uint64_t key : lookup_keys) {
+        sum += tree.find(key)->second;
+      }
+      sink = static_cast<long long>(sum);
+    });
+  };
+
+  std::printf("fragmentation %.2f\n", tree.profile(1000).fragmentation());
+  report("s21::map::find, after churn", 1, queries, lookups());
+  report("s21::map::compact(in_order)", 1, n,
+         seconds([&] { tree.compact(s21::compact_order::in_order); }));
+  std::printf("fragmentation %.2f\n", tree.profile(1000).fragmentation());
+  report("s21::map::find, in order", 1, queries, lookups());
+  report("s21::map::compact(van_emde_boas)", 1, n,
+         seconds([&] { tree.compact(); }));
+  std::printf("fragmentation %.2f\n", tree.profile(1000).fragmentation());
+  report("s21::map::find, van Emde Boas", 1, queries, lookups());
+}
+
+constexpr s21::static_map<std::string_view, int, 16> bench_keywords({
+    {"GET", 0},      {"HEAD", 1},    {"POST", 2},   {"PUT", 3},
+    {"DELETE", 4},   {"CONNECT", 5}, {"OPTIONS", 6}, {"TRACE", 7},
+    {"PATCH", 8},    {"Host", 9},    {"Accept", 10}, {"Cookie", 11},
+    {"Referer", 12}, {"Origin", 13}, {"Range", 14},  {"Upgrade", 15},
+});
+
+void bench_static_map() {
+  constexpr std::size_t n = 4000000;
+  s21::map<std::string, int> tree;
+  std::unordered_map<std::string, int> hashed;
+  std::vector<std::string> queries;
+
+  for (const auto& [key, value] : bench_keywords) {
+    tree.insert(std::string(key), value);
+    hashed.emplace(key, value);
+    queries.emplace_back(key);
+  }
+  queries.emplace_back("Unknown");
+
+  auto run = [&](const char* name, auto lookup) {
+    long long sum = 0;
+    report(name, 1, n, seconds([&] {
+             for (std::size_t i = 0; i < n; ++i) {
+               sum += lookup(queries[i % queries.size()]);
+             }
+           }));
+    sink = sum;
+  };
+
+  run("s21::static_map<string_view> find", [](const std::string& key) {
+    auto it = bench_keywords.find(key);
+    return it == bench_keywords.end() ? -1 : it->second;
+  });
+  run("s21::map<string> find", [&](const std::string& key) {
+    auto it = tree.find(key);
+    return it == tree.end() ? -1 : it->second;
+  });
+  run("std::unordered_map<string> find", [&](const std::string& key) {
+    auto it = hashed.find(key);
+    return it == hashed.end() ? -1 : it->second;
+  });
+}
+
+struct benchmark {
+  const char* name;
+  void (*run)();
+};
+
+const benchmark benchmarks[] = {
+    {"queue_ring_buffer",
+     [] {
+       bench_queue_push_pop<s21::queue<int>>(
+           "s21::queue<ring_buffer> push/pop");
+     }},
+    {"queue_deque",
+     [] {
+       bench_queue_push_pop<s21::queue<int, s21::deque<int>>>(
+           "s21::queue<deque> push/pop");
+     }},
+    {"queue_list",
+     [] {
+       bench_queue_push_pop<s21::queue<int, s21::list<int>>>(
+           "s21::queue<list> push/pop");
+     }},
+    {"list_sort",
+     [] {
+       bench_list_sort<s21::list<int>>("s21::list::sort");
+       bench_list_sort<std::list<int>>("std::list::sort");
+     }},
+    {"unrolled_list",
+     [] {
+       bench_list_iterate<s21::unrolled_list<int>>("s21::unrolled_list");
+       bench_list_iterate<s21::list<int>>("s21::list");
+       bench_list_insert<s21::unrolled_list<int>>("s21::unrolled_list");
+       bench_list_insert<s21::list<int>>("s21::list");
+     }},
+    {"compact_list", bench_compact_list},
+    {"par_algorithms", bench_par_algorithms},
+    {"thread_pool", bench_thread_pool},
+    {"par_sort", bench_par_sort},
+    {"set_bulk_load", bench_set_bulk_load},
+    {"static_map", bench_static_map},
+    {"aligned_vector", bench_aligned_vector},
+    {"mdspan", bench_mdspan},
+    {"soa_vector", bench_soa_vector},
+    {"serialize", bench_serialize},
+    {"frozen_map", bench_frozen_map},
+    {"tree_compact", bench_tree_compact},
+    {"spsc_queue", bench_spsc_queue},
+    {"mpmc_queue", bench_mpmc_vs_mutex_queue},
+    {"concurrent_stack",
+     [] {
+       bench_concurrent_stack<false>("concurrent_stack push/try_pop");
+       bench_concurrent_stack<true>("concurrent_stack<elimination>");
+     }},
+    {"mutex_stack", bench_mutex_stack},
+    {"concurrent_map", bench_concurrent_map},
+};
+
+}  // namespace
+
+// Usage: ./bench.out [substring], runs every benchmark whose name contains the
+// substring (all of them by default).
+int main(int argc, char** argv) {
+  const char* filter = argc > 1 ? argv[1] : "";
+
+  for (const auto& bench : benchmarks) {
+    if (std::strstr(bench.name, filter)) {
+      bench.run();
+    }
+  }
+
+  return 0;
+}
@@ -6,15 +6,84 @@
 #include <algorithm>
 #include <cstdint>
 #include <initializer_list>
+#include <limits>
 #include <memory>
+#include <new>
 #include <stdexcept>
+#include <type_traits>
 
+#include "../source/s21_radix_sort.h"
+#include "../source/s21_stats.h"
 #include "../source/s21_vector.h"
 
 namespace s21 {
 
+// Shape of a set, multiset or map, as measured by profile(). A path is what
+// a lookup walks from the root, its depth the nodes on it, the root alone
+// being depth 1. Nodes are placed on page_size_ byte pages of the address
+// space, so the pages of a path are the distinct ones its nodes lie on.
+struct tree_profile {
+  static constexpr std::size_t page_size_ = 4096;
+
+  // 0 for an empty tree.
+  double average_depth() const noexcept {
+    return paths_ ? double(depth_sum_) / double(paths_) : 0;
+  }
+  double average_pages() const noexcept {
+    return paths_ ? double(pages_sum_) / double(paths_) : 0;
+  }
+  double red_ratio() const noexcept {
+    return red_ + black_ ? double(red_) / double(red_ + black_) : 0;
+  }
+  // Share of steps below the root that land on a page the path has not
+  // touched yet: 0 when every path stays on one page, 1 when each step
+  // goes to a new one.
+  double fragmentation() const noexcept {
+    return depth_sum_ > paths_ ? double(pages_sum_ - paths_) /
+                                     double(depth_sum_ - paths_)
+                               : 0;
+  }
+
+  std::size_t size_;          // nodes in the tree
+  std::size_t black_height_;  // black nodes on every root-to-leaf path
+  std::size_t paths_;         // paths measured
+  std::size_t height_;        // depth of the deepest path measured
+  std::size_t depth_sum_;     // depths of the paths measured, summed
+  std::size_t max_pages_;     // pages of the path touching the most
+  std::size_t pages_sum_;     // pages of the paths measured, summed
+  std::size_t red_;           // red nodes measured
+  std::size_t black_;         // black nodes measured
+};
+
+// Node layouts for compact(). In order puts neighbouring keys next to each
+// other, for scans. Van Emde Boas order stores the top half of the levels
+// first and then each subtree below them the same way, so a lookup stays
+// within few cache lines and pages at every scale.
+enum class compact_order : std::uint8_t { in_order, van_emde_boas };
+
 namespace details {
 
+// Where rebalancing reports its rotations and recolorings: nowhere, or to
+// the stats counters of one kind of container. rb_tree_stats_t picks the
+// first whenever stats are off, so all trees share one rebalancing code
+// with no counting in it.
+struct rb_tree_no_stats {
+  static constexpr bool counted_ = false;
+
+  static void count(stats::event) noexcept {}
+};
+
+template <stats::container Kind>
+struct rb_tree_stats {
+  static constexpr bool counted_ = true;
+
+  static void count(stats::event e) noexcept { stats::count(Kind, e); }
+};
+
+template <stats::container Kind>
+using rb_tree_stats_t = std::conditional_t<stats::enabled_, rb_tree_stats<Kind>,
+                                           rb_tree_no_stats>;
+
 class rb_tree_node_base {
  private:
   using this_type = rb_tree_node_base;
@@ -37,7 +106,8 @@ class rb_tree_node_base {
       : left_(this),
         right_(this),
         parent_(nullptr),
-        color_(node_color::black) {}
+        color_(node_color::black),
+        block_index_(0) {}
 
   this_type* increment() const noexcept;
   this_type* decrement() const noexcept;
@@ -45,22 +115,31 @@ class rb_tree_node_base {
   this_type* leftmost() const noexcept;
   this_type* rightmost() const noexcept;
 
+  // Stats receives the rebalancing counts, see rb_tree_no_stats.
+  template <typename Stats = rb_tree_no_stats>
   this_type* insert(this_type* const anchor, this_type* const parent,
                     const insertion_side side) noexcept;
+  template <typename Stats = rb_tree_no_stats>
   this_type* erase(this_type* const anchor) noexcept;
 
   static size_type black_amount(const this_type* const top,
                                 const this_type* const bottom) noexcept;
 
  private:
+  template <typename Stats>
   this_type* rotate_left(this_type* const node) const noexcept;
+  template <typename Stats>
   this_type* rotate_right(this_type* const node) const noexcept;
+  template <typename Stats>
+  static void recolor(this_type* const node, const node_color color) noexcept;
 
  public:
   this_type* left_;
   this_type* right_;
   this_type* parent_;
   node_color color_;
+  // Place of the node in a block made by compact(), 0 if allocated alone.
+  std::uint32_t block_index_;
 };
 
 rb_tree_node_base::this_type* rb_tree_node_base::increment() const noexcept {
@@ -141,6 +220,7 @@ rb_tree_node_base::this_type* rb_tree_node_base::rightmost() const noexcept {
   return const_cast<this_type*>(node);
 }
 
+template <typename Stats>
 rb_tree_node_base::this_type* rb_tree_node_base::insert(
     this_type* const anchor, this_type* const parent,
     const insertion_side side) noexcept {
@@ -176,45 +256,46 @@ rb_tree_node_base::this_type* rb_tree_node_base::insert(
       this_type* const tmp = parent_parent->right_;
 
       if (tmp && (tmp->color_ == node_color::red)) {
-        node->parent_->color_ = node_color::black;
-        tmp->color_ = node_color::black;
-        parent_parent->color_ = node_color::red;
+        recolor<Stats>(node->parent_, node_color::black);
+        recolor<Stats>(tmp, node_color::black);
+        recolor<Stats>(parent_parent, node_color::red);
         node = parent_parent;
       } else {
         if (node->parent_ && node == node->parent_->right_) {
           node = node->parent_;
-          root = root->rotate_left(node);
+          root = root->rotate_left<Stats>(node);
         }
 
-        node->parent_->color_ = node_color::black;
-        parent_parent->color_ = node_color::red;
-        root = root->rotate_right(parent_parent);
+        recolor<Stats>(node->parent_, node_color::black);
+        recolor<Stats>(parent_parent, node_color::red);
+        root = root->rotate_right<Stats>(parent_parent);
       }
     } else {
       this_type* const tmp = parent_parent->left_;
 
       if (tmp && (tmp->color_ == node_color::red)) {
-        node->parent_->color_ = node_color::black;
-        tmp->color_ = node_color::black;
-        parent_parent->color_ = node_color::red;
+        recolor<Stats>(node->parent_, node_color::black);
+        recolor<Stats>(tmp, node_color::black);
+        recolor<Stats>(parent_parent, node_color::red);
         node = parent_parent;
       } else {
         if (node == node->parent_->left_) {
           node = node->parent_;
-          root = root->rotate_right(node);
+          root = root->rotate_right<Stats>(node);
         }
 
-        node->parent_->color_ = node_color::black;
-        parent_parent->color_ = node_color::red;
-        root = root->rotate_left(parent_parent);
+        recolor<Stats>(node->parent_, node_color::black);
+        recolor<Stats>(parent_parent, node_color::red);
+        root = root->rotate_left<Stats>(parent_parent);
       }
     }
   }
-  root->color_ = node_color::black;
+  recolor<Stats>(root, node_color::black);
 
   return anchor;
 }
 
+template <typename Stats>
 rb_tree_node_base::this_type* rb_tree_node_base::erase(
     this_type* const anchor) noexcept {
   this_type* node = this;
@@ -309,75 +390,75 @@ rb_tree_node_base::this_type* rb_tree_node_base::erase(
         this_type* tmp = child_parent->right_;
 
         if (tmp->color_ == node_color::red) {
-          tmp->color_ = node_color::black;
-          child_parent->color_ = node_color::red;
-          root = root->rotate_left(child_parent);
+          recolor<Stats>(tmp, node_color::black);
+          recolor<Stats>(child_parent, node_color::red);
+          root = root->rotate_left<Stats>(child_parent);
           tmp = child_parent->right_;
         }
 
         if (((!tmp->left_) || (tmp->left_->color_ == node_color::black)) &&
             ((!tmp->right_) || (tmp->right_->color_ == node_color::black))) {
-          tmp->color_ = node_color::red;
+          recolor<Stats>(tmp, node_color::red);
           child = child_parent;
           child_parent = child_parent->parent_;
         } else {
           if ((!tmp->right_) || (tmp->right_->color_ == node_color::black)) {
-            tmp->left_->color_ = node_color::black;
-            tmp->color_ = node_color::red;
-            root = root->rotate_right(tmp);
+            recolor<Stats>(tmp->left_, node_color::black);
+            recolor<Stats>(tmp, node_color::red);
+            root = root->rotate_right<Stats>(tmp);
             tmp = child_parent->right_;
           }
 
-          tmp->color_ = child_parent->color_;
-          child_parent->color_ = node_color::black;
+          recolor<Stats>(tmp, child_parent->color_);
+          recolor<Stats>(child_parent, node_color::black);
 
           if (tmp->right_) {
-            tmp->right_->color_ = node_color::black;
+            recolor<Stats>(tmp->right_, node_color::black);
           }
 
-          root = root->rotate_left(child_parent);
+          root = root->rotate_left<Stats>(child_parent);
           break;
         }
       } else {
         this_type* tmp = child_parent->left_;
 
         if (tmp->color_ == node_color::red) {
-          tmp->color_ = node_color::black;
-          child_parent->color_ = node_color::red;
+          recolor<Stats>(tmp, node_color::black);
+          recolor<Stats>(child_parent, node_color::red);
 
-          root = root->rotate_right(child_parent);
+          root = root->rotate_right<Stats>(child_parent);
           tmp = child_parent->left_;
         }
 
         if (((!tmp->right_) || (tmp->right_->color_ == node_color::black)) &&
             ((!tmp->left_) || (tmp->left_->color_ == node_color::black))) {
-          tmp->color_ = node_color::red;
+          recolor<Stats>(tmp, node_color::red);
           child = child_parent;
           child_parent = child_parent->parent_;
         } else {
           if ((!tmp->left_) || (tmp->left_->color_ == node_color::black)) {
-            tmp->right_->color_ = node_color::black;
-            tmp->color_ = node_color::red;
+            recolor<Stats>(tmp->right_, node_color::black);
+            recolor<Stats>(tmp, node_color::red);
 
-            root = root->rotate_left(tmp);
+            root = root->rotate_left<Stats>(tmp);
             tmp = child_parent->left_;
           }
 
-          tmp->color_ = child_parent->color_;
-          child_parent->color_ = node_color::black;
+          recolor<Stats>(tmp, child_parent->color_);
+          recolor<Stats>(child_parent, node_color::black);
 
           if (tmp->left_) {
-            tmp->left_->color_ = node_color::black;
+            recolor<Stats>(tmp->left_, node_color::black);
           }
 
-          root = root->rotate_right(child_parent);
+          root = root->rotate_right<Stats>(child_parent);
           break;
         }
       }
     }
 
     if (child) {
-      child->color_ = node_color::black;
+      recolor<Stats>(child, node_color::black);
     }
   }
 
@@ -401,8 +482,11 @@ rb_tree_node_base::size_type rb_tree_node_base::black_amount(
   return n;
 }
 
+template <typename Stats>
 rb_tree_node_base::this_type* rb_tree_node_base::rotate_left(
     this_type* const node) const noexcept {
+  Stats::count(stats::event::rotations);
+
   const this_type* root = this;
   this_type* tmp = node->right_;
 
@@ -427,8 +511,11 @@ rb_tree_node_base::this_type* rb_tree_node_base::rotate_left(
   return const_cast<this_type*>(root);
 }
 
+template <typename Stats>
 rb_tree_node_base::this_type* rb_tree_node_base::rotate_right(
     this_type* const node) const noexcept {
+  Stats::count(stats::event::rotations);
+
   const this_type* root = this;
   this_type* const tmp = node->left_;
 
@@ -453,6 +540,150 @@ rb_tree_node_base::this_type* rb_tree_node_base::rotate_right(
   return const_cast<this_type*>(root);
 }
 
+template <typename Stats>
+void rb_tree_node_base::recolor(this_type* const node,
+                                const node_color color) noexcept {
+  if constexpr (Stats::counted_) {
+    if (node->color_ != color) {
+      Stats::count(stats::event::recolorings);
+    }
+  }
+  node->color_ = color;
+}
+
+// With samples 0 measures the path to every node, each node counted once.
+// Otherwise measures samples walks from the root down to a node without
+// children, turning at random where there are two; every node on a walk is
+// counted. Walks favour short paths, so their averages are a lower bound.
+inline tree_profile profile_tree(const rb_tree_node_base& header,
+                                 std::size_t size, std::size_t samples,
+                                 std::uint64_t seed) noexcept {
+  using node_base = rb_tree_node_base;
+
+  // A red-black tree of 2^64 nodes is at most 128 deep.
+  constexpr std::size_t max_depth = 128;
+
+  tree_profile res{};
+  const node_base* root = header.parent_;
+
+  res.size_ = size;
+  if (!root) {
+    return res;
+  }
+  res.black_height_ = node_base::black_amount(root, header.left_);
+
+  // pages[d] is the page of the node at depth d + 1 on the current path and
+  // distinct[d] the pages of the path down to it.
+  std::uintptr_t pages[max_depth];
+  std::size_t distinct[max_depth];
+
+  auto step = [&](const node_base* node, std::size_t depth) {
+    const std::uintptr_t page =
+        reinterpret_cast<std::uintptr_t>(node) / tree_profile::page_size_;
+
+    pages[depth - 1] = page;
+    distinct[depth - 1] =
+        (depth > 1 ? distinct[depth - 2] : 0) +
+        (std::find(pages, pages + depth - 1, page) == pages + depth - 1);
+    ++(node->color_ == node_base::node_color::red ? res.red_ : res.black_);
+  };
+  auto finish = [&](std::size_t depth) {
+    ++res.paths_;
+    res.depth_sum_ += depth;
+    res.height_ = std::max(res.height_, depth);
+    res.pages_sum_ += distinct[depth - 1];
+    res.max_pages_ = std::max(res.max_pages_, distinct[depth - 1]);
+  };
+
+  if (samples == 0) {
+    // Walks the tree in preorder through the parent links, no stack needed.
+    const node_base* prev = &header;
+    const node_base* cur = root;
+    std::size_t depth = 1;
+
+    while (cur != &header) {
+      const node_base* next = cur->parent_;
+
+      if (prev == cur->parent_) {
+        step(cur, depth), finish(depth);
+        next = cur->left_ ? cur->left_ : cur->right_ ? cur->right_ : next;
+      } else if (prev == cur->left_ && cur->right_) {
+        next = cur->right_;
+      }
+      depth = next == cur->parent_ ? depth - 1 : depth + 1;
+      prev = cur;
+      cur = next;
+    }
+  } else {
+    std::uint64_t state = seed;
+
+    for (std::size_t i = 0; i < samples; ++i) {
+      const node_base* cur = root;
+      std::size_t depth = 1;
+
+      for (;; ++depth) {
+        step(cur, depth);
+        if (cur->left_ && cur->right_) {
+          state = state * 6364136223846793005u + 1442695040888963407u;
+          cur = state >> 63 ? cur->right_ : cur->left_;
+        } else if (cur->left_ || cur->right_) {
+          cur = cur->left_ ? cur->left_ : cur->right_;
+        } else {
+          break;
+        }
+      }
+      finish(depth);
+    }
+  }
+
+  return res;
+}
+
+inline std::size_t subtree_height(const rb_tree_node_base* node) noexcept {
+  return node ? 1 + std::max(subtree_height(node->left_),
+                             subtree_height(node->right_))
+              : 0;
+}
+
+inline void veb_subtrees(rb_tree_node_base* node, std::size_t depth,
+                         std::size_t levels,
+                         s21::vector<rb_tree_node_base*>& out);
+
+// Appends the nodes of the first levels levels from node in van Emde Boas
+// order: the top half of the levels, then each subtree below them, left to
+// right, laid out the same way.
+inline void veb_order(rb_tree_node_base* node, std::size_t levels,
+                      s21::vector<rb_tree_node_base*>& out) {
+  if (!node || levels == 0) {
+    return;
+  }
+  if (levels == 1) {
+    out.push_back(node);
+    return;
+  }
+
+  const std::size_t top = levels / 2;
+
+  veb_order(node, top, out);
+  veb_subtrees(node, top, levels - top, out);
+}
+
+// Lays out, left to right, the subtrees whose roots are depth levels below
+// node.
+inline void veb_subtrees(rb_tree_node_base* node, std::size_t depth,
+                         std::size_t levels,
+                         s21::vector<rb_tree_node_base*>& out) {
+  if (!node) {
+    return;
+  }
+  if (depth == 0) {
+    veb_order(node, levels, out);
+    return;
+  }
+  veb_subtrees(node->left_, depth - 1, levels, out);
+  veb_subtrees(node->right_, depth - 1, levels, out);
+}
+
 template <typename T>
 class rb_tree_node : public rb_tree_node_base {
  private:
@@ -557,10 +788,11 @@ inline bool operator!=(
   return lhs.node_base_ != rhs.node_base_;
 }
 
-template <typename T, typename Alloc>
+// Kind is the container the tree implements, for the stats counters.
+template <typename T, typename Alloc, stats::container Kind>
 class rb_tree_base {
  private:
-  using this_type = rb_tree_base<T, Alloc>;
+  using this_type = rb_tree_base<T, Alloc, Kind>;
 
   using t_allocator_type = Alloc;
   using t_allocator_traits = std::allocator_traits<t_allocator_type>;
@@ -587,9 +819,12 @@ class rb_tree_base {
   ~rb_tree_base() { clear(); }
 
   base_node_type* allocate() {
+    stats::count(Kind, stats::event::allocations);
+    stats::count(Kind, stats::event::allocated_bytes, sizeof(node_type));
     return node_allocator_traits::allocate(node_alloc_, 1);
   }
   void deallocate(base_node_type* p) {
+    stats::count(Kind, stats::event::deallocations);
     node_allocator_traits::deallocate(node_alloc_, static_cast<node_type*>(p),
                                       1);
   }
@@ -603,6 +838,20 @@ class rb_tree_base {
     node_allocator_traits::destroy(node_alloc_, static_cast<node_type*>(p));
   }
 
+  // compact() builds nodes in blocks of one allocation. The first slot of a
+  // block holds its compact_block and the node in slot i has block_index_ i,
+  // so drop() finds the block and frees it with its last node.
+  struct compact_block {
+    size_type slots_;
+    size_type live_;
+  };
+
+  // A block for nodes nodes, all of them counted as live.
+  node_type* allocate_block(size_type nodes);
+  void deallocate_block(node_type* block) noexcept;
+  // Destroys and frees a node made by construct(), alone or in a block.
+  void drop(base_node_type* p) noexcept;
+
   void clear();
 
  private:
@@ -619,8 +868,8 @@ class rb_tree_base {
   size_type size_;
 };
 
-template <typename T, typename Alloc>
-rb_tree_base<T, Alloc>::rb_tree_base(const this_type& o)
+template <typename T, typename Alloc, stats::container Kind>
+rb_tree_base<T, Alloc, Kind>::rb_tree_base(const this_type& o)
     : node_alloc_(o.node_alloc_), node_base_(), size_(o.size_) {
   if (size_ > 0) {
     copy(&node_base_, o.node_base_.parent_, insertion_side::left);
@@ -629,8 +878,8 @@ rb_tree_base<T, Alloc>::rb_tree_base(const this_type& o)
   }
 }
 
-template <typename T, typename Alloc>
-rb_tree_base<T, Alloc>::rb_tree_base(this_type&& o) noexcept
+template <typename T, typename Alloc, stats::container Kind>
+rb_tree_base<T, Alloc, Kind>::rb_tree_base(this_type&& o) noexcept
     : node_alloc_(std::move(o.node_alloc_)),
       node_base_(),
       size_(std::move(o.size_)) {
@@ -638,9 +887,9 @@ rb_tree_base<T, Alloc>::rb_tree_base(this_type&& o) noexcept
   o.size_ = 0;
 }
 
-template <typename T, typename Alloc>
-typename rb_tree_base<T, Alloc>::this_type& rb_tree_base<T, Alloc>::operator=(
-    const this_type& o) {
+template <typename T, typename Alloc, stats::container Kind>
+typename rb_tree_base<T, Alloc, Kind>::this_type&
+rb_tree_base<T, Alloc, Kind>::operator=(const this_type& o) {
   if (&o != this) {
     this_type res(o);
     *this = std::move(res);
@@ -649,9 +898,9 @@ typename rb_tree_base<T, Alloc>::this_type& rb_tree_base<T, Alloc>::operator=(
   return *this;
 }
 
-template <typename T, typename Alloc>
-typename rb_tree_base<T, Alloc>::this_type& rb_tree_base<T, Alloc>::operator=(
-    this_type&& o) noexcept {
+template <typename T, typename Alloc, stats::container Kind>
+typename rb_tree_base<T, Alloc, Kind>::this_type&
+rb_tree_base<T, Alloc, Kind>::operator=(this_type&& o) noexcept {
   if (&o != this) {
     clear();
 
@@ -667,8 +916,8 @@ typename rb_tree_base<T, Alloc>::this_type& rb_tree_base<T, Alloc>::operator=(
   return *this;
 }
 
-template <typename T, typename Alloc>
-void rb_tree_base<T, Alloc>::clear() {
+template <typename T, typename Alloc, stats::container Kind>
+void rb_tree_base<T, Alloc, Kind>::clear() {
   remove(node_base_.parent_);
 
   node_base_.left_ = node_base_.right_ = &node_base_;
@@ -677,8 +926,50 @@ void rb_tree_base<T, Alloc>::clear() {
   size_ = 0;
 }
 
-template <typename T, typename Alloc>
-void rb_tree_base<T, Alloc>::copy(base_node_type* parent,
+template <typename T, typename Alloc, stats::container Kind>
+typename rb_tree_base<T, Alloc, Kind>::node_type*
+rb_tree_base<T, Alloc, Kind>::allocate_block(size_type nodes) {
+  static_assert(sizeof(compact_block) <= sizeof(node_type) &&
+                alignof(compact_block) <= alignof(node_type));
+
+  stats::count(Kind, stats::event::allocations);
+  stats::count(Kind, stats::event::allocated_bytes,
+               (nodes + 1) * sizeof(node_type));
+
+  node_type* block = node_allocator_traits::allocate(node_alloc_, nodes + 1);
+  ::new (static_cast<void*>(block)) compact_block{nodes + 1, nodes};
+
+  return block;
+}
+
+template <typename T, typename Alloc, stats::container Kind>
+void rb_tree_base<T, Alloc, Kind>::deallocate_block(node_type* block) noexcept {
+  const size_type slots =
+      std::launder(reinterpret_cast<compact_block*>(block))->slots_;
+
+  stats::count(Kind, stats::event::deallocations);
+  node_allocator_traits::deallocate(node_alloc_, block, slots);
+}
+
+template <typename T, typename Alloc, stats::container Kind>
+void rb_tree_base<T, Alloc, Kind>::drop(base_node_type* p) noexcept {
+  const std::uint32_t index = p->block_index_;
+
+  destroy(p);
+  if (index == 0) {
+    deallocate(p);
+    return;
+  }
+
+  node_type* block = static_cast<node_type*>(p) - index;
+
+  if (--std::launder(reinterpret_cast<compact_block*>(block))->live_ == 0) {
+    deallocate_block(block);
+  }
+}
+
+template <typename T, typename Alloc, stats::container Kind>
+void rb_tree_base<T, Alloc, Kind>::copy(base_node_type* parent,
                                   const base_node_type* cp,
                                   const insertion_side side) {
   if (cp) {
@@ -710,19 +1001,19 @@ void rb_tree_base<T, Alloc>::copy(base_node_type* parent,
   }
 }
 
-template <typename T, typename Alloc>
-void rb_tree_base<T, Alloc>::remove(base_node_type* del) {
+template <typename T, typename Alloc, stats::container Kind>
+void rb_tree_base<T, Alloc, Kind>::remove(base_node_type* del) {
   if (del) {
     remove(del->left_);
     remove(del->right_);
 
-    destroy(del);
-    deallocate(del);
+    drop(del);
   }
 }
 
-template <typename T, typename Alloc>
-void rb_tree_base<T, Alloc>::swap(base_node_type& node_base_other) noexcept {
+template <typename T, typename Alloc, stats::container Kind>
+void rb_tree_base<T, Alloc, Kind>::swap(
+    base_node_type& node_base_other) noexcept {
   if (node_base_.parent_ && node_base_other.parent_) {
     std::swap(node_base_.right_, node_base_other.right_);
     std::swap(node_base_.left_, node_base_other.left_);
@@ -751,21 +1042,35 @@ void rb_tree_base<T, Alloc>::swap(base_node_type& node_base_other) noexcept {
   }
 }
 
+// set and multiset store their keys, map stores pairs.
+template <typename Key, typename T, bool UniqueKey>
+inline constexpr stats::container rb_tree_kind_ =
+    !std::is_same_v<Key, T> ? stats::container::map
+    : UniqueKey             ? stats::container::set
+                            : stats::container::multiset;
+
 template <typename Key, typename T, typename ExtractKey, typename CompareKey,
           typename Alloc, bool UniqueKey>
-class rb_tree : public details::rb_tree_base<T, Alloc> {
+class rb_tree : public details::rb_tree_base<T, Alloc,
+                                             rb_tree_kind_<Key, T, UniqueKey>> {
  private:
-  using base_type = details::rb_tree_base<T, Alloc>;
+  static constexpr stats::container kind_ = rb_tree_kind_<Key, T, UniqueKey>;
+  using stats_type = details::rb_tree_stats_t<kind_>;
+
+  using base_type = details::rb_tree_base<T, Alloc, kind_>;
   using this_type = rb_tree<Key, T, ExtractKey, CompareKey, Alloc, UniqueKey>;
 
   using typename base_type::base_node_type;
   using typename base_type::node_type;
 
   using base_type::allocate;
+  using base_type::allocate_block;
   using base_type::clear;
   using base_type::construct;
   using base_type::deallocate;
+  using base_type::deallocate_block;
   using base_type::destroy;
+  using base_type::drop;
   using base_type::max_size_;
   using base_type::node_alloc_;
   using base_type::node_base_;
@@ -826,6 +1131,10 @@ class rb_tree : public details::rb_tree_base<T, Alloc> {
   void merge(rb_tree<Key, T, ExtractKey, OCompareKey, Alloc, OUniqueKey>& o) {
     merge(std::move(o));
   }
+  // Replaces the contents with [first, last) in linear time after sorting,
+  // or in linear time alone when [first, last) is already sorted.
+  template <typename InputIt>
+  void assign_unsorted(InputIt first, InputIt last);
 
   size_type count(const key_type& val) const noexcept;
   iterator find(const key_type& val) noexcept;
@@ -849,6 +1158,25 @@ class rb_tree : public details::rb_tree_base<T, Alloc> {
     return const_cast<rb_tree*>(this)->upper_bound(val);
   }
 
+  // Shape of the tree from the path to every node in O(size * height), or,
+  // with samples, estimated from that many random walks in
+  // O(samples * height), cheap enough for a tree in service. seed picks the
+  // walks.
+  tree_profile profile(size_type samples = 0,
+                       std::uint64_t seed = 1) const noexcept {
+    return details::profile_tree(node_base_, size_, samples, seed);
+  }
+  // Moves every node into one new allocation laid out in order and relinks
+  // them in the same shape, without comparing keys. Values are moved when
+  // that cannot throw and copied otherwise; if a copy throws, the tree is
+  // left as it was. Invalidates all iterators, pointers and references.
+  void compact(compact_order order = compact_order::van_emde_boas);
+  // Bounded step of an in-order compact(): moves up to n nodes from pos on
+  // into one new allocation and returns the node after them. Feeding the
+  // result back in until end() compacts the tree piece by piece with other
+  // work in between. Invalidates iterators to the moved nodes only.
+  iterator compact(const_iterator pos, size_type n);
+
  private:
   auto extract_key(const_reference val) const noexcept {
     return ExtractKey()(val);
@@ -862,6 +1190,22 @@ class rb_tree : public details::rb_tree_base<T, Alloc> {
 
   std::tuple<base_node_type*, base_node_type*, bool, bool> insert_pos(
       const key_type& val) noexcept;
+  // depth is the number of nodes the search compared with.
+  static void count_insert_search(size_type depth) noexcept {
+    stats::count(kind_, stats::event::insert_searches);
+    stats::count(kind_, stats::event::insert_depth, depth);
+    stats::count_max(kind_, stats::event::max_insert_depth, depth);
+  }
+
+  const key_type& node_key(const base_node_type* node) const noexcept {
+    return ExtractKey()(static_cast<const node_type*>(node)->val_);
+  }
+  void sort_nodes(s21::vector<base_node_type*>& nodes) const;
+  void relocate(base_node_type* const* nodes, size_type n);
+  static base_node_type* link_sorted(base_node_type* const* nodes,
+                                     size_type first, size_type last,
+                                     base_node_type* parent, size_type depth,
+                                     size_type red_depth) noexcept;
 };
 
 template <typename Key, typename T, typename ExtractKey, typename CompareKey,
@@ -887,8 +1231,8 @@ rb_tree<Key, T, ExtractKey, CompareKey, Alloc, UniqueKey>::insert(
   std::unique_ptr<base_node_type, decltype(deleter)> tmp(allocate(), deleter);
   construct(tmp.get(), std::move(val));
 
-  node_base_ = *tmp->insert(&node_base_, prev,
-                            dir ? insertion_side::left : insertion_side::right);
+  node_base_ = *tmp->template insert<stats_type>(
+      &node_base_, prev, dir ? insertion_side::left : insertion_side::right);
   ++size_;
 
   return std::make_pair(tmp.release(), can_insert);
@@ -952,9 +1296,8 @@ rb_tree<Key, T, ExtractKey, CompareKey, Alloc, UniqueKey>::erase(
 
   const iterator tmp = pos++;
 
-  node_base_ = *tmp.node_base_->erase(&node_base_);
-  destroy(tmp.node_base_);
-  deallocate(tmp.node_base_);
+  node_base_ = *tmp.node_base_->template erase<stats_type>(&node_base_);
+  drop(tmp.node_base_);
   --size_;
 
   return pos;
@@ -1082,18 +1425,278 @@ void rb_tree<Key, T, ExtractKey, CompareKey, Alloc, UniqueKey>::merge(
       base_node_type* node = (it++).node_base_;
 
       if (can_insert) {
-        o.node_base_ = *node->erase(&o.node_base_);
+        o.node_base_ = *node->template erase<
+            details::rb_tree_stats_t<rb_tree_kind_<Key, T, OUniqueKey>>>(
+            &o.node_base_);
         --o.size_;
 
-        node_base_ =
-            *node->insert(&node_base_, prev,
-                          dir ? insertion_side::left : insertion_side::right);
+        node_base_ = *node->template insert<stats_type>(
+            &node_base_, prev,
+            dir ? insertion_side::left : insertion_side::right);
         ++size_;
       }
     }
   }
 }
 
+// The values go into fresh nodes, the nodes are sorted by key and, for
+// unique keys, only the first of equal ones is kept, as repeated insert()
+// would. Equal keys of a multiset keep their input order. Input that is
+// already sorted, such as a tree read back by s21::deserialize(), skips the
+// sort. The sorted nodes are then linked into a balanced tree in one pass
+// with no rebalancing. The old contents are released only once the new tree
+// is built.
+template <typename Key, typename T, typename ExtractKey, typename CompareKey,
+          typename Alloc, bool UniqueKey>
+template <typename InputIt>
+void rb_tree<Key, T, ExtractKey, CompareKey, Alloc, UniqueKey>::assign_unsorted(
+    InputIt first, InputIt last) {
+  auto release = [this](base_node_type* node) -> void { drop(node); };
+  s21::vector<base_node_type*> nodes;
+
+  try {
+    for (; first != last; ++first) {
+      auto deleter = [this](base_node_type* ptr) -> void { deallocate(ptr); };
+
+      nodes.push_back(nullptr);
+      std::unique_ptr<base_node_type, decltype(deleter)> tmp(allocate(),
+                                                             deleter);
+      construct(tmp.get(), *first);
+      nodes.back() = tmp.release();
+    }
+    if (!std::is_sorted(nodes.begin(), nodes.end(),
+                        [this](base_node_type* lhs, base_node_type* rhs) {
+                          return compare_key(node_key(lhs), node_key(rhs));
+                        })) {
+      sort_nodes(nodes);
+    }
+  } catch (...) {
+    for (base_node_type* node : nodes) {
+      if (node) {
+        release(node);
+      }
+    }
+    throw;
+  }
+
+  size_type n = nodes.size();
+
+  if constexpr (UniqueKey) {
+    n = 0;
+    for (base_node_type* node : nodes) {
+      if (n > 0 && !compare_key(node_key(nodes[n - 1]), node_key(node))) {
+        release(node);
+      } else {
+        nodes[n++] = node;
+      }
+    }
+  }
+
+  clear();
+  if (n == 0) {
+    return;
+  }
+
+  // A perfect tree is all black. Otherwise only the deepest level is
+  // partly filled, and making it red keeps every path equally black.
+  size_type red_depth = size_type(0) - 1;
+
+  if ((n & (n + 1)) != 0) {
+    for (red_depth = 0; (n >> (red_depth + 1)) != 0; ++red_depth) {
+    }
+  }
+
+  node_base_.parent_ =
+      link_sorted(nodes.data(), 0, n, &node_base_, 0, red_depth);
+  node_base_.left_ = nodes[0];
+  node_base_.right_ = nodes[n - 1];
+  size_ = n;
+}
+
+template <typename Key, typename T, typename ExtractKey, typename CompareKey,
+          typename Alloc, bool UniqueKey>
+void rb_tree<Key, T, ExtractKey, CompareKey, Alloc, UniqueKey>::compact(
+    compact_order order) {
+  // block_index_ holds the place of a node in its block.
+  constexpr size_type max_block = std::numeric_limits<std::uint32_t>::max() - 1;
+
+  s21::vector<base_node_type*> nodes;
+
+  nodes.reserve(size_);
+  if (order == compact_order::in_order) {
+    for (auto it = begin(); it != end(); ++it) {
+      nodes.push_back(it.node_base_);
+    }
+  } else {
+    details::veb_order(node_base_.parent_,
+                       details::subtree_height(node_base_.parent_), nodes);
+  }
+
+  for (size_type first = 0; first < nodes.size(); first += max_block) {
+    relocate(nodes.data() + first, std::min(max_block, nodes.size() - first));
+  }
+}
+
+template <typename Key, typename T, typename ExtractKey, typename CompareKey,
+          typename Alloc, bool UniqueKey>
+typename rb_tree<Key, T, ExtractKey, CompareKey, Alloc, UniqueKey>::iterator
+rb_tree<Key, T, ExtractKey, CompareKey, Alloc, UniqueKey>::compact(
+    const_iterator pos, size_type n) {
+  constexpr size_type max_block = std::numeric_limits<std::uint32_t>::max() - 1;
+
+  s21::vector<base_node_type*> nodes;
+
+  n = std::min({n, size_, max_block});
+  nodes.reserve(n);
+  for (; pos != end() && nodes.size() < n; ++pos) {
+    nodes.push_back(pos.node_base_);
+  }
+  relocate(nodes.data(), nodes.size());
+
+  return iterator(pos.node_base_);
+}
+
+// The new nodes take the links of the old ones, translated through a table
+// of moved nodes sorted by address, and the nodes around them that stay are
+// pointed at the new ones. Nothing is changed before every value is in its
+// new node, so a throwing copy leaves the tree intact.
+template <typename Key, typename T, typename ExtractKey, typename CompareKey,
+          typename Alloc, bool UniqueKey>
+void rb_tree<Key, T, ExtractKey, CompareKey, Alloc, UniqueKey>::relocate(
+    base_node_type* const* nodes, size_type n) {
+  using moved_type = std::pair<base_node_type*, base_node_type*>;
+
+  if (n == 0) {
+    return;
+  }
+
+  s21::vector<moved_type> moved(n);
+  node_type* block = allocate_block(n);
+  size_type built = 0;
+
+  try {
+    for (; built < n; ++built) {
+      construct(block + 1 + built,
+                std::move_if_noexcept(
+                    static_cast<node_type*>(nodes[built])->val_));
+    }
+  } catch (...) {
+    for (; built != 0; --built) {
+      destroy(block + built);
+    }
+    deallocate_block(block);
+    throw;
+  }
+
+  const auto by_address = [](const moved_type& lhs, base_node_type* rhs) {
+    return std::less<base_node_type*>()(lhs.first, rhs);
+  };
+
+  for (size_type i = 0; i < n; ++i) {
+    moved[i] = moved_type(nodes[i], block + 1 + i);
+  }
+  std::sort(moved.begin(), moved.end(),
+            [&](const moved_type& lhs, const moved_type& rhs) {
+              return by_address(lhs, rhs.first);
+            });
+
+  const auto relocated = [&](base_node_type* node) {
+    auto it = std::lower_bound(moved.begin(), moved.end(), node, by_address);
+
+    return it != moved.end() && it->first == node ? it->second : node;
+  };
+
+  for (size_type i = 0; i < n; ++i) {
+    const base_node_type* old = nodes[i];
+    base_node_type* node = block + 1 + i;
+
+    node->left_ = old->left_ ? relocated(old->left_) : nullptr;
+    node->right_ = old->right_ ? relocated(old->right_) : nullptr;
+    node->parent_ = relocated(old->parent_);
+    node->color_ = old->color_;
+    node->block_index_ = std::uint32_t(i + 1);
+  }
+
+  for (size_type i = 0; i < n; ++i) {
+    base_node_type* old = nodes[i];
+    base_node_type* node = block + 1 + i;
+    base_node_type* parent = old->parent_;
+
+    if (parent == &node_base_) {
+      node_base_.parent_ = node;
+    } else if (relocated(parent) == parent) {
+      (parent->left_ == old ? parent->left_ : parent->right_) = node;
+    }
+    for (base_node_type* child : {old->left_, old->right_}) {
+      if (child && relocated(child) == child) {
+        child->parent_ = node;
+      }
+    }
+  }
+  node_base_.left_ = relocated(node_base_.left_);
+  node_base_.right_ = relocated(node_base_.right_);
+
+  for (size_type i = 0; i < n; ++i) {
+    drop(nodes[i]);
+  }
+}
+
+// Integer keys under std::less are radix sorted together with their nodes,
+// which reads each key once; other keys take a stable comparison sort.
+template <typename Key, typename T, typename ExtractKey, typename CompareKey,
+          typename Alloc, bool UniqueKey>
+void rb_tree<Key, T, ExtractKey, CompareKey, Alloc, UniqueKey>::sort_nodes(
+    s21::vector<base_node_type*>& nodes) const {
+  if constexpr (std::is_integral_v<key_type> &&
+                is_radix_order_v<key_type, CompareKey>) {
+    using keyed_node = std::pair<key_type, base_node_type*>;
+
+    s21::vector<keyed_node> keyed;
+    s21::vector<keyed_node> scratch(nodes.size());
+
+    keyed.reserve(nodes.size());
+    for (base_node_type* node : nodes) {
+      keyed.push_back({node_key(node), node});
+    }
+    radix_sort(keyed.data(), scratch.data(), keyed.size(),
+               [](const keyed_node& item) { return item.first; });
+    for (size_type i = 0; i < keyed.size(); ++i) {
+      nodes[i] = keyed[i].second;
+    }
+  } else {
+    std::stable_sort(nodes.begin(), nodes.end(),
+                     [this](base_node_type* lhs, base_node_type* rhs) {
+                       return compare_key(node_key(lhs), node_key(rhs));
+                     });
+  }
+}
+
+// Links nodes[first, last) into a balanced subtree below parent and returns
+// its root. Nodes depth red_depth levels below the root of the whole tree
+// are red, the rest black.
+template <typename Key, typename T, typename ExtractKey, typename CompareKey,
+          typename Alloc, bool UniqueKey>
+typename rb_tree<Key, T, ExtractKey, CompareKey, Alloc,
+                 UniqueKey>::base_node_type*
+rb_tree<Key, T, ExtractKey, CompareKey, Alloc, UniqueKey>::link_sorted(
+    base_node_type* const* nodes, size_type first, size_type last,
+    base_node_type* parent, size_type depth, size_type red_depth) noexcept {
+  if (first == last) {
+    return nullptr;
+  }
+
+  const size_type mid = first + (last - first) / 2;
+  base_node_type* node = nodes[mid];
+
+  node->parent_ = parent;
+  node->color_ = depth == red_depth ? base_node_type::node_color::red
+                                    : base_node_type::node_color::black;
+  node->left_ = link_sorted(nodes, first, mid, node, depth + 1, red_depth);
+  node->right_ = link_sorted(nodes, mid + 1, last, node, depth + 1, red_depth);
+
+  return node;
+}
+
 template <typename Key, typename T, typename ExtractKey, typename CompareKey,
           typename Alloc, bool UniqueKey>
 std::tuple<typename rb_tree<Key, T, ExtractKey, CompareKey, Alloc,
@@ -1105,15 +1708,18 @@ rb_tree<Key, T, ExtractKey, CompareKey, Alloc, UniqueKey>::insert_pos(
     const key_type& val) noexcept {
   const base_node_type* cur = node_base_.parent_;
   const base_node_type* prev = &node_base_;
+  size_type depth = 0;
 
   bool comp = true;
 
   while (cur) {
     prev = cur;
+    ++depth;
 
     if constexpr (UniqueKey) {
       if (equal_key(val,
                     extract_key(static_cast<const node_type*>(cur)->val_))) {
+        count_insert_search(depth);
         return std::make_tuple(const_cast<base_node_type*>(cur),
                                const_cast<base_node_type*>(cur->parent_), false,
                                false);
@@ -1124,6 +1730,7 @@ rb_tree<Key, T, ExtractKey, CompareKey, Alloc, UniqueKey>::insert_pos(
         compare_key(val, extract_key(static_cast<const node_type*>(cur)->val_));
     cur = comp ? cur->left_ : cur->right_;
   }
+  count_insert_search(depth);
 
   return std::make_tuple(const_cast<base_node_type*>(cur),
                          const_cast<base_node_type*>(prev), true, comp);
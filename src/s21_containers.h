@@ -4,6 +4,7 @@
 #include <iostream>
 
 #include "./source/s21_array.h"
+#include "./source/s21_list.h"
 #include "./source/s21_map.h"
 #include "./source/s21_queue.h"
 #include "./source/s21_set.h"
@@ -4,6 +4,24 @@
 #include <iostream>
 
 #include "./source/s21_array.h"
+#include "./source/s21_compact_list.h"
+#include "./source/s21_concurrent_map.h"
+#include "./source/s21_concurrent_stack.h"
+#include "./source/s21_deque.h"
+#include "./source/s21_execution.h"
+#include "./source/s21_frozen_map.h"
+#include "./source/s21_intrusive_list.h"
+#include "./source/s21_mdspan.h"
+#include "./source/s21_mpmc_queue.h"
 #include "./source/s21_multiset.h"
+#include "./source/s21_ring_buffer.h"
+#include "./source/s21_serialize.h"
+#include "./source/s21_soa_vector.h"
+#include "./source/s21_span.h"
+#include "./source/s21_spsc_queue.h"
+#include "./source/s21_static_map.h"
+#include "./source/s21_stats.h"
+#include "./source/s21_thread_pool.h"
+#include "./source/s21_unrolled_list.h"
 
 #endif  // S21_CONTAINERSPLUS_H
\ No newline at end of file
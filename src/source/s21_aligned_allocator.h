@@ -0,0 +1,109 @@
+#ifndef S21_ALIGNED_ALLOCATOR_H_
+#define S21_ALIGNED_ALLOCATOR_H_
+
+#pragma once
+
+#include <cstddef>
+#include <limits>
+#include <new>
+#include <type_traits>
+
+namespace s21 {
+
+// Tells the compiler that p is a multiple of Align, like C++20
+// std::assume_aligned, so that loops over it can use aligned vector loads.
+// The caller guarantees it.
+template <std::size_t Align, typename T>
+inline T* assume_aligned(T* p) noexcept {
+  static_assert(Align > 0 && (Align & (Align - 1)) == 0,
+                "s21::assume_aligned(). Align must be a power of two");
+#if defined(__GNUC__) || defined(__clang__)
+  return static_cast<T*>(__builtin_assume_aligned(p, Align));
+#else
+  return p;
+#endif
+}
+
+// Allocator whose blocks start on an Align-byte boundary, 64 by default: a
+// cache line and an AVX-512 register, or on alignof(T) when that is larger.
+// Blocks are padded to a multiple of the alignment, so a full-width vector
+// load at the last element stays inside the allocation. Stateless; all
+// instances compare equal.
+template <typename T, std::size_t Align = 64>
+class aligned_allocator {
+  static_assert(Align != 0 && (Align & (Align - 1)) == 0,
+                "s21::aligned_allocator. Align must be a power of two");
+
+ public:
+  using value_type = T;
+  using size_type = std::size_t;
+  using difference_type = std::ptrdiff_t;
+  using propagate_on_container_move_assignment = std::true_type;
+  using is_always_equal = std::true_type;
+
+  // Node types of list or map may be more aligned than Align, so this and
+  // not Align is what allocate() uses. Rebinding keeps Align, which makes
+  // rebinding there and back give the same type.
+  static constexpr size_type alignment =
+      Align > alignof(T) ? Align : alignof(T);
+
+  template <typename U>
+  struct rebind {
+    using other = aligned_allocator<U, Align>;
+  };
+
+ public:
+  aligned_allocator() noexcept = default;
+  template <typename U, std::size_t OAlign>
+  aligned_allocator(const aligned_allocator<U, OAlign>&) noexcept {}
+
+  T* allocate(size_type n) {
+    if (n > (std::numeric_limits<size_type>::max() - alignment) / sizeof(T)) {
+      throw std::bad_array_new_length();
+    }
+
+    const size_type bytes =
+        (n * sizeof(T) + alignment - 1) & ~(alignment - 1);
+
+    return static_cast<T*>(
+        ::operator new(bytes, std::align_val_t(alignment)));
+  }
+  void deallocate(T* p, size_type) noexcept {
+    ::operator delete(p, std::align_val_t(alignment));
+  }
+};
+
+template <typename T, std::size_t TAlign, typename U, std::size_t UAlign>
+inline bool operator==(const aligned_allocator<T, TAlign>&,
+                       const aligned_allocator<U, UAlign>&) noexcept {
+  return true;
+}
+
+template <typename T, std::size_t TAlign, typename U, std::size_t UAlign>
+inline bool operator!=(const aligned_allocator<T, TAlign>&,
+                       const aligned_allocator<U, UAlign>&) noexcept {
+  return false;
+}
+
+namespace details {
+
+// Alignment every block from Alloc is known to have: Alloc::alignment when
+// it declares one, alignof(value_type) otherwise.
+template <typename Alloc, typename = void>
+struct allocator_alignment
+    : std::integral_constant<std::size_t,
+                             alignof(typename Alloc::value_type)> {};
+
+template <typename Alloc>
+struct allocator_alignment<Alloc, std::void_t<decltype(Alloc::alignment)>>
+    : std::integral_constant<std::size_t, Alloc::alignment> {};
+
+template <typename Alloc>
+inline constexpr std::size_t allocator_alignment_v =
+    allocator_alignment<Alloc>::value;
+
+}  // namespace details
+
+}  // namespace s21
+
+#endif  // S21_ALIGNED_ALLOCATOR_H_
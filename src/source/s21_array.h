@@ -3,12 +3,59 @@
 
 #pragma once
 
+#include <cstddef>
+#include <functional>
 #include <initializer_list>
 #include <memory>
 #include <stdexcept>
+#include <tuple>
+#include <type_traits>
+#include <utility>
 
 namespace s21 {
 
+namespace details {
+
+// std::swap is not constexpr before C++20.
+template <typename T>
+constexpr void constexpr_swap(T& lhs, T& rhs) noexcept(
+    std::is_nothrow_move_constructible_v<T>&&
+        std::is_nothrow_move_assignable_v<T>) {
+  T tmp = std::move(lhs);
+  lhs = std::move(rhs);
+  rhs = std::move(tmp);
+}
+
+template <typename T, typename Compare>
+constexpr void sift_down(T* first, std::size_t pos, std::size_t n,
+                         Compare& comp) {
+  for (std::size_t child = 2 * pos + 1; child < n; child = 2 * pos + 1) {
+    if (child + 1 < n && comp(first[child], first[child + 1])) {
+      ++child;
+    }
+    if (!comp(first[pos], first[child])) {
+      return;
+    }
+    constexpr_swap(first[pos], first[child]);
+    pos = child;
+  }
+}
+
+// Heap sort: no recursion and no extra memory, so it runs in constant
+// evaluation with O(n log n) steps. Not stable.
+template <typename T, typename Compare>
+constexpr void constexpr_sort(T* first, std::size_t n, Compare& comp) {
+  for (std::size_t i = n / 2; i-- > 0;) {
+    sift_down(first, i, n, comp);
+  }
+  for (std::size_t i = n; i-- > 1;) {
+    constexpr_swap(first[0], first[i]);
+    sift_down(first, 0, i, comp);
+  }
+}
+
+}  // namespace details
+
 template <typename T, std::size_t N>
 class array {
  private:
@@ -51,9 +98,35 @@ class array {
   constexpr size_type size() const noexcept { return N; }
   constexpr size_type max_size() const noexcept { return N; }
 
-  constexpr void swap(this_type& o) noexcept { std::swap(*this, o); }
-  constexpr void fill(const_reference val) noexcept {
-    std::fill(data_, data_ + N, val);
+  constexpr void swap(this_type& o) noexcept(
+      std::is_nothrow_move_constructible_v<T>&&
+          std::is_nothrow_move_assignable_v<T>) {
+    for (size_type i = 0; i < N && &o != this; ++i) {
+      details::constexpr_swap(data_[i], o.data_[i]);
+    }
+  }
+  constexpr void fill(const_reference val) {
+    for (size_type i = 0; i < N; ++i) {
+      data_[i] = val;
+    }
+  }
+
+  // Algorithms usable in constant expressions, e.g. to build lookup tables.
+  template <typename Compare = std::less<>>
+  constexpr void sort(Compare comp = Compare()) {
+    details::constexpr_sort(data_, N, comp);
+  }
+  constexpr iterator find(const_reference val) noexcept;
+  constexpr const_iterator find(const_reference val) const noexcept {
+    return const_cast<this_type*>(this)->find(val);
+  }
+  // The array must be sorted by comp.
+  template <typename Compare = std::less<>>
+  constexpr iterator lower_bound(const_reference val, Compare comp = Compare());
+  template <typename Compare = std::less<>>
+  constexpr const_iterator lower_bound(const_reference val,
+                                       Compare comp = Compare()) const {
+    return const_cast<this_type*>(this)->lower_bound(val, comp);
   }
 
  public:
@@ -69,6 +142,39 @@ constexpr typename array<T, N>::reference array<T, N>::at(size_type pos) {
   return data_[pos];
 }
 
+template <typename T, std::size_t N>
+constexpr typename array<T, N>::iterator array<T, N>::find(
+    const_reference val) noexcept {
+  iterator it = begin();
+
+  while (it != end() && !(*it == val)) {
+    ++it;
+  }
+
+  return it;
+}
+
+template <typename T, std::size_t N>
+template <typename Compare>
+constexpr typename array<T, N>::iterator array<T, N>::lower_bound(
+    const_reference val, Compare comp) {
+  iterator first = begin();
+  size_type count = N;
+
+  while (count > 0) {
+    const size_type half = count / 2;
+
+    if (comp(first[half], val)) {
+      first += half + 1;
+      count -= half + 1;
+    } else {
+      count = half;
+    }
+  }
+
+  return first;
+}
+
 template <typename T>
 class array<T, 0> {
  private:
@@ -86,9 +192,11 @@ class array<T, 0> {
   using const_iterator = const T*;
 
  public:
-  constexpr reference operator[](size_type) noexcept { return nullptr; };
+  // There is no element to refer to: like front() and back(), never valid to
+  // call, but well-formed so that generic code compiles.
+  constexpr reference operator[](size_type) noexcept { return *data(); }
   constexpr const_reference operator[](size_type) const noexcept {
-    return nullptr;
+    return *data();
   }
   constexpr reference at(size_type) {
     throw std::out_of_range("s21::array::at(). array is empty.");
@@ -113,10 +221,165 @@ class array<T, 0> {
   constexpr size_type size() const noexcept { return 0; }
   constexpr size_type max_size() const noexcept { return 0; }
 
-  void swap(this_type&) noexcept {}
-  void fill(const_reference) noexcept {}
+  constexpr void swap(this_type&) noexcept {}
+  constexpr void fill(const_reference) noexcept {}
+
+  template <typename Compare = std::less<>>
+  constexpr void sort(Compare = Compare()) noexcept {}
+  constexpr iterator find(const_reference) noexcept { return end(); }
+  constexpr const_iterator find(const_reference) const noexcept {
+    return end();
+  }
+  template <typename Compare = std::less<>>
+  constexpr iterator lower_bound(const_reference, Compare = Compare()) {
+    return end();
+  }
+  template <typename Compare = std::less<>>
+  constexpr const_iterator lower_bound(const_reference,
+                                       Compare = Compare()) const {
+    return end();
+  }
 };
 
+// s21::array whose elements start on an Align-byte boundary, e.g. a cache
+// line or a full SIMD register. Everything else, constexpr use included, is
+// inherited from array.
+template <typename T, std::size_t N, std::size_t Align = 64>
+class alignas(Align) aligned_array : public array<T, N> {
+  static_assert((Align & (Align - 1)) == 0 && Align >= alignof(T),
+                "s21::aligned_array. Align must be a power of two and at "
+                "least alignof(T)");
+};
+
+template <typename T, std::size_t N>
+constexpr bool operator==(const array<T, N>& lhs, const array<T, N>& rhs) {
+  for (std::size_t i = 0; i < N; ++i) {
+    if (!(lhs[i] == rhs[i])) {
+      return false;
+    }
+  }
+
+  return true;
+}
+
+template <typename T, std::size_t N>
+constexpr bool operator!=(const array<T, N>& lhs, const array<T, N>& rhs) {
+  return !(lhs == rhs);
+}
+
+// Lexicographical, like std::array.
+template <typename T, std::size_t N>
+constexpr bool operator<(const array<T, N>& lhs, const array<T, N>& rhs) {
+  for (std::size_t i = 0; i < N; ++i) {
+    if (lhs[i] < rhs[i]) {
+      return true;
+    }
+    if (rhs[i] < lhs[i]) {
+      return false;
+    }
+  }
+
+  return false;
+}
+
+template <typename T, std::size_t N>
+constexpr bool operator>(const array<T, N>& lhs, const array<T, N>& rhs) {
+  return rhs < lhs;
+}
+
+template <typename T, std::size_t N>
+constexpr bool operator<=(const array<T, N>& lhs, const array<T, N>& rhs) {
+  return !(rhs < lhs);
+}
+
+template <typename T, std::size_t N>
+constexpr bool operator>=(const array<T, N>& lhs, const array<T, N>& rhs) {
+  return !(lhs < rhs);
+}
+
+template <typename T, std::size_t N>
+constexpr void swap(array<T, N>& lhs,
+                    array<T, N>& rhs) noexcept(noexcept(lhs.swap(rhs))) {
+  lhs.swap(rhs);
+}
+
+// Structured bindings: auto [a, b, c] = arr;
+template <std::size_t I, typename T, std::size_t N>
+constexpr T& get(array<T, N>& arr) noexcept {
+  static_assert(I < N, "s21::get(). index out of range");
+  return arr.data_[I];
+}
+
+template <std::size_t I, typename T, std::size_t N>
+constexpr const T& get(const array<T, N>& arr) noexcept {
+  static_assert(I < N, "s21::get(). index out of range");
+  return arr.data_[I];
+}
+
+template <std::size_t I, typename T, std::size_t N>
+constexpr T&& get(array<T, N>&& arr) noexcept {
+  static_assert(I < N, "s21::get(). index out of range");
+  return std::move(arr.data_[I]);
+}
+
+template <std::size_t I, typename T, std::size_t N>
+constexpr const T&& get(const array<T, N>&& arr) noexcept {
+  static_assert(I < N, "s21::get(). index out of range");
+  return std::move(arr.data_[I]);
+}
+
+namespace details {
+
+template <typename T, std::size_t N, std::size_t... I>
+constexpr array<std::remove_cv_t<T>, N> to_array(T (&arr)[N],
+                                                 std::index_sequence<I...>) {
+  return {{arr[I]...}};
+}
+
+template <typename T, std::size_t N, std::size_t... I>
+constexpr array<std::remove_cv_t<T>, N> to_array(T (&&arr)[N],
+                                                 std::index_sequence<I...>) {
+  return {{std::move(arr[I])...}};
+}
+
+}  // namespace details
+
+// s21::to_array("abc") gives array<char, 4>, s21::to_array({1, 2}) gives
+// array<int, 2>.
+template <typename T, std::size_t N>
+constexpr array<std::remove_cv_t<T>, N> to_array(T (&arr)[N]) {
+  return details::to_array(arr, std::make_index_sequence<N>());
+}
+
+template <typename T, std::size_t N>
+constexpr array<std::remove_cv_t<T>, N> to_array(T (&&arr)[N]) {
+  return details::to_array(std::move(arr), std::make_index_sequence<N>());
+}
+
 }  // namespace s21
 
-#endif  // S21_ARRAY_H
\ No newline at end of file
+namespace std {
+
+template <typename T, std::size_t N>
+struct tuple_size<s21::array<T, N>> : std::integral_constant<std::size_t, N> {
+};
+
+template <std::size_t I, typename T, std::size_t N>
+struct tuple_element<I, s21::array<T, N>> {
+  static_assert(I < N, "s21::array index out of range");
+  using type = T;
+};
+
+template <typename T, std::size_t N, std::size_t Align>
+struct tuple_size<s21::aligned_array<T, N, Align>>
+    : std::integral_constant<std::size_t, N> {};
+
+template <std::size_t I, typename T, std::size_t N, std::size_t Align>
+struct tuple_element<I, s21::aligned_array<T, N, Align>> {
+  static_assert(I < N, "s21::array index out of range");
+  using type = T;
+};
+
+}  // namespace std
+
+#endif  // S21_ARRAY_H
@@ -0,0 +1,744 @@
+#ifndef S21_COMPACT_LIST_H_
+#define S21_COMPACT_LIST_H_
+
+#pragma once
+
+#include <algorithm>
+#include <cstdint>
+#include <functional>
+#include <initializer_list>
+#include <iterator>
+#include <memory>
+#include <new>
+#include <stdexcept>
+#include <utility>
+
+#include "s21_vector.h"
+
+namespace s21 {
+
+template <typename T, typename Alloc>
+class compact_list;
+
+namespace details {
+
+// Two 32-bit links and the value: 12 bytes for an int instead of the 24 of
+// an s21::list node (plus the allocator's own per-block header).
+template <typename T>
+class compact_list_node {
+ public:
+  using index_type = std::uint32_t;
+
+  T* val() noexcept { return std::launder(reinterpret_cast<T*>(storage_)); }
+
+ public:
+  index_type next_;
+  index_type prev_;
+
+ private:
+  alignas(T) unsigned char storage_[sizeof(T)];
+};
+
+template <typename Pool, typename Pointer, typename Reference>
+class compact_list_iterator {
+ private:
+  using this_type = compact_list_iterator<Pool, Pointer, Reference>;
+  using index_type = typename Pool::index_type;
+
+  using iterator =
+      compact_list_iterator<Pool, typename Pool::value_type*,
+                            typename Pool::value_type&>;
+  using const_iterator =
+      compact_list_iterator<Pool, const typename Pool::value_type*,
+                            const typename Pool::value_type&>;
+
+ public:
+  using iterator_category = std::bidirectional_iterator_tag;
+  using size_type = std::size_t;
+  using difference_type = std::ptrdiff_t;
+  using value_type = typename Pool::value_type;
+  using pointer = Pointer;
+  using reference = Reference;
+
+ public:
+  compact_list_iterator(const Pool* pool, index_type index) noexcept
+      : pool_(const_cast<Pool*>(pool)), index_(index) {}
+  compact_list_iterator(const iterator& o) noexcept
+      : pool_(o.pool_), index_(o.index_) {}
+  compact_list_iterator(const const_iterator& o) noexcept
+      : pool_(o.pool_), index_(o.index_) {}
+  this_type& operator=(const iterator& o) noexcept {
+    return pool_ = o.pool_, index_ = o.index_, *this;
+  }
+  this_type& operator=(const const_iterator& o) noexcept {
+    return pool_ = o.pool_, index_ = o.index_, *this;
+  }
+
+  reference operator*() const noexcept { return *pool_->node(index_).val(); }
+  pointer operator->() const noexcept { return pool_->node(index_).val(); }
+
+  this_type& operator++() noexcept {
+    return index_ = pool_->node(index_).next_, *this;
+  }
+  this_type operator++(int) noexcept {
+    this_type tmp(*this);
+    return ++*this, tmp;
+  }
+  this_type& operator--() noexcept {
+    return index_ = pool_->node(index_).prev_, *this;
+  }
+  this_type operator--(int) noexcept {
+    this_type tmp(*this);
+    return --*this, tmp;
+  }
+
+ public:
+  Pool* pool_;
+  index_type index_;
+};
+
+template <typename Pool, typename LPointer, typename LReference,
+          typename RPointer, typename RReference>
+inline bool operator==(
+    const compact_list_iterator<Pool, LPointer, LReference>& lhs,
+    const compact_list_iterator<Pool, RPointer, RReference>& rhs) noexcept {
+  return lhs.index_ == rhs.index_ && lhs.pool_ == rhs.pool_;
+}
+
+template <typename Pool, typename LPointer, typename LReference,
+          typename RPointer, typename RReference>
+inline bool operator!=(
+    const compact_list_iterator<Pool, LPointer, LReference>& lhs,
+    const compact_list_iterator<Pool, RPointer, RReference>& rhs) noexcept {
+  return !(lhs == rhs);
+}
+
+}  // namespace details
+
+// Node arena shared by any number of compact_lists. Nodes are handed out in
+// chunks and addressed by 32-bit index, so links take half the space of
+// pointers, and lists on the same pool can splice in O(1). Chunks are only
+// returned when the pool dies; it must outlive every list that uses it.
+template <typename T, typename Alloc = std::allocator<T>>
+class compact_list_pool {
+ private:
+  using this_type = compact_list_pool<T, Alloc>;
+  using node_type = details::compact_list_node<T>;
+
+  using t_allocator_type = Alloc;
+  using t_allocator_traits = std::allocator_traits<t_allocator_type>;
+  using node_allocator_type =
+      typename t_allocator_traits::template rebind_alloc<node_type>;
+  using node_allocator_traits = std::allocator_traits<node_allocator_type>;
+
+  friend class compact_list<T, Alloc>;
+  template <typename Pool, typename Pointer, typename Reference>
+  friend class details::compact_list_iterator;
+
+ public:
+  using value_type = T;
+  using size_type = std::size_t;
+  using index_type = typename node_type::index_type;
+
+ public:
+  compact_list_pool() noexcept
+      : alloc_(), node_alloc_(), chunks_(), free_(npos_), used_() {}
+  compact_list_pool(const this_type&) = delete;
+  this_type& operator=(const this_type&) = delete;
+  ~compact_list_pool();
+
+  // Nodes in use, including the sentinel of each list that has one.
+  size_type size() const noexcept { return used_; }
+  size_type capacity() const noexcept { return chunks_.size() * chunk_size_; }
+  static constexpr size_type node_size() noexcept { return sizeof(node_type); }
+
+ private:
+  node_type& node(index_type i) const noexcept {
+    return chunks_[i >> chunk_shift_][i & (chunk_size_ - 1)];
+  }
+
+  index_type allocate();
+  void deallocate(index_type i) noexcept;
+
+  template <class... Args>
+  void construct(index_type i, Args&&... args) {
+    t_allocator_traits::construct(alloc_, node(i).val(),
+                                  std::forward<Args>(args)...);
+  }
+  void destroy(index_type i) {
+    t_allocator_traits::destroy(alloc_, node(i).val());
+  }
+
+ private:
+  static constexpr size_type chunk_shift_ = 10;
+  static constexpr size_type chunk_size_ = size_type(1) << chunk_shift_;
+  // Ends the free list; never a valid node.
+  static constexpr index_type npos_ = index_type(-1);
+
+  t_allocator_type alloc_;
+  node_allocator_type node_alloc_;
+  s21::vector<node_type*> chunks_;
+  index_type free_;
+  size_type used_;
+};
+
+template <typename T, typename Alloc>
+compact_list_pool<T, Alloc>::~compact_list_pool() {
+  for (node_type* chunk : chunks_) {
+    node_allocator_traits::deallocate(node_alloc_, chunk, chunk_size_);
+  }
+}
+
+template <typename T, typename Alloc>
+typename compact_list_pool<T, Alloc>::index_type
+compact_list_pool<T, Alloc>::allocate() {
+  if (free_ == npos_) {
+    if (capacity() + chunk_size_ > size_type(npos_)) {
+      throw std::length_error(
+          "s21::compact_list_pool::allocate(). pool is full.");
+    }
+
+    node_type* chunk =
+        node_allocator_traits::allocate(node_alloc_, chunk_size_);
+
+    try {
+      chunks_.push_back(chunk);
+    } catch (...) {
+      node_allocator_traits::deallocate(node_alloc_, chunk, chunk_size_);
+      throw;
+    }
+
+    // Thread the chunk onto the free list so it is handed out in order.
+    const index_type first = index_type(capacity() - chunk_size_);
+
+    for (size_type i = chunk_size_; i-- > 0;) {
+      chunk[i].next_ = free_;
+      free_ = first + index_type(i);
+    }
+  }
+
+  const index_type res = free_;
+
+  free_ = node(res).next_;
+  ++used_;
+
+  return res;
+}
+
+template <typename T, typename Alloc>
+void compact_list_pool<T, Alloc>::deallocate(index_type i) noexcept {
+  node(i).next_ = free_;
+  free_ = i;
+  --used_;
+}
+
+// Doubly linked list whose nodes live in a compact_list_pool and link to
+// each other by 32-bit index. Iteration, insertion, erasure and splicing
+// between lists of the same pool behave like s21::list; iterators stay
+// valid until their element is erased. Moving a list hands over its
+// sentinel node, so moves never allocate; the moved-from list gets a new
+// sentinel when something is next put into it.
+template <typename T, typename Alloc = std::allocator<T>>
+class compact_list {
+ private:
+  using this_type = compact_list<T, Alloc>;
+  using node_type = details::compact_list_node<T>;
+
+ public:
+  using pool_type = compact_list_pool<T, Alloc>;
+  using value_type = T;
+  using reference = T&;
+  using const_reference = const T&;
+  using size_type = std::size_t;
+  using difference_type = std::ptrdiff_t;
+  using index_type = typename pool_type::index_type;
+  using iterator = details::compact_list_iterator<pool_type, T*, T&>;
+  using const_iterator =
+      details::compact_list_iterator<pool_type, const T*, const T&>;
+
+ public:
+  explicit compact_list(pool_type& pool);
+  compact_list(pool_type& pool, const std::initializer_list<value_type>& items);
+  compact_list(const this_type& o);
+  // Takes o's elements; o stays a valid empty list on the same pool.
+  compact_list(this_type&& o) noexcept
+      : pool_(o.pool_), head_(o.head_), size_(o.size_) {
+    o.head_ = pool_type::npos_;
+    o.size_ = 0;
+  }
+  this_type& operator=(const this_type& o);
+  this_type& operator=(this_type&& o) noexcept;
+  ~compact_list();
+
+  pool_type& pool() const noexcept { return *pool_; }
+
+  reference front();
+  const_reference front() const {
+    return const_cast<this_type*>(this)->front();
+  }
+  reference back();
+  const_reference back() const { return const_cast<this_type*>(this)->back(); }
+
+  iterator begin() noexcept {
+    return has_head() ? iterator(pool_, node(head_).next_) : end();
+  }
+  const_iterator begin() const noexcept {
+    return has_head() ? const_iterator(pool_, node(head_).next_) : end();
+  }
+  iterator end() noexcept { return iterator(pool_, head_); }
+  const_iterator end() const noexcept { return const_iterator(pool_, head_); }
+
+  bool empty() const noexcept { return size_ == 0; }
+  size_type size() const noexcept { return size_; }
+  constexpr size_type max_size() const noexcept { return max_size_; }
+
+  void clear() noexcept;
+  iterator insert(const_iterator pos, value_type&& val) {
+    return emplace(pos, std::move(val));
+  }
+  iterator insert(const_iterator pos, const_reference val) {
+    return emplace(pos, val);
+  }
+  iterator erase(const_iterator pos);
+  void push_back(value_type&& val) { emplace(end(), std::move(val)); }
+  void push_back(const_reference val) { emplace(end(), val); }
+  void pop_back() { erase(--end()); }
+  void push_front(value_type&& val) { emplace(begin(), std::move(val)); }
+  void push_front(const_reference val) { emplace(begin(), val); }
+  void pop_front() { erase(begin()); }
+  // Swaps pools as well, so it works across pools.
+  void swap(this_type& o) noexcept;
+  void splice(const_iterator pos, this_type& o);
+  void splice(const_iterator pos, this_type& o, const_iterator it);
+  void splice(const_iterator pos, this_type& o, const_iterator first,
+              const_iterator last);
+  void splice(const_iterator pos, this_type& o, const_iterator first,
+              const_iterator last, size_type n);
+  void reverse() noexcept;
+  void merge(this_type& o) { merge(o, std::less<value_type>()); }
+  template <typename Compare>
+  void merge(this_type& o, Compare comp);
+  void sort() { sort(std::less<value_type>()); }
+  template <typename Compare>
+  void sort(Compare comp);
+  size_type remove(const_reference val) {
+    return remove_if([&val](const_reference elem) { return elem == val; });
+  }
+  template <typename UnaryPredicate>
+  size_type remove_if(UnaryPredicate pred);
+
+  template <typename... Args>
+  iterator emplace(const_iterator pos, Args&&... args);
+  template <typename... Args>
+  reference emplace_back(Args&&... args) {
+    return *emplace(end(), std::forward<Args>(args)...);
+  }
+  template <typename... Args>
+  reference emplace_front(Args&&... args) {
+    return *emplace(begin(), std::forward<Args>(args)...);
+  }
+
+ private:
+  node_type& node(index_type i) const noexcept { return pool_->node(i); }
+  // A moved-from list has no sentinel until something is put into it.
+  bool has_head() const noexcept { return head_ != pool_type::npos_; }
+  void make_head();
+  // Index of pos, which is end() when the list has no sentinel yet.
+  index_type place(const_iterator pos) {
+    return has_head() ? pos.index_ : (make_head(), head_);
+  }
+  // Moves [first, last) in front of pos; all three may belong to different
+  // lists of the pool.
+  void transfer(index_type pos, index_type first, index_type last) noexcept;
+  void check_pool(const this_type& o, const char* msg) const;
+
+ private:
+  static constexpr size_type max_size_ = size_type(pool_type::npos_) - 1;
+
+  pool_type* pool_;
+  index_type head_;
+  size_type size_;
+};
+
+template <typename T, typename Alloc>
+compact_list<T, Alloc>::compact_list(pool_type& pool)
+    : pool_(&pool), head_(pool_type::npos_), size_() {
+  make_head();
+}
+
+template <typename T, typename Alloc>
+void compact_list<T, Alloc>::make_head() {
+  head_ = pool_->allocate();
+  node(head_).next_ = node(head_).prev_ = head_;
+}
+
+template <typename T, typename Alloc>
+compact_list<T, Alloc>::compact_list(
+    pool_type& pool, const std::initializer_list<value_type>& items)
+    : compact_list(pool) {
+  try {
+    for (const auto& item : items) {
+      emplace(end(), item);
+    }
+  } catch (...) {
+    clear();
+    pool_->deallocate(head_);
+    throw;
+  }
+}
+
+template <typename T, typename Alloc>
+compact_list<T, Alloc>::compact_list(const this_type& o)
+    : compact_list(*o.pool_) {
+  try {
+    for (const auto& item : o) {
+      emplace(end(), item);
+    }
+  } catch (...) {
+    clear();
+    pool_->deallocate(head_);
+    throw;
+  }
+}
+
+template <typename T, typename Alloc>
+compact_list<T, Alloc>::~compact_list() {
+  if (has_head()) {
+    clear();
+    pool_->deallocate(head_);
+  }
+}
+
+template <typename T, typename Alloc>
+typename compact_list<T, Alloc>::this_type& compact_list<T, Alloc>::operator=(
+    const this_type& o) {
+  if (&o != this) {
+    this_type res(o);
+    swap(res);
+  }
+
+  return *this;
+}
+
+template <typename T, typename Alloc>
+typename compact_list<T, Alloc>::this_type& compact_list<T, Alloc>::operator=(
+    this_type&& o) noexcept {
+  if (&o != this) {
+    this_type res(std::move(o));
+    swap(res);
+  }
+
+  return *this;
+}
+
+template <typename T, typename Alloc>
+typename compact_list<T, Alloc>::reference compact_list<T, Alloc>::front() {
+#ifdef DEBUG
+  if (empty()) {
+    throw std::out_of_range("s21::compact_list::front(). list is empty.");
+  }
+#endif
+
+  return *begin();
+}
+
+template <typename T, typename Alloc>
+typename compact_list<T, Alloc>::reference compact_list<T, Alloc>::back() {
+#ifdef DEBUG
+  if (empty()) {
+    throw std::out_of_range("s21::compact_list::back(). list is empty.");
+  }
+#endif
+
+  return *--end();
+}
+
+template <typename T, typename Alloc>
+void compact_list<T, Alloc>::clear() noexcept {
+  if (!has_head()) {
+    return;
+  }
+
+  for (index_type i = node(head_).next_; i != head_;) {
+    const index_type next = node(i).next_;
+
+    pool_->destroy(i);
+    pool_->deallocate(i);
+    i = next;
+  }
+  node(head_).next_ = node(head_).prev_ = head_;
+  size_ = 0;
+}
+
+template <typename T, typename Alloc>
+template <typename... Args>
+typename compact_list<T, Alloc>::iterator compact_list<T, Alloc>::emplace(
+    const_iterator pos, Args&&... args) {
+#ifdef DEBUG
+  if (size_ == max_size()) {
+    throw std::invalid_argument("s21::compact_list::emplace(). size too big.");
+  }
+#endif
+
+  const index_type at = place(pos);
+  const index_type i = pool_->allocate();
+
+  try {
+    pool_->construct(i, std::forward<Args>(args)...);
+  } catch (...) {
+    pool_->deallocate(i);
+    throw;
+  }
+
+  node_type& next = node(at);
+  node_type& tmp = node(i);
+
+  tmp.next_ = at;
+  tmp.prev_ = next.prev_;
+  node(next.prev_).next_ = i;
+  next.prev_ = i;
+  ++size_;
+
+  return iterator(pool_, i);
+}
+
+template <typename T, typename Alloc>
+typename compact_list<T, Alloc>::iterator compact_list<T, Alloc>::erase(
+    const_iterator pos) {
+#ifdef DEBUG
+  if (empty()) {
+    throw std::out_of_range("s21::compact_list::erase(). list is empty.");
+  }
+
+  if (pos == end()) {
+    throw std::out_of_range("s21::compact_list::erase(). pos is illegal.");
+  }
+#endif
+
+  node_type& tmp = node(pos.index_);
+  const index_type next = tmp.next_;
+
+  node(next).prev_ = tmp.prev_;
+  node(tmp.prev_).next_ = next;
+  pool_->destroy(pos.index_);
+  pool_->deallocate(pos.index_);
+  --size_;
+
+  return iterator(pool_, next);
+}
+
+template <typename T, typename Alloc>
+void compact_list<T, Alloc>::swap(this_type& o) noexcept {
+  std::swap(pool_, o.pool_);
+  std::swap(head_, o.head_);
+  std::swap(size_, o.size_);
+}
+
+template <typename T, typename Alloc>
+void compact_list<T, Alloc>::transfer(index_type pos, index_type first,
+                                      index_type last) noexcept {
+  if (first == last || pos == last) {
+    return;
+  }
+
+  const index_type before_pos = node(pos).prev_;
+  const index_type before_first = node(first).prev_;
+  const index_type before_last = node(last).prev_;
+
+  node(before_last).next_ = pos;
+  node(before_first).next_ = last;
+  node(before_pos).next_ = first;
+
+  node(pos).prev_ = before_last;
+  node(last).prev_ = before_first;
+  node(first).prev_ = before_pos;
+}
+
+template <typename T, typename Alloc>
+void compact_list<T, Alloc>::check_pool(
+    [[maybe_unused]] const this_type& o,
+    [[maybe_unused]] const char* msg) const {
+#ifdef DEBUG
+  if (pool_ != o.pool_) {
+    throw std::runtime_error(msg);
+  }
+#endif
+}
+
+template <typename T, typename Alloc>
+void compact_list<T, Alloc>::splice(const_iterator pos, this_type& o) {
+  check_pool(o, "s21::compact_list::splice(). cant splice from another pool.");
+
+  if (this != &o && !o.empty()) {
+    transfer(place(pos), node(o.head_).next_, o.head_);
+    size_ += o.size_;
+    o.size_ = 0;
+  }
+}
+
+template <typename T, typename Alloc>
+void compact_list<T, Alloc>::splice(const_iterator pos, this_type& o,
+                                    const_iterator it) {
+  check_pool(o, "s21::compact_list::splice(). cant splice from another pool.");
+
+#ifdef DEBUG
+  if (it == o.end()) {
+    throw std::out_of_range("s21::compact_list::splice(). it is illegal.");
+  }
+#endif
+
+  if (pos == it) {
+    return;
+  }
+
+  transfer(place(pos), it.index_, node(it.index_).next_);
+  ++size_;
+  --o.size_;
+}
+
+template <typename T, typename Alloc>
+void compact_list<T, Alloc>::splice(const_iterator pos, this_type& o,
+                                    const_iterator first,
+                                    const_iterator last) {
+  splice(pos, o, first, last,
+         this != &o ? size_type(std::distance(first, last)) : 0);
+}
+
+// n must be the length of [first, last), as for s21::list.
+template <typename T, typename Alloc>
+void compact_list<T, Alloc>::splice(const_iterator pos, this_type& o,
+                                    const_iterator first, const_iterator last,
+                                    size_type n) {
+  check_pool(o, "s21::compact_list::splice(). cant splice from another pool.");
+
+#ifdef DEBUG
+  if (this != &o && n != size_type(std::distance(first, last))) {
+    throw std::invalid_argument(
+        "s21::compact_list::splice(). n does not match the range.");
+  }
+#endif
+
+  if (first == last) {
+    return;
+  }
+
+  if (this != &o) {
+    size_ += n;
+    o.size_ -= n;
+  }
+
+  transfer(place(pos), first.index_, last.index_);
+}
+
+template <typename T, typename Alloc>
+void compact_list<T, Alloc>::reverse() noexcept {
+  if (!has_head()) {
+    return;
+  }
+
+  index_type i = head_;
+
+  do {
+    node_type& tmp = node(i);
+
+    std::swap(tmp.next_, tmp.prev_);
+    i = tmp.prev_;
+  } while (i != head_);
+}
+
+template <typename T, typename Alloc>
+template <typename Compare>
+void compact_list<T, Alloc>::merge(this_type& o, Compare comp) {
+  check_pool(o, "s21::compact_list::merge(). cant merge from another pool.");
+
+  if (this == &o || o.empty()) {
+    return;
+  }
+  if (!has_head()) {
+    make_head();
+  }
+
+  size_type moved = 0;
+
+  try {
+    index_type it = node(head_).next_;
+    index_type oit = node(o.head_).next_;
+
+    while (it != head_ && oit != o.head_) {
+      if (comp(*node(oit).val(), *node(it).val())) {
+        const index_type next = node(oit).next_;
+
+        transfer(it, oit, next);
+        oit = next;
+        ++moved;
+      } else {
+        it = node(it).next_;
+      }
+    }
+
+    transfer(head_, oit, o.head_);
+  } catch (...) {
+    size_ += moved;
+    o.size_ -= moved;
+    throw;
+  }
+
+  size_ += o.size_;
+  o.size_ = 0;
+}
+
+// Sorts a vector of indices and relinks once, so a throwing comp leaves the
+// list untouched.
+template <typename T, typename Alloc>
+template <typename Compare>
+void compact_list<T, Alloc>::sort(Compare comp) {
+  if (!has_head()) {
+    return;
+  }
+
+  s21::vector<index_type> order;
+
+  order.reserve(size_);
+  for (index_type i = node(head_).next_; i != head_; i = node(i).next_) {
+    order.push_back(i);
+  }
+
+  std::stable_sort(order.begin(), order.end(),
+                   [this, &comp](index_type lhs, index_type rhs) -> bool {
+                     return comp(*node(lhs).val(), *node(rhs).val());
+                   });
+
+  index_type prev = head_;
+
+  for (index_type i : order) {
+    node(prev).next_ = i;
+    node(i).prev_ = prev;
+    prev = i;
+  }
+  node(prev).next_ = head_;
+  node(head_).prev_ = prev;
+}
+
+// Matching nodes are parked in a local list and only destroyed at the end,
+// so val in remove(val) may refer to an element of this list.
+template <typename T, typename Alloc>
+template <typename UnaryPredicate>
+typename compact_list<T, Alloc>::size_type compact_list<T, Alloc>::remove_if(
+    UnaryPredicate pred) {
+  this_type removed(*pool_);
+
+  for (iterator it = begin(); it != end();) {
+    const iterator next = std::next(it);
+
+    if (pred(*it)) {
+      removed.splice(removed.end(), *this, it);
+    }
+    it = next;
+  }
+
+  return removed.size();
+}
+
+}  // namespace s21
+
+#endif  // S21_COMPACT_LIST_H_
@@ -0,0 +1,277 @@
+#ifndef S21_CONCURRENCY_H_
+#define S21_CONCURRENCY_H_
+
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <stdexcept>
+#include <thread>
+#include <utility>
+
+#include "s21_vector.h"
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <immintrin.h>
+#endif
+
+namespace s21 {
+
+namespace details {
+
+// Fixed instead of std::hardware_destructive_interference_size: the latter
+// is not ABI-stable and warns under -Werror on recent GCC.
+static constexpr std::size_t cache_line_size_ = 64;
+
+inline void cpu_relax() noexcept {
+#if defined(__x86_64__) || defined(__i386__)
+  _mm_pause();
+#elif defined(__aarch64__)
+  asm volatile("yield" ::: "memory");
+#endif
+}
+
+// Exponential spin that falls back to yielding the time slice once the
+// contention lasts longer than a few hundred pauses. Spinning cannot help on a
+// single hardware thread, so there it yields right away.
+class backoff {
+ public:
+  void operator()() noexcept {
+    if (spins_ < max_spins_ && !single_core()) {
+      for (unsigned i = 0; i < spins_; ++i) {
+        cpu_relax();
+      }
+      spins_ *= 2;
+    } else {
+      std::this_thread::yield();
+    }
+  }
+
+  void reset() noexcept { spins_ = 1; }
+
+ private:
+  static bool single_core() noexcept {
+    static const bool res = std::thread::hardware_concurrency() == 1;
+
+    return res;
+  }
+
+ private:
+  static constexpr unsigned max_spins_ = 256;
+
+  unsigned spins_ = 1;
+};
+
+// Hands out small dense indices to running threads so that lock-free
+// containers can keep per-thread state (hazard pointers, retire lists) in
+// plain arrays. An index is returned to the pool when its thread exits.
+class thread_slot {
+ public:
+  static constexpr std::size_t max_threads_ = 128;
+
+  static std::size_t index() {
+    thread_local const holder slot;
+
+    return slot.index_;
+  }
+
+ private:
+  class holder {
+   public:
+    holder() : index_(acquire()) {}
+    ~holder() { used()[index_].store(false, std::memory_order_release); }
+
+   public:
+    const std::size_t index_;
+  };
+
+  static std::atomic<bool>* used() noexcept {
+    static std::atomic<bool> flags[max_threads_] = {};
+
+    return flags;
+  }
+
+  static std::size_t acquire() {
+    for (std::size_t i = 0; i < max_threads_; ++i) {
+      bool expected = false;
+
+      if (used()[i].compare_exchange_strong(expected, true,
+                                            std::memory_order_acquire)) {
+        return i;
+      }
+    }
+
+    throw std::runtime_error(
+        "s21::details::thread_slot::index(). too many threads.");
+  }
+};
+
+// Test-and-test-and-set lock for short critical sections, one byte wide so it
+// can sit inside every node of a fine-grained container.
+class spin_lock {
+ public:
+  void lock() noexcept {
+    for (backoff wait; locked_.exchange(true, std::memory_order_acquire);) {
+      while (locked_.load(std::memory_order_relaxed)) {
+        wait();
+      }
+    }
+  }
+
+  void unlock() noexcept { locked_.store(false, std::memory_order_release); }
+
+ private:
+  std::atomic<bool> locked_{false};
+};
+
+// Epoch-based reclamation for containers whose readers traverse nodes without
+// taking locks. A thread pins the current epoch while it holds pointers into
+// the structure; a node retired in epoch e is handed back to its owner only
+// after the global epoch reached e + 2, at which point every thread that could
+// still see it has unpinned. Pins nest within a thread.
+template <typename T>
+class epoch_domain {
+ public:
+  using size_type = std::size_t;
+
+  // Keeps the calling thread pinned for its lifetime. Must be destroyed by
+  // the thread that created it.
+  class guard {
+   public:
+    guard() noexcept : domain_(nullptr) {}
+    explicit guard(const epoch_domain& domain) : domain_(&domain) {
+      domain_->enter();
+    }
+    guard(const guard& o) : domain_(o.domain_) {
+      if (domain_) {
+        domain_->enter();
+      }
+    }
+    guard(guard&& o) noexcept : domain_(std::exchange(o.domain_, nullptr)) {}
+    guard& operator=(guard o) noexcept {
+      return std::swap(domain_, o.domain_), *this;
+    }
+    ~guard() {
+      if (domain_) {
+        domain_->exit();
+      }
+    }
+
+   private:
+    const epoch_domain* domain_;
+  };
+
+ public:
+  epoch_domain() = default;
+  epoch_domain(const epoch_domain&) = delete;
+  epoch_domain& operator=(const epoch_domain&) = delete;
+
+  guard pin() const { return guard(*this); }
+
+  // Queues ptr and passes every node that became safe to free to reclaim.
+  // The caller must have unlinked ptr before retiring it.
+  template <typename Reclaim>
+  void retire(T* ptr, Reclaim&& reclaim);
+  // Frees everything still queued. Only for use once no thread is pinned.
+  template <typename Reclaim>
+  void drain(Reclaim&& reclaim);
+
+ private:
+  struct alignas(cache_line_size_) thread_state {
+    // 0 while the thread is not pinned.
+    std::atomic<size_type> epoch_{0};
+    size_type nesting_ = 0;
+    s21::vector<std::pair<T*, size_type>> retired_;
+  };
+
+  void enter() const;
+  void exit() const noexcept;
+  void try_advance() noexcept;
+
+ private:
+  static constexpr size_type collect_threshold_ = 64;
+
+  alignas(cache_line_size_) std::atomic<size_type> global_{1};
+  mutable thread_state threads_[thread_slot::max_threads_];
+};
+
+template <typename T>
+void epoch_domain<T>::enter() const {
+  thread_state& state = threads_[thread_slot::index()];
+
+  if (state.nesting_++ == 0) {
+    state.epoch_.store(global_.load(std::memory_order_relaxed));
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+  }
+}
+
+template <typename T>
+void epoch_domain<T>::exit() const noexcept {
+  thread_state& state = threads_[thread_slot::index()];
+
+  if (--state.nesting_ == 0) {
+    state.epoch_.store(0, std::memory_order_release);
+  }
+}
+
+// Moves the global epoch forward once every pinned thread has observed it.
+template <typename T>
+void epoch_domain<T>::try_advance() noexcept {
+  size_type global = global_.load();
+
+  for (const thread_state& state : threads_) {
+    const size_type epoch = state.epoch_.load();
+
+    if (epoch != 0 && epoch != global) {
+      return;
+    }
+  }
+
+  global_.compare_exchange_strong(global, global + 1);
+}
+
+template <typename T>
+template <typename Reclaim>
+void epoch_domain<T>::retire(T* ptr, Reclaim&& reclaim) {
+  thread_state& state = threads_[thread_slot::index()];
+
+  state.retired_.push_back({ptr, global_.load()});
+
+  if (state.retired_.size() < collect_threshold_) {
+    return;
+  }
+
+  try_advance();
+
+  const size_type global = global_.load();
+  size_type kept = 0;
+
+  for (size_type i = 0; i < state.retired_.size(); ++i) {
+    if (state.retired_[i].second + 2 <= global) {
+      reclaim(state.retired_[i].first);
+    } else {
+      state.retired_[kept++] = state.retired_[i];
+    }
+  }
+
+  while (state.retired_.size() > kept) {
+    state.retired_.pop_back();
+  }
+}
+
+template <typename T>
+template <typename Reclaim>
+void epoch_domain<T>::drain(Reclaim&& reclaim) {
+  for (thread_state& state : threads_) {
+    for (const auto& item : state.retired_) {
+      reclaim(item.first);
+    }
+    state.retired_.clear();
+  }
+}
+
+}  // namespace details
+
+}  // namespace s21
+
+#endif  // S21_CONCURRENCY_H_
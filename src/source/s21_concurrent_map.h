@@ -0,0 +1,569 @@
+#ifndef S21_CONCURRENT_MAP_H_
+#define S21_CONCURRENT_MAP_H_
+
+#pragma once
+
+#include <atomic>
+#include <functional>
+#include <iterator>
+#include <memory>
+#include <utility>
+
+#include "s21_concurrency.h"
+
+namespace s21 {
+
+template <typename Key, typename T, typename Compare, typename Alloc>
+class concurrent_map;
+
+namespace details {
+
+class skip_list_node_base {
+ public:
+  using link_type = std::atomic<skip_list_node_base*>;
+
+  skip_list_node_base(link_type* next, int height) noexcept
+      : next_(next), height_(height) {}
+
+  // Present in the map: fully linked and not logically removed.
+  bool live() const noexcept {
+    return fully_linked_.load(std::memory_order_acquire) &&
+           !marked_.load(std::memory_order_acquire);
+  }
+
+ public:
+  link_type* next_;
+  int height_;
+  std::atomic<bool> marked_{false};
+  std::atomic<bool> fully_linked_{false};
+  spin_lock lock_;
+};
+
+template <typename Value>
+class skip_list_node : public skip_list_node_base {
+ public:
+  template <typename... Args>
+  skip_list_node(link_type* next, int height, Args&&... args)
+      : skip_list_node_base(next, height), val_(std::forward<Args>(args)...) {}
+
+ public:
+  const Value val_;
+};
+
+// Forward iterator over live nodes. It keeps the creating thread pinned in
+// the map's epoch domain, so the element it points to stays readable even if
+// another thread erases it meanwhile.
+template <typename Value>
+class skip_list_iterator {
+ private:
+  using this_type = skip_list_iterator<Value>;
+  using base_node_type = skip_list_node_base;
+  using node_type = skip_list_node<Value>;
+  using guard_type = typename epoch_domain<base_node_type>::guard;
+
+ public:
+  using iterator_category = std::forward_iterator_tag;
+  using value_type = Value;
+  using difference_type = std::ptrdiff_t;
+  using pointer = const Value*;
+  using reference = const Value&;
+
+  template <typename Key, typename T, typename Compare, typename Alloc>
+  friend class s21::concurrent_map;
+
+ public:
+  skip_list_iterator() noexcept : node_(nullptr), pin_() {}
+
+  reference operator*() const noexcept {
+    return static_cast<node_type*>(node_)->val_;
+  }
+  pointer operator->() const noexcept { return &**this; }
+
+  this_type& operator++() noexcept {
+    node_ = skip(node_->next_[0].load(std::memory_order_acquire));
+    return *this;
+  }
+  this_type operator++(int) {
+    this_type res(*this);
+    return ++*this, res;
+  }
+
+  friend bool operator==(const this_type& l, const this_type& r) noexcept {
+    return l.node_ == r.node_;
+  }
+  friend bool operator!=(const this_type& l, const this_type& r) noexcept {
+    return l.node_ != r.node_;
+  }
+
+ private:
+  skip_list_iterator(base_node_type* node, guard_type pin) noexcept
+      : node_(skip(node)), pin_(node_ ? std::move(pin) : guard_type()) {}
+
+  static base_node_type* skip(base_node_type* node) noexcept {
+    while (node && !node->live()) {
+      node = node->next_[0].load(std::memory_order_acquire);
+    }
+    return node;
+  }
+
+ private:
+  base_node_type* node_;
+  guard_type pin_;
+};
+
+}  // namespace details
+
+// Ordered map for concurrent use (optimistic lazy skip list, Herlihy et al.).
+// Lookups and iteration take no locks; insert and erase lock only the
+// predecessors of the node they change, so writers on different key ranges do
+// not contend. Erased nodes are freed through epoch-based reclamation.
+// Elements are immutable once inserted, there is no operator[] or
+// insert_or_assign. Iterators must stay in the thread that created them.
+template <typename Key, typename T, typename Compare = std::less<Key>,
+          typename Alloc = std::allocator<std::pair<const Key, T>>>
+class concurrent_map {
+ private:
+  using this_type = concurrent_map<Key, T, Compare, Alloc>;
+
+  using base_node_type = details::skip_list_node_base;
+  using link_type = base_node_type::link_type;
+  using node_type = details::skip_list_node<std::pair<const Key, T>>;
+  using t_allocator_type = Alloc;
+  using t_allocator_traits = std::allocator_traits<t_allocator_type>;
+  using node_allocator_type =
+      typename t_allocator_traits::template rebind_alloc<node_type>;
+  using node_allocator_traits = std::allocator_traits<node_allocator_type>;
+
+ public:
+  using key_type = Key;
+  using mapped_type = T;
+  using value_type = std::pair<const Key, T>;
+  using key_compare = Compare;
+  using reference = const value_type&;
+  using const_reference = const value_type&;
+  using size_type = std::size_t;
+  using difference_type = std::ptrdiff_t;
+  using iterator = details::skip_list_iterator<value_type>;
+  using const_iterator = iterator;
+
+ public:
+  concurrent_map() : head_(head_links_, max_height_) {}
+  concurrent_map(const std::initializer_list<value_type>& items);
+  concurrent_map(const concurrent_map&) = delete;
+  concurrent_map(concurrent_map&&) = delete;
+  this_type& operator=(const concurrent_map&) = delete;
+  this_type& operator=(concurrent_map&&) = delete;
+  ~concurrent_map();
+
+  // Not linearizable while writers run: the per-thread counters are summed
+  // one by one.
+  size_type size() const noexcept;
+  bool empty() const noexcept { return begin() == end(); }
+
+  iterator begin() const;
+  iterator end() const noexcept { return iterator(); }
+
+  std::pair<iterator, bool> insert(const value_type& value) {
+    return emplace(value);
+  }
+  std::pair<iterator, bool> insert(value_type&& value) {
+    return emplace(std::move(value));
+  }
+  template <typename K, typename M>
+  std::pair<iterator, bool> insert(K&& key, M&& obj) {
+    return emplace(std::forward<K>(key), std::forward<M>(obj));
+  }
+  template <typename... Args>
+  std::pair<iterator, bool> emplace(Args&&... args);
+  template <typename... Args>
+  void insert_many(Args&&... args);
+
+  size_type erase(const key_type& key);
+
+  iterator find(const key_type& key) const;
+  bool contains(const key_type& key) const;
+  iterator lower_bound(const key_type& key) const;
+  iterator upper_bound(const key_type& key) const;
+
+ private:
+  static const key_type& key_of(const base_node_type* node) noexcept {
+    return static_cast<const node_type*>(node)->val_.first;
+  }
+
+  int find_preds(const key_type& key, base_node_type** preds,
+                 base_node_type** succs) const;
+  base_node_type* first_not_less(const key_type& key, bool strict) const;
+  static void unlock(base_node_type** preds, int height) noexcept;
+  static int random_height() noexcept;
+
+  // Node-sized blocks needed for a node with height links.
+  static constexpr size_type blocks(int height) noexcept {
+    return 1 + (height * sizeof(link_type) + sizeof(node_type) - 1) /
+                   sizeof(node_type);
+  }
+  template <typename... Args>
+  node_type* create(Args&&... args);
+  void destroy(base_node_type* node) noexcept;
+
+ private:
+  // With a branching factor of 4 this covers 4^16 elements.
+  static constexpr int max_height_ = 16;
+  static constexpr size_type size_stripes_ = 16;
+
+  struct alignas(details::cache_line_size_) size_stripe {
+    std::atomic<difference_type> count_{0};
+  };
+
+  node_allocator_type node_alloc_;
+  key_compare comp_;
+
+  link_type head_links_[max_height_] = {};
+  base_node_type head_;
+
+  size_stripe size_[size_stripes_];
+  details::epoch_domain<base_node_type> domain_;
+};
+
+template <typename Key, typename T, typename Compare, typename Alloc>
+concurrent_map<Key, T, Compare, Alloc>::concurrent_map(
+    const std::initializer_list<value_type>& items)
+    : concurrent_map() {
+  for (const auto& item : items) {
+    insert(item);
+  }
+}
+
+template <typename Key, typename T, typename Compare, typename Alloc>
+concurrent_map<Key, T, Compare, Alloc>::~concurrent_map() {
+  for (base_node_type* node = head_.next_[0].load(std::memory_order_relaxed);
+       node;) {
+    base_node_type* next = node->next_[0].load(std::memory_order_relaxed);
+
+    destroy(node);
+    node = next;
+  }
+  domain_.drain([this](base_node_type* node) { destroy(node); });
+}
+
+template <typename Key, typename T, typename Compare, typename Alloc>
+typename concurrent_map<Key, T, Compare, Alloc>::size_type
+concurrent_map<Key, T, Compare, Alloc>::size() const noexcept {
+  difference_type res = 0;
+
+  for (const size_stripe& stripe : size_) {
+    res += stripe.count_.load(std::memory_order_relaxed);
+  }
+
+  return res < 0 ? 0 : size_type(res);
+}
+
+template <typename Key, typename T, typename Compare, typename Alloc>
+typename concurrent_map<Key, T, Compare, Alloc>::iterator
+concurrent_map<Key, T, Compare, Alloc>::begin() const {
+  auto pin = domain_.pin();
+
+  return iterator(head_.next_[0].load(std::memory_order_acquire),
+                  std::move(pin));
+}
+
+// A node and its tower of links share one allocation: the links follow the
+// node in storage, so a search step touches a single block.
+template <typename Key, typename T, typename Compare, typename Alloc>
+template <typename... Args>
+typename concurrent_map<Key, T, Compare, Alloc>::node_type*
+concurrent_map<Key, T, Compare, Alloc>::create(Args&&... args) {
+  const int height = random_height();
+  const size_type n = blocks(height);
+  auto deleter = [this, n](node_type* ptr) {
+    node_allocator_traits::deallocate(node_alloc_, ptr, n);
+  };
+  std::unique_ptr<node_type, decltype(deleter)> node(
+      node_allocator_traits::allocate(node_alloc_, n), deleter);
+  link_type* links = reinterpret_cast<link_type*>(node.get() + 1);
+
+  for (int i = 0; i < height; ++i) {
+    ::new (static_cast<void*>(links + i)) link_type(nullptr);
+  }
+  node_allocator_traits::construct(node_alloc_, node.get(), links, height,
+                                   std::forward<Args>(args)...);
+
+  return node.release();
+}
+
+template <typename Key, typename T, typename Compare, typename Alloc>
+void concurrent_map<Key, T, Compare, Alloc>::destroy(
+    base_node_type* node) noexcept {
+  node_type* ptr = static_cast<node_type*>(node);
+  const size_type n = blocks(ptr->height_);
+
+  node_allocator_traits::destroy(node_alloc_, ptr);
+  node_allocator_traits::deallocate(node_alloc_, ptr, n);
+}
+
+// Level i is reached with probability 4^-i.
+template <typename Key, typename T, typename Compare, typename Alloc>
+int concurrent_map<Key, T, Compare, Alloc>::random_height() noexcept {
+  thread_local unsigned state =
+      unsigned(details::thread_slot::index()) * 2654435761u + 1;
+
+  state ^= state << 13;
+  state ^= state >> 17;
+  state ^= state << 5;
+
+  int height = 1;
+
+  for (unsigned bits = state; height < max_height_ && (bits & 3) == 0;
+       bits >>= 2) {
+    ++height;
+  }
+
+  return height;
+}
+
+// Fills preds/succs with the last node before key and the first node not
+// before it on every level. Returns the highest level on which key itself was
+// found, or -1.
+template <typename Key, typename T, typename Compare, typename Alloc>
+int concurrent_map<Key, T, Compare, Alloc>::find_preds(
+    const key_type& key, base_node_type** preds,
+    base_node_type** succs) const {
+  int found = -1;
+  base_node_type* pred = const_cast<base_node_type*>(&head_);
+
+  for (int level = max_height_ - 1; level >= 0; --level) {
+    base_node_type* curr = pred->next_[level].load(std::memory_order_acquire);
+
+    while (curr && comp_(key_of(curr), key)) {
+      pred = curr;
+      curr = pred->next_[level].load(std::memory_order_acquire);
+    }
+
+    if (found == -1 && curr && !comp_(key, key_of(curr))) {
+      found = level;
+    }
+    preds[level] = pred;
+    succs[level] = curr;
+  }
+
+  return found;
+}
+
+// First node with key >= key, or > key when strict. May return a node that is
+// being removed, callers skip those.
+template <typename Key, typename T, typename Compare, typename Alloc>
+typename concurrent_map<Key, T, Compare, Alloc>::base_node_type*
+concurrent_map<Key, T, Compare, Alloc>::first_not_less(const key_type& key,
+                                                       bool strict) const {
+  const base_node_type* pred = &head_;
+  base_node_type* curr = nullptr;
+
+  for (int level = max_height_ - 1; level >= 0; --level) {
+    curr = pred->next_[level].load(std::memory_order_acquire);
+
+    while (curr && (strict ? !comp_(key, key_of(curr))
+                           : comp_(key_of(curr), key))) {
+      pred = curr;
+      curr = pred->next_[level].load(std::memory_order_acquire);
+    }
+  }
+
+  return curr;
+}
+
+// Releases the distinct predecessor locks taken on levels [0, height).
+template <typename Key, typename T, typename Compare, typename Alloc>
+void concurrent_map<Key, T, Compare, Alloc>::unlock(base_node_type** preds,
+                                                    int height) noexcept {
+  base_node_type* prev = nullptr;
+
+  for (int level = 0; level < height; ++level) {
+    if (preds[level] != prev) {
+      prev = preds[level];
+      prev->lock_.unlock();
+    }
+  }
+}
+
+// The node is built up front, so the key is only compared, never copied. When
+// the key is already present the node is dropped again.
+template <typename Key, typename T, typename Compare, typename Alloc>
+template <typename... Args>
+std::pair<typename concurrent_map<Key, T, Compare, Alloc>::iterator, bool>
+concurrent_map<Key, T, Compare, Alloc>::emplace(Args&&... args) {
+  auto pin = domain_.pin();
+  node_type* node = create(std::forward<Args>(args)...);
+  const key_type& key = key_of(node);
+  const int height = node->height_;
+  base_node_type* preds[max_height_];
+  base_node_type* succs[max_height_];
+
+  for (details::backoff wait;;) {
+    const int found = find_preds(key, preds, succs);
+
+    if (found != -1) {
+      base_node_type* existing = succs[found];
+
+      if (!existing->marked_.load(std::memory_order_acquire)) {
+        while (!existing->fully_linked_.load(std::memory_order_acquire)) {
+          wait();
+        }
+        destroy(node);
+
+        return {iterator(existing, std::move(pin)), false};
+      }
+      wait();
+      continue;
+    }
+
+    int locked = 0;
+    bool valid = true;
+
+    for (base_node_type* prev = nullptr; valid && locked < height; ++locked) {
+      base_node_type* pred = preds[locked];
+      base_node_type* succ = succs[locked];
+
+      if (pred != prev) {
+        pred->lock_.lock();
+        prev = pred;
+      }
+      valid = !pred->marked_.load(std::memory_order_acquire) &&
+              (!succ || !succ->marked_.load(std::memory_order_acquire)) &&
+              pred->next_[locked].load(std::memory_order_acquire) == succ;
+    }
+
+    if (!valid) {
+      unlock(preds, locked);
+      wait();
+      continue;
+    }
+
+    for (int level = 0; level < height; ++level) {
+      node->next_[level].store(succs[level], std::memory_order_relaxed);
+    }
+    for (int level = 0; level < height; ++level) {
+      preds[level]->next_[level].store(node, std::memory_order_release);
+    }
+    node->fully_linked_.store(true, std::memory_order_release);
+    unlock(preds, height);
+
+    size_[details::thread_slot::index() % size_stripes_].count_.fetch_add(
+        1, std::memory_order_relaxed);
+
+    return {iterator(node, std::move(pin)), true};
+  }
+}
+
+template <typename Key, typename T, typename Compare, typename Alloc>
+template <typename... Args>
+void concurrent_map<Key, T, Compare, Alloc>::insert_many(Args&&... args) {
+  (..., insert(std::forward<Args>(args)));
+}
+
+// Marks the node under its own lock (the linearization point), then unlinks
+// it top-down under the predecessors' locks and retires it.
+template <typename Key, typename T, typename Compare, typename Alloc>
+typename concurrent_map<Key, T, Compare, Alloc>::size_type
+concurrent_map<Key, T, Compare, Alloc>::erase(const key_type& key) {
+  auto pin = domain_.pin();
+  base_node_type* victim = nullptr;
+  base_node_type* preds[max_height_];
+  base_node_type* succs[max_height_];
+
+  for (details::backoff wait;;) {
+    const int found = find_preds(key, preds, succs);
+
+    if (!victim) {
+      if (found == -1) {
+        return 0;
+      }
+
+      base_node_type* node = succs[found];
+
+      if (!node->fully_linked_.load(std::memory_order_acquire) ||
+          node->height_ - 1 != found ||
+          node->marked_.load(std::memory_order_acquire)) {
+        return 0;
+      }
+
+      node->lock_.lock();
+      if (node->marked_.load(std::memory_order_relaxed)) {
+        node->lock_.unlock();
+        return 0;
+      }
+      node->marked_.store(true, std::memory_order_release);
+      victim = node;
+    }
+
+    const int height = victim->height_;
+    int locked = 0;
+    bool valid = true;
+
+    for (base_node_type* prev = nullptr; valid && locked < height; ++locked) {
+      base_node_type* pred = preds[locked];
+
+      if (pred != prev) {
+        pred->lock_.lock();
+        prev = pred;
+      }
+      valid = !pred->marked_.load(std::memory_order_acquire) &&
+              pred->next_[locked].load(std::memory_order_acquire) == victim;
+    }
+
+    if (!valid) {
+      unlock(preds, locked);
+      wait();
+      continue;
+    }
+
+    for (int level = height - 1; level >= 0; --level) {
+      preds[level]->next_[level].store(
+          victim->next_[level].load(std::memory_order_relaxed),
+          std::memory_order_release);
+    }
+    victim->lock_.unlock();
+    unlock(preds, height);
+
+    size_[details::thread_slot::index() % size_stripes_].count_.fetch_sub(
+        1, std::memory_order_relaxed);
+    domain_.retire(victim, [this](base_node_type* node) { destroy(node); });
+
+    return 1;
+  }
+}
+
+template <typename Key, typename T, typename Compare, typename Alloc>
+typename concurrent_map<Key, T, Compare, Alloc>::iterator
+concurrent_map<Key, T, Compare, Alloc>::find(const key_type& key) const {
+  iterator res = lower_bound(key);
+
+  return res != end() && !comp_(key, res->first) ? res : end();
+}
+
+template <typename Key, typename T, typename Compare, typename Alloc>
+bool concurrent_map<Key, T, Compare, Alloc>::contains(
+    const key_type& key) const {
+  auto pin = domain_.pin();
+  base_node_type* node = first_not_less(key, false);
+
+  return node && !comp_(key, key_of(node)) && node->live();
+}
+
+template <typename Key, typename T, typename Compare, typename Alloc>
+typename concurrent_map<Key, T, Compare, Alloc>::iterator
+concurrent_map<Key, T, Compare, Alloc>::lower_bound(const key_type& key) const {
+  auto pin = domain_.pin();
+
+  return iterator(first_not_less(key, false), std::move(pin));
+}
+
+template <typename Key, typename T, typename Compare, typename Alloc>
+typename concurrent_map<Key, T, Compare, Alloc>::iterator
+concurrent_map<Key, T, Compare, Alloc>::upper_bound(const key_type& key) const {
+  auto pin = domain_.pin();
+
+  return iterator(first_not_less(key, true), std::move(pin));
+}
+
+}  // namespace s21
+
+#endif  // S21_CONCURRENT_MAP_H_
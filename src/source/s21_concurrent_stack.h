@@ -0,0 +1,430 @@
+#ifndef S21_CONCURRENT_STACK_H_
+#define S21_CONCURRENT_STACK_H_
+
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <memory>
+#include <type_traits>
+#include <utility>
+
+#include "s21_concurrency.h"
+
+namespace s21 {
+
+namespace details {
+
+class concurrent_stack_node_base {
+ public:
+  // Written once before the node is published and never changed while it is
+  // reachable, so readers holding a hazard pointer may follow it.
+  concurrent_stack_node_base* next_ = nullptr;
+  // Link of the per-thread retire list, kept apart from next_ for the same
+  // reason.
+  concurrent_stack_node_base* retired_next_ = nullptr;
+};
+
+template <typename T>
+class concurrent_stack_node : public concurrent_stack_node_base {
+ public:
+  template <typename... Args>
+  explicit concurrent_stack_node(std::in_place_t, Args&&... args)
+      : val_(std::forward<Args>(args)...) {}
+
+ public:
+  T val_;
+};
+
+}  // namespace details
+
+// Lock-free LIFO stack (Treiber). Nodes are reclaimed through hazard pointers,
+// which also rules out ABA on top_: a node cannot be freed and reused while a
+// popper still compares against it. With Elimination set, a push and a pop
+// that both lost the race on top_ may meet in a small exchange array and hand
+// the node over directly, which keeps throughput up under heavy contention.
+template <typename T, bool Elimination = false,
+          typename Alloc = std::allocator<T>>
+class concurrent_stack {
+ private:
+  using this_type = concurrent_stack<T, Elimination, Alloc>;
+
+  using base_node_type = details::concurrent_stack_node_base;
+  using node_type = details::concurrent_stack_node<T>;
+  using t_allocator_type = Alloc;
+  using t_allocator_traits = std::allocator_traits<t_allocator_type>;
+  using node_allocator_type =
+      typename t_allocator_traits::template rebind_alloc<node_type>;
+  using node_allocator_traits = std::allocator_traits<node_allocator_type>;
+
+ public:
+  using value_type = T;
+  using reference = T&;
+  using const_reference = const T&;
+  using size_type = std::size_t;
+
+ public:
+  concurrent_stack() = default;
+  concurrent_stack(const concurrent_stack&) = delete;
+  concurrent_stack(concurrent_stack&&) = delete;
+  this_type& operator=(const concurrent_stack&) = delete;
+  this_type& operator=(concurrent_stack&&) = delete;
+  ~concurrent_stack();
+
+  bool empty() const noexcept {
+    return top_.load(std::memory_order_acquire) == nullptr;
+  }
+
+  void push(const_reference value) { emplace(value); }
+  void push(value_type&& value) { emplace(std::move(value)); }
+  template <typename... Args>
+  void emplace(Args&&... args);
+  template <typename... Args>
+  void insert_many_back(Args&&... args);
+
+  bool top(reference value) const;
+  bool try_pop(reference value);
+  void pop(reference value);
+
+ private:
+  // Per-thread state, indexed by details::thread_slot. The hazard pointer is
+  // read by every reclaiming thread, the retire list only by its owner.
+  struct alignas(details::cache_line_size_) thread_state {
+    std::atomic<base_node_type*> hazard_{nullptr};
+    base_node_type* retired_ = nullptr;
+    size_type retired_count_ = 0;
+  };
+
+  struct alignas(details::cache_line_size_) exchanger {
+    std::atomic<base_node_type*> offer_{nullptr};
+  };
+
+  thread_state& self() const {
+    return threads_[details::thread_slot::index()];
+  }
+  base_node_type* protect(thread_state& self) const noexcept;
+
+  template <typename... Args>
+  node_type* create(Args&&... args);
+  void destroy(base_node_type* node) noexcept;
+  void retire(thread_state& self, base_node_type* node) noexcept;
+  void reclaim(thread_state& self) noexcept;
+
+  bool offer(base_node_type* node) noexcept;
+  node_type* take() noexcept;
+  static size_type pick() noexcept;
+  static base_node_type* taken() noexcept {
+    static base_node_type marker;
+
+    return &marker;
+  }
+
+ private:
+  static constexpr size_type max_threads_ = details::thread_slot::max_threads_;
+  static constexpr size_type reclaim_threshold_ = 2 * max_threads_;
+  static constexpr size_type elimination_slots_ = Elimination ? 8 : 1;
+  static constexpr unsigned elimination_spins_ = 128;
+
+  node_allocator_type alloc_;
+
+  alignas(details::cache_line_size_) std::atomic<base_node_type*> top_{
+      nullptr};
+  // Number of top() calls in flight. Pop moves the value out of a node only
+  // when nobody may be copying it at the same time.
+  alignas(details::cache_line_size_) mutable std::atomic<size_type> readers_{
+      0};
+
+  mutable thread_state threads_[max_threads_];
+  exchanger exchange_[elimination_slots_];
+};
+
+// Must not run concurrently with any other member.
+template <typename T, bool Elimination, typename Alloc>
+concurrent_stack<T, Elimination, Alloc>::~concurrent_stack() {
+  for (base_node_type* node = top_.load(std::memory_order_relaxed); node;) {
+    base_node_type* next = node->next_;
+
+    destroy(node);
+    node = next;
+  }
+
+  for (thread_state& state : threads_) {
+    for (base_node_type* node = state.retired_; node;) {
+      base_node_type* next = node->retired_next_;
+
+      destroy(node);
+      node = next;
+    }
+  }
+}
+
+// Publishes the current top in the caller's hazard pointer and re-reads top_
+// until both agree; from then on the node stays allocated.
+template <typename T, bool Elimination, typename Alloc>
+typename concurrent_stack<T, Elimination, Alloc>::base_node_type*
+concurrent_stack<T, Elimination, Alloc>::protect(
+    thread_state& self) const noexcept {
+  base_node_type* node = top_.load(std::memory_order_acquire);
+
+  for (;;) {
+    self.hazard_.store(node);
+
+    base_node_type* again = top_.load();
+
+    if (again == node) {
+      return node;
+    }
+    node = again;
+  }
+}
+
+template <typename T, bool Elimination, typename Alloc>
+template <typename... Args>
+typename concurrent_stack<T, Elimination, Alloc>::node_type*
+concurrent_stack<T, Elimination, Alloc>::create(Args&&... args) {
+  auto deleter = [&](node_type* ptr) {
+    node_allocator_traits::deallocate(alloc_, ptr, 1);
+  };
+  std::unique_ptr<node_type, decltype(deleter)> tmp(
+      node_allocator_traits::allocate(alloc_, 1), deleter);
+
+  node_allocator_traits::construct(alloc_, tmp.get(), std::in_place,
+                                   std::forward<Args>(args)...);
+
+  return tmp.release();
+}
+
+template <typename T, bool Elimination, typename Alloc>
+void concurrent_stack<T, Elimination, Alloc>::destroy(
+    base_node_type* node) noexcept {
+  node_type* ptr = static_cast<node_type*>(node);
+
+  node_allocator_traits::destroy(alloc_, ptr);
+  node_allocator_traits::deallocate(alloc_, ptr, 1);
+}
+
+template <typename T, bool Elimination, typename Alloc>
+void concurrent_stack<T, Elimination, Alloc>::retire(
+    thread_state& self, base_node_type* node) noexcept {
+  node->retired_next_ = self.retired_;
+  self.retired_ = node;
+
+  if (++self.retired_count_ >= reclaim_threshold_) {
+    reclaim(self);
+  }
+}
+
+// Frees every retired node of the caller that no hazard pointer refers to.
+// Runs once per reclaim_threshold_ retirements, so the scan over all threads
+// is amortized.
+template <typename T, bool Elimination, typename Alloc>
+void concurrent_stack<T, Elimination, Alloc>::reclaim(
+    thread_state& self) noexcept {
+  base_node_type* hazards[max_threads_];
+  size_type count = 0;
+
+  for (const thread_state& state : threads_) {
+    if (base_node_type* node = state.hazard_.load()) {
+      hazards[count++] = node;
+    }
+  }
+  std::sort(hazards, hazards + count);
+
+  base_node_type* kept = nullptr;
+  size_type kept_count = 0;
+
+  for (base_node_type* node = self.retired_; node;) {
+    base_node_type* next = node->retired_next_;
+
+    if (std::binary_search(hazards, hazards + count, node)) {
+      node->retired_next_ = kept;
+      kept = node;
+      ++kept_count;
+    } else {
+      destroy(node);
+    }
+    node = next;
+  }
+
+  self.retired_ = kept;
+  self.retired_count_ = kept_count;
+}
+
+template <typename T, bool Elimination, typename Alloc>
+typename concurrent_stack<T, Elimination, Alloc>::size_type
+concurrent_stack<T, Elimination, Alloc>::pick() noexcept {
+  thread_local unsigned state =
+      unsigned(details::thread_slot::index()) * 2654435761u + 1;
+
+  state ^= state << 13;
+  state ^= state >> 17;
+  state ^= state << 5;
+
+  return state % elimination_slots_;
+}
+
+// Parks node in a random exchange slot for a short while. Returns true when a
+// popper took it, false when the offer was withdrawn and node is still ours.
+// A taker leaves the taken() marker behind, and only the offering thread
+// clears it, so the slot cannot see the same node twice while it waits.
+template <typename T, bool Elimination, typename Alloc>
+bool concurrent_stack<T, Elimination, Alloc>::offer(
+    base_node_type* node) noexcept {
+  std::atomic<base_node_type*>& slot = exchange_[pick()].offer_;
+  base_node_type* expected = nullptr;
+
+  if (!slot.compare_exchange_strong(expected, node, std::memory_order_release,
+                                    std::memory_order_relaxed)) {
+    return false;
+  }
+
+  for (unsigned i = 0; i < elimination_spins_; ++i) {
+    if (slot.load(std::memory_order_relaxed) == taken()) {
+      break;
+    }
+    details::cpu_relax();
+  }
+
+  expected = node;
+  if (slot.compare_exchange_strong(expected, nullptr,
+                                   std::memory_order_relaxed)) {
+    return false;
+  }
+  slot.store(nullptr, std::memory_order_relaxed);
+
+  return true;
+}
+
+template <typename T, bool Elimination, typename Alloc>
+typename concurrent_stack<T, Elimination, Alloc>::node_type*
+concurrent_stack<T, Elimination, Alloc>::take() noexcept {
+  std::atomic<base_node_type*>& slot = exchange_[pick()].offer_;
+  base_node_type* node = slot.load(std::memory_order_relaxed);
+
+  if (node == nullptr || node == taken() ||
+      !slot.compare_exchange_strong(node, taken(), std::memory_order_acquire,
+                                    std::memory_order_relaxed)) {
+    return nullptr;
+  }
+
+  return static_cast<node_type*>(node);
+}
+
+template <typename T, bool Elimination, typename Alloc>
+template <typename... Args>
+void concurrent_stack<T, Elimination, Alloc>::emplace(Args&&... args) {
+  node_type* node = create(std::forward<Args>(args)...);
+  base_node_type* old = top_.load(std::memory_order_relaxed);
+
+  for (details::backoff wait;;) {
+    node->next_ = old;
+
+    if (top_.compare_exchange_weak(old, node, std::memory_order_release,
+                                   std::memory_order_relaxed)) {
+      return;
+    }
+
+    if constexpr (Elimination) {
+      if (offer(node)) {
+        return;
+      }
+      old = top_.load(std::memory_order_relaxed);
+    }
+    wait();
+  }
+}
+
+template <typename T, bool Elimination, typename Alloc>
+template <typename... Args>
+void concurrent_stack<T, Elimination, Alloc>::insert_many_back(
+    Args&&... args) {
+  (..., emplace(std::forward<Args>(args)));
+}
+
+// Copies the top element into value. Returns false when the stack is empty.
+template <typename T, bool Elimination, typename Alloc>
+bool concurrent_stack<T, Elimination, Alloc>::top(reference value) const {
+  thread_state& state = self();
+
+  readers_.fetch_add(1);
+
+  base_node_type* node = protect(state);
+
+  try {
+    if (node) {
+      value = static_cast<node_type*>(node)->val_;
+    }
+  } catch (...) {
+    state.hazard_.store(nullptr, std::memory_order_release);
+    readers_.fetch_sub(1, std::memory_order_release);
+    throw;
+  }
+
+  state.hazard_.store(nullptr, std::memory_order_release);
+  readers_.fetch_sub(1, std::memory_order_release);
+
+  return node != nullptr;
+}
+
+// Once the CAS has unlinked node, a top() that has not validated it yet never
+// will, so readers_ == 0 afterwards means nobody else reads val_.
+template <typename T, bool Elimination, typename Alloc>
+bool concurrent_stack<T, Elimination, Alloc>::try_pop(reference value) {
+  thread_state& state = self();
+
+  for (details::backoff wait;;) {
+    base_node_type* node = protect(state);
+
+    if (node == nullptr) {
+      return false;
+    }
+
+    if (top_.compare_exchange_strong(node, node->next_)) {
+      state.hazard_.store(nullptr, std::memory_order_release);
+
+      value_type& val = static_cast<node_type*>(node)->val_;
+
+      try {
+        if constexpr (std::is_copy_assignable_v<value_type>) {
+          if (readers_.load() != 0) {
+            value = val;
+          } else {
+            value = std::move(val);
+          }
+        } else {
+          value = std::move(val);
+        }
+      } catch (...) {
+        retire(state, node);
+        throw;
+      }
+      retire(state, node);
+
+      return true;
+    }
+    state.hazard_.store(nullptr, std::memory_order_release);
+
+    if constexpr (Elimination) {
+      if (node_type* given = take()) {
+        auto deleter = [&](node_type* ptr) { destroy(ptr); };
+        std::unique_ptr<node_type, decltype(deleter)> tmp(given, deleter);
+
+        value = std::move(tmp->val_);
+
+        return true;
+      }
+    }
+    wait();
+  }
+}
+
+template <typename T, bool Elimination, typename Alloc>
+void concurrent_stack<T, Elimination, Alloc>::pop(reference value) {
+  for (details::backoff wait; !try_pop(value);) {
+    wait();
+  }
+}
+
+}  // namespace s21
+
+#endif  // S21_CONCURRENT_STACK_H_
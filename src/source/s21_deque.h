@@ -0,0 +1,572 @@
+#ifndef S21_DEQUE_H_
+#define S21_DEQUE_H_
+
+#pragma once
+
+#include <algorithm>
+#include <initializer_list>
+#include <iterator>
+#include <memory>
+#include <stdexcept>
+
+namespace s21 {
+
+namespace details {
+
+// Elements per block: the largest power of two that keeps a block around
+// 4 KiB, but never fewer than 16 elements.
+template <typename T>
+constexpr std::size_t deque_block_size() noexcept {
+  std::size_t n = sizeof(T) < 256 ? 4096 / sizeof(T) : 16;
+  std::size_t res = 16;
+
+  while (res * 2 <= n) {
+    res *= 2;
+  }
+
+  return res;
+}
+
+template <typename T, typename Pointer, typename Reference>
+class deque_iterator {
+ private:
+  using this_type = deque_iterator<T, Pointer, Reference>;
+
+  using iterator = deque_iterator<T, T*, T&>;
+  using const_iterator = deque_iterator<T, const T*, const T&>;
+
+  static constexpr std::size_t block_size_ = deque_block_size<T>();
+
+ public:
+  using size_type = std::size_t;
+  using difference_type = std::ptrdiff_t;
+  using value_type = T;
+  using pointer = Pointer;
+  using reference = Reference;
+  using iterator_category = std::random_access_iterator_tag;
+
+ public:
+  deque_iterator(T* const* map, size_type pos) noexcept
+      : map_(const_cast<T**>(map)), pos_(pos) {}
+  deque_iterator(const iterator& o) noexcept : map_(o.map_), pos_(o.pos_) {}
+  deque_iterator(const const_iterator& o) noexcept
+      : map_(o.map_), pos_(o.pos_) {}
+  this_type& operator=(const iterator& o) noexcept {
+    return map_ = o.map_, pos_ = o.pos_, *this;
+  }
+  this_type& operator=(const const_iterator& o) noexcept {
+    return map_ = o.map_, pos_ = o.pos_, *this;
+  }
+
+  reference operator*() const noexcept {
+    return map_[pos_ / block_size_][pos_ % block_size_];
+  }
+  pointer operator->() const noexcept { return &**this; }
+  reference operator[](difference_type n) const noexcept {
+    return *(*this + n);
+  }
+
+  this_type& operator++() noexcept { return ++pos_, *this; }
+  this_type operator++(int) noexcept { return this_type(map_, pos_++); }
+  this_type& operator--() noexcept { return --pos_, *this; }
+  this_type operator--(int) noexcept { return this_type(map_, pos_--); }
+
+  this_type& operator+=(difference_type n) noexcept { return pos_ += n, *this; }
+  this_type& operator-=(difference_type n) noexcept { return pos_ -= n, *this; }
+  this_type operator+(difference_type n) const noexcept {
+    return this_type(map_, pos_ + n);
+  }
+  this_type operator-(difference_type n) const noexcept {
+    return this_type(map_, pos_ - n);
+  }
+
+ public:
+  T** map_;
+  size_type pos_;
+};
+
+template <typename T, typename LPointer, typename LReference, typename RPointer,
+          typename RReference>
+inline bool operator==(
+    const deque_iterator<T, LPointer, LReference>& lhs,
+    const deque_iterator<T, RPointer, RReference>& rhs) noexcept {
+  return lhs.pos_ == rhs.pos_;
+}
+
+template <typename T, typename LPointer, typename LReference, typename RPointer,
+          typename RReference>
+inline bool operator!=(
+    const deque_iterator<T, LPointer, LReference>& lhs,
+    const deque_iterator<T, RPointer, RReference>& rhs) noexcept {
+  return lhs.pos_ != rhs.pos_;
+}
+
+template <typename T, typename LPointer, typename LReference, typename RPointer,
+          typename RReference>
+inline bool operator<(
+    const deque_iterator<T, LPointer, LReference>& lhs,
+    const deque_iterator<T, RPointer, RReference>& rhs) noexcept {
+  return lhs.pos_ < rhs.pos_;
+}
+
+template <typename T, typename LPointer, typename LReference, typename RPointer,
+          typename RReference>
+inline std::ptrdiff_t operator-(
+    const deque_iterator<T, LPointer, LReference>& lhs,
+    const deque_iterator<T, RPointer, RReference>& rhs) noexcept {
+  return std::ptrdiff_t(lhs.pos_ - rhs.pos_);
+}
+
+template <typename T, typename LPointer, typename LReference, typename RPointer,
+          typename RReference>
+inline bool operator>(
+    const deque_iterator<T, LPointer, LReference>& lhs,
+    const deque_iterator<T, RPointer, RReference>& rhs) noexcept {
+  return rhs < lhs;
+}
+
+template <typename T, typename LPointer, typename LReference, typename RPointer,
+          typename RReference>
+inline bool operator<=(
+    const deque_iterator<T, LPointer, LReference>& lhs,
+    const deque_iterator<T, RPointer, RReference>& rhs) noexcept {
+  return !(rhs < lhs);
+}
+
+template <typename T, typename LPointer, typename LReference, typename RPointer,
+          typename RReference>
+inline bool operator>=(
+    const deque_iterator<T, LPointer, LReference>& lhs,
+    const deque_iterator<T, RPointer, RReference>& rhs) noexcept {
+  return !(lhs < rhs);
+}
+
+template <typename T, typename Pointer, typename Reference>
+inline deque_iterator<T, Pointer, Reference> operator+(
+    std::ptrdiff_t n,
+    const deque_iterator<T, Pointer, Reference>& it) noexcept {
+  return it + n;
+}
+
+template <typename T, typename Alloc>
+class deque_base {
+ private:
+  using this_type = deque_base<T, Alloc>;
+
+  using t_allocator_type = Alloc;
+  using t_allocator_traits = std::allocator_traits<t_allocator_type>;
+  using map_allocator_type =
+      typename t_allocator_traits::template rebind_alloc<T*>;
+  using map_allocator_traits = std::allocator_traits<map_allocator_type>;
+
+ protected:
+  using size_type = std::size_t;
+  using difference_type = std::ptrdiff_t;
+  using value_type = T;
+  using reference = T&;
+  using const_reference = const T&;
+  using pointer = T*;
+  using const_pointer = const T*;
+
+ protected:
+  deque_base()
+      : alloc_(), map_alloc_(), map_(nullptr), map_size_(), start_(), size_() {}
+  deque_base(const this_type& o);
+  deque_base(this_type&& o) noexcept;
+  this_type& operator=(const this_type& o);
+  this_type& operator=(this_type&& o) noexcept;
+  ~deque_base() { clear(); }
+
+  pointer allocate_block() {
+    return t_allocator_traits::allocate(alloc_, block_size_);
+  }
+  void deallocate_block(pointer p) {
+    t_allocator_traits::deallocate(alloc_, p, block_size_);
+  }
+
+  template <class... Args>
+  void construct(pointer p, Args&&... args) {
+    t_allocator_traits::construct(alloc_, p, std::forward<Args>(args)...);
+  }
+  void destroy(pointer p) { t_allocator_traits::destroy(alloc_, p); }
+
+  pointer slot(size_type pos) const noexcept {
+    return map_[pos / block_size_] + pos % block_size_;
+  }
+  void reserve_back();
+  void reserve_front();
+
+  void clear();
+
+ private:
+  void reallocate_map(size_type n, size_type offset);
+
+ protected:
+  static constexpr size_type block_size_ = deque_block_size<T>();
+  static constexpr size_type max_size_ = size_type(0) - 2;
+  static constexpr size_type min_map_size_ = 8;
+
+  t_allocator_type alloc_;
+  map_allocator_type map_alloc_;
+  pointer* map_;
+  size_type map_size_;
+  size_type start_;
+  size_type size_;
+};
+
+template <typename T, typename Alloc>
+deque_base<T, Alloc>::deque_base(const this_type& o) : deque_base() {
+  alloc_ = o.alloc_;
+  map_alloc_ = o.map_alloc_;
+
+  for (size_type i = 0; i < o.size_; ++i) {
+    reserve_back();
+    construct(slot(start_ + size_), *o.slot(o.start_ + i));
+    ++size_;
+  }
+}
+
+template <typename T, typename Alloc>
+deque_base<T, Alloc>::deque_base(this_type&& o) noexcept
+    : alloc_(std::move(o.alloc_)),
+      map_alloc_(std::move(o.map_alloc_)),
+      map_(o.map_),
+      map_size_(o.map_size_),
+      start_(o.start_),
+      size_(o.size_) {
+  o.map_ = nullptr;
+  o.map_size_ = o.start_ = o.size_ = 0;
+}
+
+template <typename T, typename Alloc>
+typename deque_base<T, Alloc>::this_type& deque_base<T, Alloc>::operator=(
+    const this_type& o) {
+  if (&o != this) {
+    this_type res(o);
+    *this = std::move(res);
+  }
+
+  return *this;
+}
+
+template <typename T, typename Alloc>
+typename deque_base<T, Alloc>::this_type& deque_base<T, Alloc>::operator=(
+    this_type&& o) noexcept {
+  if (&o != this) {
+    clear();
+
+    alloc_ = std::move(o.alloc_);
+    map_alloc_ = std::move(o.map_alloc_);
+    map_ = o.map_;
+    map_size_ = o.map_size_;
+    start_ = o.start_;
+    size_ = o.size_;
+
+    o.map_ = nullptr;
+    o.map_size_ = o.start_ = o.size_ = 0;
+  }
+
+  return *this;
+}
+
+// Makes sure the slot right after the last element exists. Blocks freed at
+// the front are rotated to the back first, so a deque used as a FIFO keeps
+// recycling the same blocks instead of growing the map.
+template <typename T, typename Alloc>
+void deque_base<T, Alloc>::reserve_back() {
+  const size_type pos = start_ + size_;
+
+  if (pos == map_size_ * block_size_) {
+    const size_type first = start_ / block_size_;
+
+    if (first > 0) {
+      std::rotate(map_, map_ + first, map_ + map_size_);
+      start_ -= first * block_size_;
+    } else {
+      reallocate_map(std::max(map_size_ * 2, min_map_size_), 0);
+    }
+  }
+
+  pointer& block = map_[(start_ + size_) / block_size_];
+
+  if (!block) {
+    block = allocate_block();
+  }
+}
+
+// Makes sure the slot right before the first element exists.
+template <typename T, typename Alloc>
+void deque_base<T, Alloc>::reserve_front() {
+  if (start_ == 0) {
+    const size_type used = size_ ? (size_ - 1) / block_size_ + 1 : 0;
+
+    if (used < map_size_) {
+      const size_type shift = (map_size_ - used + 1) / 2;
+
+      std::rotate(map_, map_ + map_size_ - shift, map_ + map_size_);
+      start_ += shift * block_size_;
+    } else {
+      const size_type n = std::max(map_size_ * 2, min_map_size_);
+
+      reallocate_map(n, n - map_size_);
+    }
+  }
+
+  pointer& block = map_[(start_ - 1) / block_size_];
+
+  if (!block) {
+    block = allocate_block();
+  }
+}
+
+// Moves the block pointers into a map of n entries, starting at offset.
+template <typename T, typename Alloc>
+void deque_base<T, Alloc>::reallocate_map(size_type n, size_type offset) {
+  pointer* res = map_allocator_traits::allocate(map_alloc_, n);
+
+  std::fill(res, res + n, nullptr);
+  std::copy(map_, map_ + map_size_, res + offset);
+
+  if (map_) {
+    map_allocator_traits::deallocate(map_alloc_, map_, map_size_);
+  }
+
+  map_ = res;
+  map_size_ = n;
+  start_ += offset * block_size_;
+}
+
+template <typename T, typename Alloc>
+void deque_base<T, Alloc>::clear() {
+  for (size_type i = 0; i < size_; ++i) {
+    destroy(slot(start_ + i));
+  }
+
+  for (size_type i = 0; i < map_size_; ++i) {
+    if (map_[i]) {
+      deallocate_block(map_[i]);
+    }
+  }
+
+  if (map_) {
+    map_allocator_traits::deallocate(map_alloc_, map_, map_size_);
+  }
+  map_ = nullptr;
+  map_size_ = start_ = size_ = 0;
+}
+
+}  // namespace details
+
+// Segmented double-ended queue: elements live in fixed-size blocks indexed
+// through a map of block pointers. Push/pop at either end is O(1), never
+// relocates existing elements, and recycles emptied blocks.
+template <typename T, typename Alloc = std::allocator<T>>
+class deque : public details::deque_base<T, Alloc> {
+ private:
+  using base_type = details::deque_base<T, Alloc>;
+  using this_type = deque<T, Alloc>;
+
+  using base_type::block_size_;
+  using base_type::construct;
+  using base_type::destroy;
+  using base_type::map_;
+  using base_type::max_size_;
+  using base_type::reserve_back;
+  using base_type::reserve_front;
+  using base_type::size_;
+  using base_type::slot;
+  using base_type::start_;
+
+ public:
+  using typename base_type::const_pointer;
+  using typename base_type::const_reference;
+  using typename base_type::difference_type;
+  using typename base_type::pointer;
+  using typename base_type::reference;
+  using typename base_type::size_type;
+  using typename base_type::value_type;
+  using iterator = details::deque_iterator<T, T*, T&>;
+  using const_iterator = details::deque_iterator<T, const T*, const T&>;
+
+ public:
+  deque() : base_type() {}
+  deque(const std::initializer_list<value_type>& items);
+  deque(const this_type& o) : base_type(o) {}
+  deque(this_type&& o) noexcept : base_type(std::move(o)) {}
+  this_type& operator=(const this_type& o) {
+    return base_type::operator=(o), *this;
+  }
+  this_type& operator=(this_type&& o) noexcept {
+    return base_type::operator=(std::move(o)), *this;
+  }
+  ~deque() {}
+
+  reference operator[](size_type pos) noexcept { return *slot(start_ + pos); }
+  const_reference operator[](size_type pos) const noexcept {
+    return *slot(start_ + pos);
+  }
+  reference at(size_type pos);
+  const_reference at(size_type pos) const {
+    return const_cast<this_type*>(this)->at(pos);
+  }
+
+  reference front();
+  const_reference front() const {
+    return const_cast<this_type*>(this)->front();
+  }
+  reference back();
+  const_reference back() const { return const_cast<this_type*>(this)->back(); }
+
+  iterator begin() noexcept { return iterator(map_, start_); }
+  const_iterator begin() const noexcept { return const_iterator(map_, start_); }
+  iterator end() noexcept { return iterator(map_, start_ + size_); }
+  const_iterator end() const noexcept {
+    return const_iterator(map_, start_ + size_);
+  }
+
+  bool empty() const noexcept { return size_ == 0; }
+  size_type size() const noexcept { return size_; }
+  constexpr size_type max_size() const noexcept { return max_size_; }
+
+  void clear() noexcept;
+  void push_back(value_type&& val) { emplace_back(std::move(val)); }
+  void push_back(const_reference val) { emplace_back(val); }
+  void pop_back();
+  void push_front(value_type&& val) { emplace_front(std::move(val)); }
+  void push_front(const_reference val) { emplace_front(val); }
+  void pop_front();
+  void swap(this_type& o) noexcept { std::swap(*this, o); }
+
+  template <typename... Args>
+  reference emplace_back(Args&&... args);
+  template <typename... Args>
+  reference emplace_front(Args&&... args);
+  template <typename... Args>
+  void insert_many_back(Args&&... args);
+  template <typename... Args>
+  void insert_many_front(Args&&... args);
+};
+
+template <typename T, typename Alloc>
+deque<T, Alloc>::deque(const std::initializer_list<value_type>& items)
+    : base_type() {
+  std::copy(items.begin(), items.end(), std::back_inserter(*this));
+}
+
+template <typename T, typename Alloc>
+typename deque<T, Alloc>::reference deque<T, Alloc>::at(size_type pos) {
+  if (pos >= size_) {
+    throw std::out_of_range("s21::deque::at(). invalid pos.");
+  }
+
+  return *slot(start_ + pos);
+}
+
+template <typename T, typename Alloc>
+typename deque<T, Alloc>::reference deque<T, Alloc>::front() {
+#ifdef DEBUG
+  if (empty()) {
+    throw std::out_of_range("s21::deque::front(). deque is empty.");
+  }
+#endif
+
+  return *slot(start_);
+}
+
+template <typename T, typename Alloc>
+typename deque<T, Alloc>::reference deque<T, Alloc>::back() {
+#ifdef DEBUG
+  if (empty()) {
+    throw std::out_of_range("s21::deque::back(). deque is empty.");
+  }
+#endif
+
+  return *slot(start_ + size_ - 1);
+}
+
+template <typename T, typename Alloc>
+void deque<T, Alloc>::clear() noexcept {
+  for (size_type i = 0; i < size_; ++i) {
+    destroy(slot(start_ + i));
+  }
+  size_ = 0;
+}
+
+template <typename T, typename Alloc>
+void deque<T, Alloc>::pop_back() {
+#ifdef DEBUG
+  if (empty()) {
+    throw std::out_of_range("s21::deque::pop_back(). deque is empty.");
+  }
+#endif
+
+  destroy(slot(start_ + --size_));
+}
+
+template <typename T, typename Alloc>
+void deque<T, Alloc>::pop_front() {
+#ifdef DEBUG
+  if (empty()) {
+    throw std::out_of_range("s21::deque::pop_front(). deque is empty.");
+  }
+#endif
+
+  destroy(slot(start_++));
+  --size_;
+}
+
+template <typename T, typename Alloc>
+template <typename... Args>
+typename deque<T, Alloc>::reference deque<T, Alloc>::emplace_back(
+    Args&&... args) {
+#ifdef DEBUG
+  if (size_ == max_size()) {
+    throw std::invalid_argument("s21::deque::emplace_back(). size too big.");
+  }
+#endif
+
+  reserve_back();
+
+  pointer p = slot(start_ + size_);
+  construct(p, std::forward<Args>(args)...);
+  ++size_;
+
+  return *p;
+}
+
+template <typename T, typename Alloc>
+template <typename... Args>
+typename deque<T, Alloc>::reference deque<T, Alloc>::emplace_front(
+    Args&&... args) {
+#ifdef DEBUG
+  if (size_ == max_size()) {
+    throw std::invalid_argument("s21::deque::emplace_front(). size too big.");
+  }
+#endif
+
+  reserve_front();
+
+  pointer p = slot(start_ - 1);
+  construct(p, std::forward<Args>(args)...);
+  --start_;
+  ++size_;
+
+  return *p;
+}
+
+template <typename T, typename Alloc>
+template <typename... Args>
+void deque<T, Alloc>::insert_many_back(Args&&... args) {
+  (..., emplace_back(std::forward<Args>(args)));
+}
+
+template <typename T, typename Alloc>
+template <typename... Args>
+void deque<T, Alloc>::insert_many_front(Args&&... args) {
+  (..., emplace_front(std::forward<Args>(args)));
+  std::reverse(begin(), begin() + sizeof...(Args));
+}
+
+}  // namespace s21
+
+#endif  // S21_DEQUE_H_
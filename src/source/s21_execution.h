@@ -0,0 +1,555 @@
+#ifndef S21_EXECUTION_H_
+#define S21_EXECUTION_H_
+
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <functional>
+#include <iterator>
+#include <numeric>
+#include <optional>
+#include <type_traits>
+#include <utility>
+
+#include "../rb_tree/s21_rb_tree.h"
+#include "s21_radix_sort.h"
+#include "s21_thread_pool.h"
+#include "s21_vector.h"
+
+namespace s21 {
+
+// Selects the parallel overloads of the algorithms below, like
+// std::execution::par. They take a whole container: s21::vector, s21::array
+// and anything else with random-access iterators is cut into index ranges;
+// s21::map, s21::set and s21::multiset are cut along subtrees of their
+// red-black tree. The pieces run on s21::thread_pool::instance(). Other
+// containers run sequentially. Callables are invoked
+// concurrently from several threads and must not race with each other.
+class parallel_policy {};
+
+inline constexpr parallel_policy par{};
+
+namespace details {
+
+// Fewer elements than this are not worth a task of their own.
+static constexpr std::size_t parallel_grain_ = 4096;
+
+template <typename Iterator>
+using chunk_list = s21::vector<std::pair<Iterator, Iterator>>;
+
+// A few pieces per thread so that stealing can even out uneven pieces.
+inline std::size_t parallel_parts(std::size_t n) {
+  const std::size_t threads = thread_pool::instance().concurrency();
+
+  return std::max<std::size_t>(1, std::min(threads * 4, n / parallel_grain_));
+}
+
+template <typename Iterator>
+chunk_list<Iterator> split(Iterator first, Iterator, std::size_t n,
+                           std::random_access_iterator_tag) {
+  const std::size_t parts = parallel_parts(n);
+  chunk_list<Iterator> res;
+
+  res.reserve(parts);
+  for (std::size_t i = 0; i < parts; ++i) {
+    res.push_back({first + n * i / parts, first + n * (i + 1) / parts});
+  }
+
+  return res;
+}
+
+template <typename Iterator>
+chunk_list<Iterator> split(Iterator first, Iterator last, std::size_t,
+                           std::input_iterator_tag) {
+  return chunk_list<Iterator>{{first, last}};
+}
+
+template <typename Iterator>
+chunk_list<Iterator> split(Iterator first, Iterator last, std::size_t n) {
+  return split(first, last, n,
+               typename std::iterator_traits<Iterator>::iterator_category());
+}
+
+inline void tree_cuts(rb_tree_node_base* node, std::size_t depth,
+                      s21::vector<rb_tree_node_base*>& cuts) {
+  if (!node) {
+    return;
+  }
+
+  if (depth == 0) {
+    cuts.push_back(node->leftmost());
+    return;
+  }
+
+  tree_cuts(node->left_, depth - 1, cuts);
+  tree_cuts(node->right_, depth - 1, cuts);
+}
+
+// [first, last) must be a whole tree. It is cut in front of the leftmost
+// node of every subtree rooted depth levels below the root; nodes above
+// that level go with the piece to their left. The tree is balanced, so the
+// pieces are of similar size, and finding the cuts costs O(parts * height).
+template <typename T, typename Pointer, typename Reference>
+chunk_list<rb_tree_iterator<T, Pointer, Reference>> split(
+    rb_tree_iterator<T, Pointer, Reference> first,
+    rb_tree_iterator<T, Pointer, Reference> last, std::size_t n) {
+  using iterator = rb_tree_iterator<T, Pointer, Reference>;
+
+  const std::size_t parts = parallel_parts(n);
+  std::size_t depth = 0;
+  s21::vector<rb_tree_node_base*> cuts;
+  chunk_list<iterator> res;
+
+  while ((std::size_t(1) << depth) < parts) {
+    ++depth;
+  }
+  tree_cuts(last.node_base_->parent_, depth, cuts);
+
+  res.reserve(cuts.size());
+  for (std::size_t i = 0; i < cuts.size(); ++i) {
+    res.push_back({i == 0 ? first : iterator(cuts[i]),
+                   i + 1 < cuts.size() ? iterator(cuts[i + 1]) : last});
+  }
+
+  return res;
+}
+
+// Calls f(index, first, last) for every piece, in parallel.
+template <typename Iterator, typename F>
+void run_chunks(const chunk_list<Iterator>& chunks, F&& f) {
+  if (chunks.size() == 1) {
+    f(std::size_t(0), chunks[0].first, chunks[0].second);
+    return;
+  }
+
+  wait_group group;
+
+  for (std::size_t i = 0; i < chunks.size(); ++i) {
+    group.run([&f, &chunks, i] { f(i, chunks[i].first, chunks[i].second); });
+  }
+  group.wait();
+}
+
+// offsets[i] is the position of piece i in the whole range, offsets.back()
+// its length.
+template <typename Iterator>
+s21::vector<std::size_t> chunk_offsets(const chunk_list<Iterator>& chunks) {
+  s21::vector<std::size_t> res(chunks.size() + 1, 0);
+
+  run_chunks(chunks, [&res](std::size_t i, Iterator first, Iterator last) {
+    res[i + 1] = std::distance(first, last);
+  });
+  for (std::size_t i = 0; i < chunks.size(); ++i) {
+    res[i + 1] += res[i];
+  }
+
+  return res;
+}
+
+template <typename Container>
+auto chunks_of(Container& c) {
+  return split(c.begin(), c.end(), c.size());
+}
+
+}  // namespace details
+
+template <typename Container, typename UnaryFunction>
+void for_each(parallel_policy, Container& c, UnaryFunction f) {
+  details::run_chunks(details::chunks_of(c),
+                      [&f](std::size_t, auto first, auto last) {
+                        std::for_each(first, last, f);
+                      });
+}
+
+// out must be a random-access iterator; returns the end of the output.
+template <typename Container, typename OutputIt, typename UnaryOperation>
+OutputIt transform(parallel_policy, Container& c, OutputIt out,
+                   UnaryOperation op) {
+  const auto chunks = details::chunks_of(c);
+  const s21::vector<std::size_t> offsets = details::chunk_offsets(chunks);
+
+  details::run_chunks(chunks, [&](std::size_t i, auto first, auto last) {
+    std::transform(first, last, out + offsets[i], op);
+  });
+
+  return out + offsets.back();
+}
+
+// out must be a random-access iterator; returns the end of the output.
+template <typename Container, typename OutputIt>
+OutputIt copy(parallel_policy, const Container& c, OutputIt out) {
+  const auto chunks = details::chunks_of(c);
+  const s21::vector<std::size_t> offsets = details::chunk_offsets(chunks);
+
+  details::run_chunks(chunks, [&](std::size_t i, auto first, auto last) {
+    std::copy(first, last, out + offsets[i]);
+  });
+
+  return out + offsets.back();
+}
+
+// op must be associative and the elements convertible to T; pieces are
+// combined left to right, so op need not be commutative.
+template <typename Container, typename T,
+          typename BinaryOperation = std::plus<>>
+T reduce(parallel_policy, const Container& c, T init,
+         BinaryOperation op = BinaryOperation()) {
+  if (c.empty()) {
+    return init;
+  }
+
+  const auto chunks = details::chunks_of(c);
+  s21::vector<std::optional<T>> partial(chunks.size(), std::nullopt);
+
+  details::run_chunks(chunks, [&](std::size_t i, auto first, auto last) {
+    partial[i].emplace(std::accumulate(std::next(first), last, T(*first), op));
+  });
+
+  for (const auto& val : partial) {
+    init = op(std::move(init), *val);
+  }
+
+  return init;
+}
+
+template <typename Container, typename UnaryPredicate>
+auto count_if(parallel_policy, const Container& c, UnaryPredicate pred) {
+  using difference_type = typename std::iterator_traits<
+      decltype(c.begin())>::difference_type;
+
+  const auto chunks = details::chunks_of(c);
+  s21::vector<difference_type> counts(chunks.size(), 0);
+
+  details::run_chunks(chunks, [&](std::size_t i, auto first, auto last) {
+    counts[i] = std::count_if(first, last, pred);
+  });
+
+  return std::accumulate(counts.begin(), counts.end(), difference_type(0));
+}
+
+// Returns the first match in container order. Pieces past the leftmost
+// piece with a match give up early.
+template <typename Container, typename UnaryPredicate>
+auto find_if(parallel_policy, Container& c, UnaryPredicate pred) {
+  using iterator = decltype(c.begin());
+
+  const auto chunks = details::chunks_of(c);
+  std::atomic<std::size_t> best(chunks.size());
+  s21::vector<iterator> found(chunks.size(), c.end());
+
+  // Lowers best to i unless a piece further left already found something.
+  auto claim = [&best](std::size_t i) {
+    std::size_t cur = best.load();
+
+    while (cur > i && !best.compare_exchange_weak(cur, i)) {
+    }
+  };
+
+  details::run_chunks(chunks, [&](std::size_t i, iterator first,
+                                  iterator last) {
+    for (; first != last && best.load(std::memory_order_relaxed) > i;
+         ++first) {
+      if (pred(*first)) {
+        found[i] = first;
+        claim(i);
+        return;
+      }
+    }
+  });
+
+  const std::size_t res = best.load();
+
+  return res < chunks.size() ? found[res] : c.end();
+}
+
+namespace details {
+
+// Parallel form of the radix sort in s21_radix_sort.h. The first read
+// counts every byte of every key per piece; each pass that is not skipped
+// counts its byte per piece again, since the pieces hold other elements by
+// then, turns the counts into output positions per piece and digit, and
+// scatters the pieces in parallel. Stable.
+template <typename T>
+void radix_sort(T* data, T* scratch, const chunk_list<T*>& chunks) {
+  constexpr std::size_t passes = sizeof(T);
+  constexpr std::size_t mask = radix_buckets_ - 1;
+
+  const std::size_t parts = chunks.size();
+  const std::size_t n = chunks[parts - 1].second - data;
+
+  if (parts == 1) {
+    radix_sort(data, scratch, n, [](T val) { return val; });
+    return;
+  }
+
+  s21::vector<std::size_t> totals(parts * passes * radix_buckets_, 0);
+  s21::vector<std::size_t> counts(parts * radix_buckets_, 0);
+  T* src = data;
+  T* dst = scratch;
+
+  run_chunks(chunks, [&](std::size_t i, T* first, T* last) {
+    std::size_t* count = totals.data() + i * passes * radix_buckets_;
+
+    for (; first != last; ++first) {
+      const auto key = radix_key(*first);
+
+      for (std::size_t pass = 0; pass < passes; ++pass) {
+        ++count[pass * radix_buckets_ + (std::size_t(key >> pass * 8) & mask)];
+      }
+    }
+  });
+  for (std::size_t i = 1; i < parts; ++i) {
+    for (std::size_t j = 0; j < passes * radix_buckets_; ++j) {
+      totals[j] += totals[i * passes * radix_buckets_ + j];
+    }
+  }
+
+  for (std::size_t pass = 0; pass < passes; ++pass) {
+    const std::size_t* total = totals.data() + pass * radix_buckets_;
+    auto digit = [pass](T val) {
+      return std::size_t(radix_key(val) >> pass * 8) & mask;
+    };
+
+    if (std::find(total, total + radix_buckets_, n) != total + radix_buckets_) {
+      continue;
+    }
+
+    run_chunks(chunks, [&](std::size_t i, T* first, T* last) {
+      std::size_t* count = counts.data() + i * radix_buckets_;
+
+      std::fill(count, count + radix_buckets_, 0);
+      for (T* j = src + (first - data); j != src + (last - data); ++j) {
+        ++count[digit(*j)];
+      }
+    });
+
+    for (std::size_t d = 0, pos = 0; d < radix_buckets_; ++d) {
+      for (std::size_t i = 0; i < parts; ++i) {
+        const std::size_t count = counts[i * radix_buckets_ + d];
+
+        counts[i * radix_buckets_ + d] = pos;
+        pos += count;
+      }
+    }
+
+    run_chunks(chunks, [&](std::size_t i, T* first, T* last) {
+      std::size_t* next = counts.data() + i * radix_buckets_;
+
+      for (T* j = src + (first - data); j != src + (last - data); ++j) {
+        dst[next[digit(*j)]++] = *j;
+      }
+    });
+    std::swap(src, dst);
+  }
+
+  if (src != data) {
+    run_chunks(chunks, [&](std::size_t, T* first, T* last) {
+      std::copy(src + (first - data), src + (last - data), first);
+    });
+  }
+}
+
+// Moves the sorted runs [a, a + na) and [b, b + nb) into out in order, ties
+// taking the element from a first. A long merge is cut at the middle of the
+// longer run and the matching point of the other one; the right part goes
+// to group as a task of its own.
+template <typename T, typename Compare>
+void parallel_merge(T* a, std::size_t na, T* b, std::size_t nb, T* out,
+                    Compare& comp, wait_group& group) {
+  const bool parallel = thread_pool::instance().concurrency() > 1;
+
+  while (parallel && na + nb > parallel_grain_ * 2) {
+    std::size_t ma = na / 2;
+    std::size_t mb = nb / 2;
+
+    if (na >= nb) {
+      mb = std::lower_bound(b, b + nb, a[ma], comp) - b;
+    } else {
+      ma = std::upper_bound(a, a + na, b[mb], comp) - a;
+    }
+
+    group.run([=, &comp, &group] {
+      parallel_merge(a + ma, na - ma, b + mb, nb - mb, out + ma + mb, comp,
+                     group);
+    });
+    na = ma;
+    nb = mb;
+  }
+
+  std::merge(std::make_move_iterator(a), std::make_move_iterator(a + na),
+             std::make_move_iterator(b), std::make_move_iterator(b + nb), out,
+             comp);
+}
+
+// Sorts the pieces in parallel, then merges neighbouring runs pairwise
+// between data and scratch until one run is left, every merge itself split
+// across the pool.
+template <typename T, typename Compare>
+void merge_sort(T* data, T* scratch, const chunk_list<T*>& chunks,
+                Compare& comp, bool stable) {
+  const std::size_t n = chunks[chunks.size() - 1].second - data;
+  s21::vector<std::size_t> bounds;
+  T* src = data;
+  T* dst = scratch;
+
+  run_chunks(chunks, [&](std::size_t, T* first, T* last) {
+    if (stable) {
+      std::stable_sort(first, last, comp);
+    } else {
+      std::sort(first, last, comp);
+    }
+  });
+
+  bounds.reserve(chunks.size() + 1);
+  for (const auto& chunk : chunks) {
+    bounds.push_back(chunk.first - data);
+  }
+  bounds.push_back(n);
+
+  // bounds holds the starts of the runs followed by n.
+  while (bounds.size() > 2) {
+    s21::vector<std::size_t> merged;
+    wait_group group;
+
+    for (std::size_t i = 0; i + 1 < bounds.size(); i += 2) {
+      const std::size_t lo = bounds[i];
+      const std::size_t mid = bounds[i + 1];
+      const std::size_t hi = i + 2 < bounds.size() ? bounds[i + 2] : mid;
+
+      merged.push_back(lo);
+      group.run([=, &comp, &group] {
+        parallel_merge(src + lo, mid - lo, src + mid, hi - mid, dst + lo, comp,
+                       group);
+      });
+    }
+    merged.push_back(n);
+    group.wait();
+
+    bounds = std::move(merged);
+    std::swap(src, dst);
+  }
+
+  if (src != data) {
+    run_chunks(chunks, [&](std::size_t, T* first, T* last) {
+      std::move(src + (first - data), src + (last - data), first);
+    });
+  }
+}
+
+template <typename Container, typename Compare>
+void sort(Container& c, Compare& comp,
+          s21::vector<typename Container::value_type>& scratch, bool stable) {
+  using value_type = typename Container::value_type;
+
+  if (c.size() < 2) {
+    return;
+  }
+  if (scratch.size() < c.size()) {
+    scratch = s21::vector<value_type>(c.size());
+  }
+
+  const auto chunks = split(c.data(), c.data() + c.size(), c.size());
+
+  if constexpr (is_radix_order_v<value_type, Compare>) {
+    if (c.size() > parallel_grain_ &&
+        (!stable || std::is_integral_v<value_type>)) {
+      radix_sort(c.data(), scratch.data(), chunks);
+      return;
+    }
+  }
+
+  merge_sort(c.data(), scratch.data(), chunks, comp, stable);
+}
+
+}  // namespace details
+
+// Parallel merge sort of a container with contiguous storage (s21::vector,
+// s21::array) through a scratch buffer as long as c. Integers and floats
+// compared with std::less take a parallel radix sort instead. Elements must
+// be default constructible. Should comp throw, c is left valid but its
+// contents are unspecified: some elements may be moved-from.
+template <typename Container, typename Compare = std::less<>>
+void sort(parallel_policy, Container& c, Compare comp = Compare()) {
+  s21::vector<typename Container::value_type> scratch;
+
+  details::sort(c, comp, scratch, false);
+}
+
+// As above, but reuses scratch and only grows it when it is shorter than c,
+// so that repeated sorts allocate once.
+template <typename Container, typename Compare>
+void sort(parallel_policy, Container& c, Compare comp,
+          s21::vector<typename Container::value_type>& scratch) {
+  details::sort(c, comp, scratch, false);
+}
+
+// Equal elements keep their order.
+template <typename Container, typename Compare = std::less<>>
+void stable_sort(parallel_policy, Container& c, Compare comp = Compare()) {
+  s21::vector<typename Container::value_type> scratch;
+
+  details::sort(c, comp, scratch, true);
+}
+
+template <typename Container, typename Compare>
+void stable_sort(parallel_policy, Container& c, Compare comp,
+                 s21::vector<typename Container::value_type>& scratch) {
+  details::sort(c, comp, scratch, true);
+}
+
+// Ascending LSD radix sort of integers or IEEE floats in contiguous storage,
+// in O(n) per key byte. Stable; -0.0 sorts before 0.0 and NaNs go to the
+// front or the back by their sign bit. scratch is reused as in sort() above.
+template <typename Container>
+void radix_sort(Container& c,
+                s21::vector<typename Container::value_type>& scratch) {
+  using value_type = typename Container::value_type;
+  static_assert(details::is_radix_sortable_v<value_type>,
+                "s21::radix_sort() needs integer or IEEE float elements");
+
+  if (c.size() < 2) {
+    return;
+  }
+  if (scratch.size() < c.size()) {
+    scratch = s21::vector<value_type>(c.size());
+  }
+  details::radix_sort(c.data(), scratch.data(), c.size(),
+                      [](value_type val) { return val; });
+}
+
+template <typename Container>
+void radix_sort(Container& c) {
+  s21::vector<typename Container::value_type> scratch;
+
+  radix_sort(c, scratch);
+}
+
+template <typename Container>
+void radix_sort(parallel_policy, Container& c,
+                s21::vector<typename Container::value_type>& scratch) {
+  using value_type = typename Container::value_type;
+  static_assert(details::is_radix_sortable_v<value_type>,
+                "s21::radix_sort() needs integer or IEEE float elements");
+
+  if (c.size() < 2) {
+    return;
+  }
+  if (scratch.size() < c.size()) {
+    scratch = s21::vector<value_type>(c.size());
+  }
+  details::radix_sort(c.data(), scratch.data(),
+                      details::split(c.data(), c.data() + c.size(), c.size()));
+}
+
+template <typename Container>
+void radix_sort(parallel_policy, Container& c) {
+  s21::vector<typename Container::value_type> scratch;
+
+  radix_sort(par, c, scratch);
+}
+
+}  // namespace s21
+
+#endif  // S21_EXECUTION_H_
@@ -0,0 +1,322 @@
+#ifndef S21_FROZEN_MAP_H_
+#define S21_FROZEN_MAP_H_
+
+#pragma once
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <functional>
+#include <iterator>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+#include <utility>
+
+#include "s21_frozen_map_writer.h"
+
+namespace s21 {
+
+// Read-only map served straight from a file written by map::write_frozen().
+// The file is mapped into memory and used in place: opening it costs a few
+// system calls whatever its size, pages are read on first touch and shared
+// between processes that map the same file. The file holds offsets, not
+// pointers or padding, so Key and T must be arithmetic or enum types (not
+// bool) and Compare must order keys the way the writing map did. find(),
+// lower_bound() and upper_bound() search only the key array; iteration is
+// in key order.
+template <typename Key, typename T, typename Compare = std::less<Key>>
+class frozen_map_view {
+  static_assert(details::is_plain_bytes_v<Key> &&
+                    details::is_plain_bytes_v<T>,
+                "s21::frozen_map_view. keys and values must be arithmetic "
+                "or enum types");
+
+ private:
+  using this_type = frozen_map_view<Key, T, Compare>;
+
+ public:
+  using key_type = Key;
+  using mapped_type = T;
+  using value_type = std::pair<const Key&, const T&>;
+  using size_type = std::size_t;
+  using difference_type = std::ptrdiff_t;
+  using key_compare = Compare;
+
+  class const_iterator {
+   public:
+    using iterator_category = std::forward_iterator_tag;
+    using value_type = frozen_map_view::value_type;
+    using difference_type = std::ptrdiff_t;
+    using reference = value_type;
+
+    // it->first works although the pair is made on the fly.
+    struct pointer {
+      value_type pair_;
+      const value_type* operator->() const noexcept { return &pair_; }
+    };
+
+   public:
+    const_iterator() noexcept : view_(nullptr), pos_(0) {}
+
+    reference operator*() const noexcept {
+      return value_type(view_->keys_[pos_], view_->values_[pos_]);
+    }
+    pointer operator->() const noexcept { return pointer{**this}; }
+
+    const_iterator& operator++() noexcept {
+      pos_ = details::frozen_next(pos_, view_->size_, view_->layout_);
+      return *this;
+    }
+    const_iterator operator++(int) noexcept {
+      const_iterator res(*this);
+      ++*this;
+      return res;
+    }
+
+    bool operator==(const const_iterator& o) const noexcept {
+      return pos_ == o.pos_;
+    }
+    bool operator!=(const const_iterator& o) const noexcept {
+      return pos_ != o.pos_;
+    }
+
+   private:
+    friend class frozen_map_view;
+
+    const_iterator(const this_type* view, size_type pos) noexcept
+        : view_(view), pos_(pos) {}
+
+   private:
+    const this_type* view_;
+    size_type pos_;
+  };
+
+  using iterator = const_iterator;
+
+ public:
+  explicit frozen_map_view(const std::string& path);
+  frozen_map_view(const this_type&) = delete;
+  frozen_map_view(this_type&& o) noexcept;
+  this_type& operator=(const this_type&) = delete;
+  this_type& operator=(this_type&& o) noexcept;
+  ~frozen_map_view() { unmap(); }
+
+  const_iterator begin() const noexcept {
+    return const_iterator(this, details::frozen_first(size_, layout_));
+  }
+  const_iterator end() const noexcept { return const_iterator(this, 0); }
+
+  bool empty() const noexcept { return size_ == 0; }
+  size_type size() const noexcept { return size_; }
+  frozen_layout layout() const noexcept { return layout_; }
+
+  const mapped_type& at(const key_type& key) const;
+  const_iterator find(const key_type& key) const noexcept;
+  bool contains(const key_type& key) const noexcept {
+    return find(key) != end();
+  }
+  size_type count(const key_type& key) const noexcept {
+    return contains(key) ? 1 : 0;
+  }
+  const_iterator lower_bound(const key_type& key) const noexcept {
+    return const_iterator(this, bound(key, [](const Key& lhs, const Key& rhs) {
+                            return Compare()(lhs, rhs);
+                          }));
+  }
+  const_iterator upper_bound(const key_type& key) const noexcept {
+    return const_iterator(this, bound(key, [](const Key& lhs, const Key& rhs) {
+                            return !Compare()(rhs, lhs);
+                          }));
+  }
+
+ private:
+  // Position of the first key k with !before(k, key), or 0.
+  template <typename Before>
+  size_type bound(const key_type& key, Before before) const noexcept;
+  void unmap() noexcept;
+
+ private:
+  void* data_;
+  size_type bytes_;
+  const Key* keys_;
+  const T* values_;
+  size_type size_;
+  frozen_layout layout_;
+};
+
+template <typename Key, typename T, typename Compare>
+frozen_map_view<Key, T, Compare>::frozen_map_view(const std::string& path)
+    : data_(nullptr),
+      bytes_(0),
+      keys_(nullptr),
+      values_(nullptr),
+      size_(0),
+      layout_(frozen_layout::sorted) {
+  const int fd = ::open(path.c_str(), O_RDONLY);
+
+  if (fd < 0) {
+    throw std::runtime_error("s21::frozen_map_view(). cannot open file.");
+  }
+
+  struct stat info {};
+  void* data = MAP_FAILED;
+
+  if (::fstat(fd, &info) == 0 &&
+      std::size_t(info.st_size) >= sizeof(details::frozen_map_header)) {
+    data = ::mmap(nullptr, std::size_t(info.st_size), PROT_READ, MAP_SHARED,
+                  fd, 0);
+  }
+  ::close(fd);
+  if (data == MAP_FAILED) {
+    throw std::runtime_error("s21::frozen_map_view(). cannot map file.");
+  }
+
+  data_ = data;
+  bytes_ = std::size_t(info.st_size);
+
+  details::frozen_map_header header;
+  std::memcpy(&header, data_, sizeof(header));
+
+  const char* error = nullptr;
+  if (header.magic_ != details::frozen_magic_ ||
+      header.version_ != details::frozen_version_ ||
+      header.layout_ > std::uint8_t(frozen_layout::eytzinger)) {
+    error = "s21::frozen_map_view(). not a frozen map file.";
+  } else if (header.key_size_ != sizeof(Key) ||
+             header.value_size_ != sizeof(T)) {
+    error = "s21::frozen_map_view(). wrong key or value type.";
+  } else if (header.keys_offset_ % details::frozen_align_ != 0 ||
+             header.values_offset_ % details::frozen_align_ != 0 ||
+             header.keys_offset_ < sizeof(header) ||
+             header.values_offset_ < header.keys_offset_ ||
+             header.values_offset_ > bytes_ || header.size_ >= bytes_ ||
+             header.size_ + 1 >
+                 (header.values_offset_ - header.keys_offset_) / sizeof(Key) ||
+             header.size_ + 1 > (bytes_ - header.values_offset_) / sizeof(T)) {
+    // Offsets are bounded by bytes_ before any arithmetic, and array sizes
+    // are compared by division, so a crafted header cannot wrap around.
+    error = "s21::frozen_map_view(). file is truncated.";
+  }
+  if (error) {
+    unmap();
+    throw std::runtime_error(error);
+  }
+
+  const char* bytes = static_cast<const char*>(data_);
+  keys_ = reinterpret_cast<const Key*>(bytes + header.keys_offset_);
+  values_ = reinterpret_cast<const T*>(bytes + header.values_offset_);
+  size_ = std::size_t(header.size_);
+  layout_ = frozen_layout(header.layout_);
+}
+
+template <typename Key, typename T, typename Compare>
+frozen_map_view<Key, T, Compare>::frozen_map_view(this_type&& o) noexcept
+    : data_(o.data_),
+      bytes_(o.bytes_),
+      keys_(o.keys_),
+      values_(o.values_),
+      size_(o.size_),
+      layout_(o.layout_) {
+  o.data_ = nullptr;
+  o.bytes_ = o.size_ = 0;
+}
+
+template <typename Key, typename T, typename Compare>
+typename frozen_map_view<Key, T, Compare>::this_type&
+frozen_map_view<Key, T, Compare>::operator=(this_type&& o) noexcept {
+  if (&o != this) {
+    unmap();
+    data_ = o.data_;
+    bytes_ = o.bytes_;
+    keys_ = o.keys_;
+    values_ = o.values_;
+    size_ = o.size_;
+    layout_ = o.layout_;
+
+    o.data_ = nullptr;
+    o.bytes_ = o.size_ = 0;
+  }
+
+  return *this;
+}
+
+template <typename Key, typename T, typename Compare>
+const typename frozen_map_view<Key, T, Compare>::mapped_type&
+frozen_map_view<Key, T, Compare>::at(const key_type& key) const {
+  if (auto it = find(key); it != end()) {
+    return it->second;
+  } else {
+    throw std::out_of_range("s21::frozen_map_view::at(). invalid key.");
+  }
+}
+
+template <typename Key, typename T, typename Compare>
+typename frozen_map_view<Key, T, Compare>::const_iterator
+frozen_map_view<Key, T, Compare>::find(const key_type& key) const noexcept {
+  const_iterator it = lower_bound(key);
+
+  return it != end() && !Compare()(key, it->first) ? it : end();
+}
+
+template <typename Key, typename T, typename Compare>
+template <typename Before>
+typename frozen_map_view<Key, T, Compare>::size_type
+frozen_map_view<Key, T, Compare>::bound(const key_type& key,
+                                        Before before) const noexcept {
+  if (layout_ == frozen_layout::sorted) {
+    const Key* first = keys_ + 1;
+    size_type count = size_;
+
+    while (count > 0) {
+      const size_type half = count / 2;
+
+      if (before(first[half], key)) {
+        first += half + 1;
+        count -= half + 1;
+      } else {
+        count = half;
+      }
+    }
+
+    return first == keys_ + 1 + size_ ? 0 : size_type(first - keys_);
+  }
+
+  // Down the implicit tree: right while the key is before the one sought.
+  // The answer is the last node left from, found by dropping the trailing
+  // right turns and one left turn.
+  size_type pos = 1;
+
+  while (pos <= size_) {
+#if defined(__GNUC__) || defined(__clang__)
+    // keys_[16 * pos] is the first node four levels down; the pointer is
+    // only formed while it is still inside the key array.
+    if (16 * pos <= size_) {
+      __builtin_prefetch(keys_ + 16 * pos);
+    }
+#endif
+    pos = 2 * pos + (before(keys_[pos], key) ? 1 : 0);
+  }
+  while (pos & 1) {
+    pos >>= 1;
+  }
+
+  return pos >> 1;
+}
+
+template <typename Key, typename T, typename Compare>
+void frozen_map_view<Key, T, Compare>::unmap() noexcept {
+  if (data_) {
+    ::munmap(data_, bytes_);
+    data_ = nullptr;
+  }
+}
+
+}  // namespace s21
+
+#endif  // S21_FROZEN_MAP_H_
@@ -0,0 +1,149 @@
+#ifndef S21_FROZEN_MAP_WRITER_H_
+#define S21_FROZEN_MAP_WRITER_H_
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <fstream>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+
+#include "s21_plain_bytes.h"
+#include "s21_vector.h"
+
+namespace s21 {
+
+// Order of the keys in a frozen map file. sorted is plain binary search.
+// eytzinger stores the implicit search tree breadth first, so the top
+// levels of every lookup share a few cache lines and the next ones can be
+// fetched ahead.
+enum class frozen_layout : std::uint8_t { sorted, eytzinger };
+
+namespace details {
+
+// File layout, in host byte order: this header, then the keys and the
+// values as two arrays starting on 64-byte boundaries. Both arrays have
+// size_ + 1 entries indexed from 1 so that 0 can mean "none"; entry i of
+// the values belongs to entry i of the keys.
+struct frozen_map_header {
+  std::uint32_t magic_;
+  std::uint16_t version_;
+  std::uint8_t layout_;
+  std::uint8_t reserved_;
+  std::uint32_t key_size_;
+  std::uint32_t value_size_;
+  std::uint64_t size_;
+  std::uint64_t keys_offset_;
+  std::uint64_t values_offset_;
+};
+
+static_assert(sizeof(frozen_map_header) == 40);
+
+inline constexpr std::uint32_t frozen_magic_ = 0x46313253;
+inline constexpr std::uint16_t frozen_version_ = 1;
+inline constexpr std::size_t frozen_align_ = 64;
+
+inline constexpr std::uint64_t frozen_round_up(std::uint64_t n) noexcept {
+  return (n + frozen_align_ - 1) / frozen_align_ * frozen_align_;
+}
+
+// Position of the smallest key, or 0 when there is none.
+inline std::size_t frozen_first(std::size_t n, frozen_layout layout) noexcept {
+  if (n == 0) {
+    return 0;
+  }
+
+  std::size_t pos = 1;
+
+  if (layout == frozen_layout::eytzinger) {
+    while (2 * pos <= n) {
+      pos *= 2;
+    }
+  }
+
+  return pos;
+}
+
+// In-order successor of pos, or 0 after the largest key.
+inline std::size_t frozen_next(std::size_t pos, std::size_t n,
+                               frozen_layout layout) noexcept {
+  if (layout == frozen_layout::sorted) {
+    return pos < n ? pos + 1 : 0;
+  }
+
+  if (2 * pos + 1 <= n) {
+    // Leftmost node of the right subtree.
+    for (pos = 2 * pos + 1; 2 * pos <= n;) {
+      pos *= 2;
+    }
+    return pos;
+  }
+
+  // Up past every ancestor reached from its right child, then one more.
+  while (pos & 1) {
+    pos >>= 1;
+  }
+  return pos >> 1;
+}
+
+template <typename Key, typename T>
+frozen_map_header make_frozen_header(std::size_t n, frozen_layout layout) {
+  frozen_map_header header{};
+
+  header.magic_ = frozen_magic_;
+  header.version_ = frozen_version_;
+  header.layout_ = std::uint8_t(layout);
+  header.key_size_ = sizeof(Key);
+  header.value_size_ = sizeof(T);
+  header.size_ = n;
+  header.keys_offset_ = frozen_round_up(sizeof(frozen_map_header));
+  header.values_offset_ =
+      frozen_round_up(header.keys_offset_ + (n + 1) * sizeof(Key));
+
+  return header;
+}
+
+// Writes the n pairs starting at first, sorted by key, as a frozen map file.
+template <typename Key, typename T, typename InputIt>
+void write_frozen_map(const std::string& path, InputIt first, std::size_t n,
+                      frozen_layout layout) {
+  static_assert(is_plain_bytes_v<Key> && is_plain_bytes_v<T>,
+                "s21::map::write_frozen(). keys and values must be "
+                "arithmetic or enum types");
+  static_assert(alignof(Key) <= frozen_align_ && alignof(T) <= frozen_align_,
+                "s21::map::write_frozen(). alignment too big");
+
+  const frozen_map_header header = make_frozen_header<Key, T>(n, layout);
+  vector<Key> keys(n + 1);
+  vector<T> values(n + 1);
+
+  for (std::size_t pos = frozen_first(n, layout); pos != 0;
+       pos = frozen_next(pos, n, layout), ++first) {
+    keys[pos] = first->first;
+    values[pos] = first->second;
+  }
+
+  const char padding[frozen_align_] = {};
+  std::ofstream out(path, std::ios::binary | std::ios::trunc);
+
+  out.write(reinterpret_cast<const char*>(&header), sizeof(header));
+  out.write(padding, header.keys_offset_ - sizeof(header));
+  out.write(reinterpret_cast<const char*>(keys.data()),
+            (n + 1) * sizeof(Key));
+  out.write(padding, header.values_offset_ - header.keys_offset_ -
+                         (n + 1) * sizeof(Key));
+  out.write(reinterpret_cast<const char*>(values.data()), (n + 1) * sizeof(T));
+  out.close();
+
+  if (!out) {
+    throw std::runtime_error("s21::map::write_frozen(). cannot write file.");
+  }
+}
+
+}  // namespace details
+
+}  // namespace s21
+
+#endif  // S21_FROZEN_MAP_WRITER_H_
@@ -0,0 +1,345 @@
+#ifndef S21_INTRUSIVE_LIST_H_
+#define S21_INTRUSIVE_LIST_H_
+
+#pragma once
+
+#include <functional>
+#include <iterator>
+#include <memory>
+#include <stdexcept>
+#include <type_traits>
+
+#include "s21_list.h"
+
+namespace s21 {
+
+// Links inherited by an object so that it can sit in an intrusive_list. Tag
+// tells the hooks apart when an object derives from several of them to be in
+// several lists. A hook is unlinked when it points to itself. Copying an
+// object does not copy its membership.
+template <typename Tag = void>
+class list_hook : private details::list_node_base {
+ private:
+  using base_type = details::list_node_base;
+
+  template <typename T, typename HookTag>
+  friend class intrusive_list;
+  template <typename T, typename HookTag, typename Pointer, typename Reference>
+  friend class intrusive_list_iterator;
+
+ public:
+  list_hook() noexcept : base_type() {}
+  list_hook(const list_hook&) noexcept : base_type() {}
+  list_hook& operator=(const list_hook&) noexcept { return *this; }
+  ~list_hook() {}
+
+  bool is_linked() const noexcept { return next_ != this; }
+};
+
+template <typename T, typename Tag, typename Pointer, typename Reference>
+class intrusive_list_iterator {
+ private:
+  using this_type = intrusive_list_iterator<T, Tag, Pointer, Reference>;
+  using node_base_type = details::list_node_base;
+
+  using iterator = intrusive_list_iterator<T, Tag, T*, T&>;
+  using const_iterator = intrusive_list_iterator<T, Tag, const T*, const T&>;
+
+ public:
+  using iterator_category = std::bidirectional_iterator_tag;
+  using size_type = std::size_t;
+  using difference_type = std::ptrdiff_t;
+  using value_type = T;
+  using pointer = Pointer;
+  using reference = Reference;
+
+ public:
+  intrusive_list_iterator(const node_base_type* node_base) noexcept
+      : node_base_(const_cast<node_base_type*>(node_base)) {}
+  intrusive_list_iterator(const iterator& o) noexcept
+      : node_base_(o.node_base_) {}
+  intrusive_list_iterator(const const_iterator& o) noexcept
+      : node_base_(o.node_base_) {}
+  this_type& operator=(const iterator& o) noexcept {
+    return node_base_ = o.node_base_, *this;
+  }
+  this_type& operator=(const const_iterator& o) noexcept {
+    return node_base_ = o.node_base_, *this;
+  }
+
+  reference operator*() const noexcept { return *owner(node_base_); }
+  pointer operator->() const noexcept { return owner(node_base_); }
+
+  this_type& operator++() noexcept {
+    return node_base_ = node_base_->next_, *this;
+  }
+  this_type operator++(int) noexcept {
+    this_type tmp(node_base_);
+    return node_base_ = node_base_->next_, tmp;
+  }
+  this_type& operator--() noexcept {
+    return node_base_ = node_base_->prev_, *this;
+  }
+  this_type operator--(int) noexcept {
+    this_type tmp(node_base_);
+    return node_base_ = node_base_->prev_, tmp;
+  }
+
+  this_type next() const noexcept { return this_type(node_base_->next_); }
+  this_type prev() const noexcept { return this_type(node_base_->prev_); }
+
+  // Object whose list_hook<Tag> base is node.
+  static T* owner(node_base_type* node) noexcept {
+    return static_cast<T*>(static_cast<list_hook<Tag>*>(node));
+  }
+
+ public:
+  node_base_type* node_base_;
+};
+
+template <typename T, typename Tag, typename LPointer, typename LReference,
+          typename RPointer, typename RReference>
+inline bool operator==(
+    const intrusive_list_iterator<T, Tag, LPointer, LReference>& lhs,
+    const intrusive_list_iterator<T, Tag, RPointer, RReference>&
+        rhs) noexcept {
+  return lhs.node_base_ == rhs.node_base_;
+}
+
+template <typename T, typename Tag, typename LPointer, typename LReference,
+          typename RPointer, typename RReference>
+inline bool operator!=(
+    const intrusive_list_iterator<T, Tag, LPointer, LReference>& lhs,
+    const intrusive_list_iterator<T, Tag, RPointer, RReference>&
+        rhs) noexcept {
+  return lhs.node_base_ != rhs.node_base_;
+}
+
+// Doubly linked list of objects that carry their own links in a public
+// list_hook<Tag> base. The list never allocates and never owns its elements:
+// inserting links the object in place, erasing only unlinks it, and any
+// element can be removed in O(1) given just a reference to it. An object
+// must outlive its membership and can be in at most one list per hook.
+template <typename T, typename Tag = void>
+class intrusive_list {
+  static_assert(std::is_base_of_v<list_hook<Tag>, T>,
+                "s21::intrusive_list requires T to derive from list_hook<Tag>");
+
+ private:
+  using this_type = intrusive_list<T, Tag>;
+  using base_node_type = details::list_node_base;
+
+ public:
+  using value_type = T;
+  using reference = T&;
+  using const_reference = const T&;
+  using size_type = std::size_t;
+  using difference_type = std::ptrdiff_t;
+  using iterator = intrusive_list_iterator<T, Tag, T*, T&>;
+  using const_iterator = intrusive_list_iterator<T, Tag, const T*, const T&>;
+
+ public:
+  intrusive_list() noexcept : node_base_(), size_() {}
+  intrusive_list(const this_type&) = delete;
+  intrusive_list(this_type&& o) noexcept;
+  this_type& operator=(const this_type&) = delete;
+  this_type& operator=(this_type&& o) noexcept;
+  ~intrusive_list() { clear(); }
+
+  reference front();
+  const_reference front() const {
+    return const_cast<this_type*>(this)->front();
+  }
+  reference back();
+  const_reference back() const { return const_cast<this_type*>(this)->back(); }
+
+  iterator begin() noexcept { return iterator(node_base_.next_); }
+  const_iterator begin() const noexcept {
+    return const_iterator(node_base_.next_);
+  }
+  iterator end() noexcept { return iterator(&node_base_); }
+  const_iterator end() const noexcept { return const_iterator(&node_base_); }
+
+  bool empty() const noexcept { return size_ == 0; }
+  size_type size() const noexcept { return size_; }
+
+  // Iterator pointing at obj, which must be an element of this list.
+  static iterator iterator_to(reference obj) noexcept {
+    return iterator(hook(obj));
+  }
+  static const_iterator iterator_to(const_reference obj) noexcept {
+    return const_iterator(hook(const_cast<reference>(obj)));
+  }
+
+  void clear() noexcept;
+  iterator insert(const_iterator pos, reference obj);
+  iterator erase(const_iterator pos);
+  iterator erase(reference obj) { return erase(iterator_to(obj)); }
+  void push_back(reference obj) { insert(end(), obj); }
+  void pop_back() { erase(--end()); }
+  void push_front(reference obj) { insert(begin(), obj); }
+  void pop_front() { erase(begin()); }
+  void swap(this_type& o) noexcept;
+  void splice(const_iterator pos, this_type& o) noexcept;
+  void reverse() noexcept { node_base_.reverse(); }
+  void merge(this_type& o) { merge(o, std::less<value_type>()); }
+  template <typename Compare>
+  void merge(this_type& o, Compare comp);
+  void sort() { sort(std::less<value_type>()); }
+  template <typename Compare>
+  void sort(Compare comp);
+
+ private:
+  static base_node_type* hook(reference obj) noexcept {
+    return static_cast<list_hook<Tag>*>(std::addressof(obj));
+  }
+
+ private:
+  base_node_type node_base_;
+  size_type size_;
+};
+
+template <typename T, typename Tag>
+intrusive_list<T, Tag>::intrusive_list(this_type&& o) noexcept
+    : node_base_(), size_(o.size_) {
+  base_node_type::swap(&node_base_, &o.node_base_);
+  o.size_ = 0;
+}
+
+template <typename T, typename Tag>
+typename intrusive_list<T, Tag>::this_type&
+intrusive_list<T, Tag>::operator=(this_type&& o) noexcept {
+  if (&o != this) {
+    clear();
+    swap(o);
+  }
+
+  return *this;
+}
+
+template <typename T, typename Tag>
+typename intrusive_list<T, Tag>::reference intrusive_list<T, Tag>::front() {
+#ifdef DEBUG
+  if (empty()) {
+    throw std::out_of_range("s21::intrusive_list::front(). list is empty.");
+  }
+#endif
+
+  return *begin();
+}
+
+template <typename T, typename Tag>
+typename intrusive_list<T, Tag>::reference intrusive_list<T, Tag>::back() {
+#ifdef DEBUG
+  if (empty()) {
+    throw std::out_of_range("s21::intrusive_list::back(). list is empty.");
+  }
+#endif
+
+  return *--end();
+}
+
+// Unlinks every element, the objects themselves are left untouched.
+template <typename T, typename Tag>
+void intrusive_list<T, Tag>::clear() noexcept {
+  for (base_node_type* i = node_base_.next_; i != &node_base_;) {
+    base_node_type* tmp = i;
+    i = i->next_;
+    tmp->next_ = tmp->prev_ = tmp;
+  }
+  node_base_.next_ = node_base_.prev_ = &node_base_;
+  size_ = 0;
+}
+
+template <typename T, typename Tag>
+typename intrusive_list<T, Tag>::iterator intrusive_list<T, Tag>::insert(
+    const_iterator pos, reference obj) {
+#ifdef DEBUG
+  if (static_cast<const list_hook<Tag>&>(obj).is_linked()) {
+    throw std::invalid_argument(
+        "s21::intrusive_list::insert(). obj is already linked.");
+  }
+#endif
+
+  base_node_type* node = hook(obj);
+
+  node->insert(pos.node_base_);
+  ++size_;
+
+  return iterator(node);
+}
+
+template <typename T, typename Tag>
+typename intrusive_list<T, Tag>::iterator intrusive_list<T, Tag>::erase(
+    const_iterator pos) {
+#ifdef DEBUG
+  if (empty()) {
+    throw std::out_of_range("s21::intrusive_list::erase(). list is empty.");
+  }
+
+  if (pos == end()) {
+    throw std::out_of_range("s21::intrusive_list::erase(). pos is illegal.");
+  }
+#endif
+
+  base_node_type* node = pos.node_base_;
+  iterator next(node->next_);
+
+  node->erase();
+  node->next_ = node->prev_ = node;
+  --size_;
+
+  return next;
+}
+
+template <typename T, typename Tag>
+void intrusive_list<T, Tag>::swap(this_type& o) noexcept {
+  base_node_type::swap(&node_base_, &o.node_base_);
+  std::swap(size_, o.size_);
+}
+
+template <typename T, typename Tag>
+void intrusive_list<T, Tag>::splice(const_iterator pos,
+                                     this_type& o) noexcept {
+  if (this != &o && !o.empty()) {
+    pos.node_base_->splice(o.node_base_.next_, &o.node_base_);
+    size_ += o.size_;
+    o.size_ = 0;
+  }
+}
+
+template <typename T, typename Tag>
+template <typename Compare>
+void intrusive_list<T, Tag>::merge(this_type& o, Compare comp) {
+  if (this != &o && !o.empty()) {
+    auto icmp = [&comp](base_node_type* lhs, base_node_type* rhs) -> bool {
+      return comp(*iterator::owner(lhs), *iterator::owner(rhs));
+    };
+
+    try {
+      node_base_.merge(&o.node_base_, icmp);
+    } catch (...) {
+      const size_type left = std::distance(o.begin(), o.end());
+
+      size_ += o.size_ - left;
+      o.size_ = left;
+      throw;
+    }
+    size_ += o.size_;
+    o.size_ = 0;
+  }
+}
+
+template <typename T, typename Tag>
+template <typename Compare>
+void intrusive_list<T, Tag>::sort(Compare comp) {
+  auto icmp = [&comp](base_node_type* lhs, base_node_type* rhs) -> bool {
+    return comp(*iterator::owner(lhs), *iterator::owner(rhs));
+  };
+
+  node_base_.sort(icmp);
+}
+
+}  // namespace s21
+
+#endif  // S21_INTRUSIVE_LIST_H_
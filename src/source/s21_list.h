@@ -3,10 +3,14 @@
 
 #pragma once
 
+#include <functional>
 #include <initializer_list>
 #include <iterator>
 #include <memory>
 #include <stdexcept>
+#include <utility>
+
+#include "s21_stats.h"
 
 namespace s21 {
 
@@ -24,7 +28,9 @@ class list_node_base {
   void splice(this_type* const first, this_type* const last) noexcept;
   void reverse() noexcept;
   template <typename Compare>
-  void merge(this_type* const o, Compare cmp) noexcept;
+  void merge(this_type* const o, Compare cmp);
+  template <typename Compare>
+  void sort(Compare cmp);
 
   static void swap(this_type* const lhs, this_type* const rhs) noexcept;
 
@@ -67,7 +73,7 @@ void list_node_base::reverse() noexcept {
 }
 
 template <typename Compare>
-void list_node_base::merge(this_type* const o, Compare cmp) noexcept {
+void list_node_base::merge(this_type* const o, Compare cmp) {
   this_type* lfirst = next_;
   this_type* const llast = this;
   this_type* rfirst = o->next_;
@@ -88,6 +94,58 @@ void list_node_base::merge(this_type* const o, Compare cmp) noexcept {
   }
 }
 
+// Bottom-up merge sort that only relinks nodes. bins[i] is either empty or
+// holds a sorted run of 2^i nodes; every node taken off the front is carried
+// up through the occupied bins like a binary counter. Older runs are always
+// the left side of merge(), which keeps the sort stable. If cmp throws, all
+// nodes are put back, in unspecified order.
+template <typename Compare>
+void list_node_base::sort(Compare cmp) {
+  if (next_ == this || next_->next_ == this) {
+    return;
+  }
+
+  this_type carry;
+  this_type bins[64];
+  this_type* fill = bins;
+
+  try {
+    do {
+      carry.splice(next_, next_->next_);
+
+      this_type* bin = bins;
+
+      for (; bin != fill && bin->next_ != bin; ++bin) {
+        bin->merge(&carry, cmp);
+        swap(&carry, bin);
+      }
+      swap(&carry, bin);
+
+      if (bin == fill) {
+        ++fill;
+      }
+    } while (next_ != this);
+
+    for (this_type* bin = bins + 1; bin != fill; ++bin) {
+      bin->merge(bin - 1, cmp);
+    }
+  } catch (...) {
+    auto put_back = [this](this_type* run) {
+      if (run->next_ != run) {
+        splice(run->next_, run);
+      }
+    };
+
+    put_back(&carry);
+    for (this_type* bin = bins; bin != fill; ++bin) {
+      put_back(bin);
+    }
+    throw;
+  }
+
+  swap(this, fill - 1);
+}
+
 void list_node_base::swap(this_type* const lhs, this_type* const rhs) noexcept {
   std::swap(lhs->next_, rhs->next_);
   std::swap(lhs->prev_, rhs->prev_);
@@ -118,6 +176,9 @@ class list_node : public list_node_base {
   list_node() : val_() {}
   list_node(const value_type& val) : val_(val) {}
   list_node(value_type&& val) noexcept : val_(std::move(val)) {}
+  template <typename... Args>
+  explicit list_node(std::in_place_t, Args&&... args)
+      : val_(std::forward<Args>(args)...) {}
 
  public:
   value_type val_;
@@ -134,6 +195,7 @@ class list_iterator {
   using const_iterator = list_iterator<T, const T*, const T&>;
 
  public:
+  using iterator_category = std::bidirectional_iterator_tag;
   using size_type = std::size_t;
   using difference_type = std::ptrdiff_t;
   using value_type = T;
@@ -242,9 +304,13 @@ class list_base {
   ~list_base() { clear(); }
 
   base_node_type* allocate() {
+    stats::count(stats::container::list, stats::event::allocations);
+    stats::count(stats::container::list, stats::event::allocated_bytes,
+                 sizeof(node_type));
     return node_allocator_traits::allocate(node_alloc_, 1);
   }
   void deallocate(base_node_type* p) {
+    stats::count(stats::container::list, stats::event::deallocations);
     node_allocator_traits::deallocate(node_alloc_, static_cast<node_type*>(p),
                                       1);
   }
@@ -436,13 +502,57 @@ class list : public details::list_base<T, Alloc> {
   void push_front(const_reference val) { insert(begin(), val); }
   void pop_front() { erase(begin()); }
   void swap(this_type& o) noexcept { std::swap(*this, o); }
-  void merge(this_type&& o);
+  void merge(this_type&& o) { merge(std::move(o), std::less<value_type>()); }
   void merge(this_type& o) { merge(std::move(o)); }
+  template <typename Compare>
+  void merge(this_type&& o, Compare comp);
+  template <typename Compare>
+  void merge(this_type& o, Compare comp) {
+    merge(std::move(o), comp);
+  }
   void splice(const_iterator pos, this_type&& o);
   void splice(const_iterator pos, this_type& o) { splice(pos, std::move(o)); }
+  void splice(const_iterator pos, this_type&& o, const_iterator it);
+  void splice(const_iterator pos, this_type& o, const_iterator it) {
+    splice(pos, std::move(o), it);
+  }
+  void splice(const_iterator pos, this_type&& o, const_iterator first,
+              const_iterator last);
+  void splice(const_iterator pos, this_type& o, const_iterator first,
+              const_iterator last) {
+    splice(pos, std::move(o), first, last);
+  }
+  // O(1) range splice for callers that already know n, the number of
+  // elements in [first, last).
+  void splice(const_iterator pos, this_type&& o, const_iterator first,
+              const_iterator last, size_type n);
+  void splice(const_iterator pos, this_type& o, const_iterator first,
+              const_iterator last, size_type n) {
+    splice(pos, std::move(o), first, last, n);
+  }
   void reverse() noexcept { node_base_.reverse(); }
-  void unique() noexcept;
-  void sort() noexcept;
+  size_type unique() { return unique(std::equal_to<value_type>()); }
+  template <typename BinaryPredicate>
+  size_type unique(BinaryPredicate pred);
+  size_type remove(const_reference val) {
+    return remove_if([&val](const_reference elem) { return elem == val; });
+  }
+  template <typename UnaryPredicate>
+  size_type remove_if(UnaryPredicate pred);
+  void sort() { sort(std::less<value_type>()); }
+  template <typename Compare>
+  void sort(Compare comp);
+
+  template <typename... Args>
+  iterator emplace(const_iterator pos, Args&&... args);
+  template <typename... Args>
+  reference emplace_back(Args&&... args) {
+    return *emplace(end(), std::forward<Args>(args)...);
+  }
+  template <typename... Args>
+  reference emplace_front(Args&&... args) {
+    return *emplace(begin(), std::forward<Args>(args)...);
+  }
 
   template <typename... Args>
   iterator insert_many(const_iterator pos, Args&&... args);
@@ -450,6 +560,12 @@ class list : public details::list_base<T, Alloc> {
   void insert_many_back(Args&&... args);
   template <typename... Args>
   void insert_many_front(Args&&... args);
+
+ private:
+  size_type erase_all(base_node_type* removed);
+#ifdef DEBUG
+  void check_size() const;
+#endif
 };
 
 template <typename T, typename Alloc>
@@ -477,15 +593,22 @@ typename list<T, Alloc>::reference list<T, Alloc>::back() {
 template <typename T, typename Alloc>
 typename list<T, Alloc>::iterator list<T, Alloc>::insert(const_iterator pos,
                                                          value_type&& val) {
+  return emplace(pos, std::move(val));
+}
+
+template <typename T, typename Alloc>
+template <typename... Args>
+typename list<T, Alloc>::iterator list<T, Alloc>::emplace(const_iterator pos,
+                                                          Args&&... args) {
 #ifdef DEBUG
   if (size_ == max_size()) {
-    throw std::invalid_argument("s21::list::insert(). size too big.");
+    throw std::invalid_argument("s21::list::emplace(). size too big.");
   }
 #endif
 
   auto deleter = [this](base_node_type* ptr) -> void { deallocate(ptr); };
   std::unique_ptr<base_node_type, decltype(deleter)> tmp(allocate(), deleter);
-  construct(tmp.get(), std::move(val));
+  construct(tmp.get(), std::in_place, std::forward<Args>(args)...);
 
   tmp->insert(pos.node_base_);
   ++size_;
@@ -517,7 +640,8 @@ typename list<T, Alloc>::iterator list<T, Alloc>::erase(const_iterator pos) {
 }
 
 template <typename T, typename Alloc>
-void list<T, Alloc>::merge(this_type&& o) {
+template <typename Compare>
+void list<T, Alloc>::merge(this_type&& o, Compare comp) {
   if (this != &o && !o.empty()) {
 #ifdef DEBUG
     if (node_alloc_ != o.node_alloc_) {
@@ -526,18 +650,28 @@ void list<T, Alloc>::merge(this_type&& o) {
     }
 #endif
 
-    auto cmp = [](const value_type& lhs, const value_type& rhs) -> bool {
-      return lhs < rhs;
+    auto icmp = [&comp](base_node_type* lhs, base_node_type* rhs) -> bool {
+      return comp(static_cast<node_type*>(lhs)->val_,
+                  static_cast<node_type*>(rhs)->val_);
     };
 
-    auto icmp = [cmp](base_node_type* lhs, base_node_type* rhs) -> bool {
-      return cmp(static_cast<node_type*>(lhs)->val_,
-                 static_cast<node_type*>(rhs)->val_);
-    };
+    // Sizes are fixed up even if comp throws halfway: count what is left.
+    try {
+      node_base_.merge(&o.node_base_, icmp);
+    } catch (...) {
+      const size_type left = std::distance(o.begin(), o.end());
 
-    node_base_.merge(&o.node_base_, icmp);
+      size_ += o.size_ - left;
+      o.size_ = left;
+      throw;
+    }
     size_ += o.size_;
     o.size_ = 0;
+
+#ifdef DEBUG
+    check_size();
+    o.check_size();
+#endif
   }
 }
 
@@ -554,37 +688,181 @@ void list<T, Alloc>::splice(const_iterator pos, this_type&& o) {
     pos.node_base_->splice(o.begin().node_base_, o.end().node_base_);
     size_ += o.size_;
     o.size_ = 0;
+
+#ifdef DEBUG
+    check_size();
+    o.check_size();
+#endif
+  }
+}
+
+template <typename T, typename Alloc>
+void list<T, Alloc>::splice(const_iterator pos, this_type&& o,
+                            const_iterator it) {
+#ifdef DEBUG
+  if (node_alloc_ != o.node_alloc_) {
+    throw std::runtime_error(
+        "s21::list::splice(). cant splice list with different allocator.");
+  }
+
+  if (it == o.end()) {
+    throw std::out_of_range("s21::list::splice(). it is illegal.");
   }
+#endif
+
+  if (pos == it || pos == it.next()) {
+    return;
+  }
+
+  pos.node_base_->splice(it.node_base_, it.node_base_->next_);
+  ++size_;
+  --o.size_;
+
+#ifdef DEBUG
+  check_size();
+  o.check_size();
+#endif
 }
 
 template <typename T, typename Alloc>
-void list<T, Alloc>::unique() noexcept {
-  if (!empty()) {
+void list<T, Alloc>::splice(const_iterator pos, this_type&& o,
+                            const_iterator first, const_iterator last) {
+  splice(pos, std::move(o), first, last,
+         this != &o ? size_type(std::distance(first, last)) : 0);
+}
+
+// n is trusted: it only feeds the size bookkeeping, so a wrong count leaves
+// size() out of sync. DEBUG builds verify it.
+template <typename T, typename Alloc>
+void list<T, Alloc>::splice(const_iterator pos, this_type&& o,
+                            const_iterator first, const_iterator last,
+                            size_type n) {
+#ifdef DEBUG
+  if (node_alloc_ != o.node_alloc_) {
+    throw std::runtime_error(
+        "s21::list::splice(). cant splice list with different allocator.");
+  }
+
+  if (this != &o && n != size_type(std::distance(first, last))) {
+    throw std::invalid_argument(
+        "s21::list::splice(). n does not match the range.");
+  }
+#endif
+
+  if (first == last) {
+    return;
+  }
+
+  if (this != &o) {
+    size_ += n;
+    o.size_ -= n;
+  }
+
+  pos.node_base_->splice(first.node_base_, last.node_base_);
+
+#ifdef DEBUG
+  check_size();
+  o.check_size();
+#endif
+}
+
+// Destroys the nodes collected in the ring headed by removed. Removal is done
+// in two passes so a predicate argument referring to an element of the list
+// (remove(front()) for instance) stays valid until the end.
+template <typename T, typename Alloc>
+typename list<T, Alloc>::size_type list<T, Alloc>::erase_all(
+    base_node_type* removed) {
+  size_type n = 0;
+
+  for (base_node_type* i = removed->next_; i != removed; ++n) {
+    base_node_type* tmp = i;
+    i = i->next_;
+    destroy(tmp);
+    deallocate(tmp);
+  }
+  size_ -= n;
+
+  return n;
+}
+
+#ifdef DEBUG
+// Walks the nodes, both ways, and throws if size_ went out of sync with them.
+template <typename T, typename Alloc>
+void list<T, Alloc>::check_size() const {
+  size_type forward = 0;
+  size_type backward = 0;
+
+  for (auto it = begin(); it != end() && forward <= size_; ++it) {
+    ++forward;
+  }
+  for (auto it = end(); it != begin() && backward <= size_; --it) {
+    ++backward;
+  }
+
+  if (forward != size_ || backward != size_) {
+    throw std::runtime_error(
+        "s21::list::check_size(). size_ does not match the nodes.");
+  }
+}
+#endif
+
+template <typename T, typename Alloc>
+template <typename BinaryPredicate>
+typename list<T, Alloc>::size_type list<T, Alloc>::unique(
+    BinaryPredicate pred) {
+  base_node_type removed;
+
+  try {
     iterator first = begin();
-    iterator last = end();
 
-    for (iterator next = first; ++next != last;) {
-      if (*first == *next) {
-        erase(next);
+    for (iterator next = first.next(); first != end() && next != end();
+         next = first.next()) {
+      if (pred(*first, *next)) {
+        removed.splice(next.node_base_, next.node_base_->next_);
       } else {
         first = next;
       }
-      next = first;
     }
+  } catch (...) {
+    erase_all(&removed);
+    throw;
   }
+
+  return erase_all(&removed);
 }
 
 template <typename T, typename Alloc>
-void list<T, Alloc>::sort() noexcept {
-  if (size() > 1) {
-    for (auto i = begin(); i != end().prev(); ++i) {
-      for (auto j = begin(); j != end().prev(); ++j) {
-        if (*(j.next()) < *j) {
-          std::swap(*(j.next()), *j);
-        }
+template <typename UnaryPredicate>
+typename list<T, Alloc>::size_type list<T, Alloc>::remove_if(
+    UnaryPredicate pred) {
+  base_node_type removed;
+
+  try {
+    for (iterator it = begin(); it != end();) {
+      iterator next = it.next();
+
+      if (pred(*it)) {
+        removed.splice(it.node_base_, next.node_base_);
       }
+      it = next;
     }
+  } catch (...) {
+    erase_all(&removed);
+    throw;
   }
+
+  return erase_all(&removed);
+}
+
+template <typename T, typename Alloc>
+template <typename Compare>
+void list<T, Alloc>::sort(Compare comp) {
+  auto icmp = [&comp](base_node_type* lhs, base_node_type* rhs) -> bool {
+    return comp(static_cast<node_type*>(lhs)->val_,
+                static_cast<node_type*>(rhs)->val_);
+  };
+
+  node_base_.sort(icmp);
 }
 
 template <typename T, typename Alloc>
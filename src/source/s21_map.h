@@ -3,7 +3,10 @@
 
 #pragma once
 
+#include <string>
+
 #include "../rb_tree/s21_rb_tree.h"
+#include "s21_frozen_map_writer.h"
 #include "s21_vector.h"
 
 namespace s21 {
@@ -73,6 +76,17 @@ class map
   }
   template <typename K, typename M>
   std::pair<iterator, bool> insert_or_assign(K&& key, M&& obj);
+
+  // Saves the map for s21::frozen_map_view<Key, T, Compare>, which serves
+  // it from the file without rebuilding a tree. Key and T must be
+  // arithmetic or enum types other than bool, so that the file holds no
+  // padding or pointers. Throws std::runtime_error when the file cannot be
+  // written.
+  void write_frozen(const std::string& path,
+                    frozen_layout layout = frozen_layout::eytzinger) const {
+    details::write_frozen_map<Key, T>(path, base_type::begin(),
+                                      base_type::size(), layout);
+  }
 };
 
 template <typename Key, typename T, typename Compare, typename Alloc>
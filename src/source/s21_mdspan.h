@@ -0,0 +1,578 @@
+#ifndef S21_MDSPAN_H_
+#define S21_MDSPAN_H_
+
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+
+#include "s21_array.h"
+#include "s21_span.h"
+#include "s21_vector.h"
+
+namespace s21 {
+
+namespace details {
+
+template <std::size_t... Extents>
+inline constexpr std::size_t rank_dynamic_ =
+    ((Extents == dynamic_extent ? 1 : 0) + ...);
+
+}  // namespace details
+
+// Sizes of the dimensions of a multi-dimensional array. Each one is fixed
+// at compile time or, when given as dynamic_extent, at construction:
+// extents<3, dynamic_extent>(4) is 3 x 4.
+template <std::size_t... Extents>
+class extents {
+  static_assert(sizeof...(Extents) > 0, "s21::extents needs a dimension");
+
+ public:
+  using size_type = std::size_t;
+
+ public:
+  static constexpr size_type rank() noexcept { return sizeof...(Extents); }
+  static constexpr size_type rank_dynamic() noexcept {
+    return details::rank_dynamic_<Extents...>;
+  }
+  static constexpr size_type static_extent(size_type r) noexcept {
+    return static_extents_[r];
+  }
+
+  constexpr extents() noexcept : dynamic_{} {}
+  template <typename... Dyn,
+            typename = std::enable_if_t<
+                sizeof...(Dyn) == details::rank_dynamic_<Extents...> &&
+                sizeof...(Dyn) != 0>>
+  constexpr explicit extents(Dyn... dyn) noexcept
+      : dynamic_{{size_type(dyn)...}} {}
+
+  constexpr size_type extent(size_type r) const noexcept {
+    if (static_extents_[r] != dynamic_extent) {
+      return static_extents_[r];
+    }
+
+    size_type pos = 0;
+    for (size_type i = 0; i < r; ++i) {
+      pos += static_extents_[i] == dynamic_extent;
+    }
+
+    return dynamic_[pos];
+  }
+
+  // Number of elements, the product of the extents.
+  constexpr size_type size() const noexcept {
+    size_type res = 1;
+
+    for (size_type r = 0; r < rank(); ++r) {
+      res *= extent(r);
+    }
+
+    return res;
+  }
+
+ private:
+  static constexpr array<size_type, sizeof...(Extents)> static_extents_{
+      {Extents...}};
+
+  array<size_type, details::rank_dynamic_<Extents...>> dynamic_;
+};
+
+template <std::size_t... L, std::size_t... R>
+constexpr bool operator==(const extents<L...>& lhs,
+                          const extents<R...>& rhs) noexcept {
+  if constexpr (sizeof...(L) != sizeof...(R)) {
+    return false;
+  } else {
+    for (std::size_t r = 0; r < sizeof...(L); ++r) {
+      if (lhs.extent(r) != rhs.extent(r)) {
+        return false;
+      }
+    }
+
+    return true;
+  }
+}
+
+template <std::size_t... L, std::size_t... R>
+constexpr bool operator!=(const extents<L...>& lhs,
+                          const extents<R...>& rhs) noexcept {
+  return !(lhs == rhs);
+}
+
+namespace details {
+
+template <std::size_t, std::size_t Value>
+inline constexpr std::size_t repeat_ = Value;
+
+template <typename Sequence>
+struct make_dextents;
+
+template <std::size_t... I>
+struct make_dextents<std::index_sequence<I...>> {
+  using type = extents<repeat_<I, dynamic_extent>...>;
+};
+
+template <typename F, std::size_t Rank, std::size_t... I>
+void call_with_index(F& f, const array<std::size_t, Rank>& idx,
+                     std::index_sequence<I...>) {
+  f(idx[I]...);
+}
+
+// Calls f(i0, i1, ...) for every index in the box [lo, hi). Dimension
+// order[0] changes slowest and order[Rank - 1] fastest, in a plain loop of
+// its own.
+template <std::size_t Rank, typename F>
+void for_each_in_box(const array<std::size_t, Rank>& lo,
+                     const array<std::size_t, Rank>& hi,
+                     const array<std::size_t, Rank>& order, F& f) {
+  for (std::size_t r = 0; r < Rank; ++r) {
+    if (lo[r] >= hi[r]) {
+      return;
+    }
+  }
+
+  const std::size_t inner = order[Rank - 1];
+  array<std::size_t, Rank> idx = lo;
+
+  while (true) {
+    for (idx[inner] = lo[inner]; idx[inner] < hi[inner]; ++idx[inner]) {
+      call_with_index(f, idx, std::make_index_sequence<Rank>());
+    }
+
+    // Advances the outer dimensions like an odometer.
+    std::size_t r = Rank - 1;
+    while (r > 0) {
+      const std::size_t dim = order[--r];
+
+      if (++idx[dim] < hi[dim]) {
+        break;
+      }
+      idx[dim] = lo[dim];
+      if (r == 0) {
+        return;
+      }
+    }
+    if (Rank == 1) {
+      return;
+    }
+  }
+}
+
+}  // namespace details
+
+// extents with every dimension dynamic: dextents<2>(rows, cols).
+template <std::size_t Rank>
+using dextents =
+    typename details::make_dextents<std::make_index_sequence<Rank>>::type;
+
+// Row-major, like C arrays: the last index is contiguous.
+struct layout_right {
+  template <typename Extents>
+  class mapping {
+   public:
+    using extents_type = Extents;
+    using size_type = std::size_t;
+
+   public:
+    constexpr mapping() noexcept = default;
+    constexpr explicit mapping(const extents_type& e) noexcept : extents_(e) {}
+
+    constexpr const extents_type& extents() const noexcept { return extents_; }
+
+    template <typename... Indices>
+    constexpr size_type operator()(Indices... idx) const noexcept {
+      return offset(std::make_index_sequence<sizeof...(Indices)>(),
+                    size_type(idx)...);
+    }
+
+    constexpr size_type required_span_size() const noexcept {
+      return extents_.size();
+    }
+    constexpr size_type stride(size_type r) const noexcept {
+      size_type res = 1;
+
+      for (size_type i = r + 1; i < extents_type::rank(); ++i) {
+        res *= extents_.extent(i);
+      }
+
+      return res;
+    }
+
+    // Calls f(i0, i1, ...) for every index in storage order.
+    template <typename F>
+    void for_each_index(F&& f) const {
+      array<size_type, extents_type::rank()> lo{};
+      array<size_type, extents_type::rank()> hi{};
+      array<size_type, extents_type::rank()> order{};
+
+      for (size_type r = 0; r < extents_type::rank(); ++r) {
+        hi[r] = extents_.extent(r);
+        order[r] = r;
+      }
+      details::for_each_in_box(lo, hi, order, f);
+    }
+
+   private:
+    template <std::size_t... I, typename... Indices>
+    constexpr size_type offset(std::index_sequence<I...>,
+                               Indices... idx) const noexcept {
+      static_assert(sizeof...(I) == extents_type::rank(),
+                    "s21::layout_right. one index per dimension");
+
+      size_type res = 0;
+      ((res = res * extents_.extent(I) + idx), ...);
+      return res;
+    }
+
+   private:
+    extents_type extents_;
+  };
+};
+
+// Column-major, like Fortran: the first index is contiguous.
+struct layout_left {
+  template <typename Extents>
+  class mapping {
+   public:
+    using extents_type = Extents;
+    using size_type = std::size_t;
+
+   public:
+    constexpr mapping() noexcept = default;
+    constexpr explicit mapping(const extents_type& e) noexcept : extents_(e) {}
+
+    constexpr const extents_type& extents() const noexcept { return extents_; }
+
+    template <typename... Indices>
+    constexpr size_type operator()(Indices... idx) const noexcept {
+      static_assert(sizeof...(Indices) == extents_type::rank(),
+                    "s21::layout_left. one index per dimension");
+
+      const array<size_type, sizeof...(Indices)> index{{size_type(idx)...}};
+      size_type res = 0;
+
+      for (size_type r = extents_type::rank(); r-- > 0;) {
+        res = res * extents_.extent(r) + index[r];
+      }
+
+      return res;
+    }
+
+    constexpr size_type required_span_size() const noexcept {
+      return extents_.size();
+    }
+    constexpr size_type stride(size_type r) const noexcept {
+      size_type res = 1;
+
+      for (size_type i = 0; i < r; ++i) {
+        res *= extents_.extent(i);
+      }
+
+      return res;
+    }
+
+    template <typename F>
+    void for_each_index(F&& f) const {
+      array<size_type, extents_type::rank()> lo{};
+      array<size_type, extents_type::rank()> hi{};
+      array<size_type, extents_type::rank()> order{};
+
+      for (size_type r = 0; r < extents_type::rank(); ++r) {
+        hi[r] = extents_.extent(r);
+        order[r] = extents_type::rank() - 1 - r;
+      }
+      details::for_each_in_box(lo, hi, order, f);
+    }
+
+   private:
+    extents_type extents_;
+  };
+};
+
+// Cache blocking: the array is cut into Tiles[0] x Tiles[1] x ... tiles laid
+// out row-major, and each tile is stored contiguously, also row-major.
+// Neighbours in any direction then tend to share a tile, so stencils and
+// transposes touch few cache lines. Extents are padded up to whole tiles;
+// powers of two keep the index math to shifts and masks.
+template <std::size_t... Tiles>
+struct layout_tiled {
+  template <typename Extents>
+  class mapping {
+    static_assert(sizeof...(Tiles) == Extents::rank(),
+                  "s21::layout_tiled. one tile size per dimension");
+    static_assert(((Tiles > 0) && ...), "s21::layout_tiled. empty tile");
+
+   public:
+    using extents_type = Extents;
+    using size_type = std::size_t;
+
+    static constexpr size_type tile_size_ = (Tiles * ...);
+
+   public:
+    constexpr mapping() noexcept : mapping(extents_type()) {}
+    constexpr explicit mapping(const extents_type& e) noexcept
+        : extents_(e), tiles_{} {
+      for (size_type r = 0; r < extents_type::rank(); ++r) {
+        tiles_[r] = (extents_.extent(r) + tile_[r] - 1) / tile_[r];
+      }
+    }
+
+    constexpr const extents_type& extents() const noexcept { return extents_; }
+
+    template <typename... Indices>
+    constexpr size_type operator()(Indices... idx) const noexcept {
+      return offset(std::make_index_sequence<sizeof...(Indices)>(),
+                    size_type(idx)...);
+    }
+
+    // Includes the padding of the tiles at the far edges.
+    constexpr size_type required_span_size() const noexcept {
+      size_type res = tile_size_;
+
+      for (size_type r = 0; r < extents_type::rank(); ++r) {
+        res *= tiles_[r];
+      }
+
+      return res;
+    }
+
+    // Storage order: tile by tile, row-major inside each tile.
+    template <typename F>
+    void for_each_index(F&& f) const {
+      constexpr size_type rank = extents_type::rank();
+
+      array<size_type, rank> tile{};
+      array<size_type, rank> lo{};
+      array<size_type, rank> hi{};
+      array<size_type, rank> order{};
+
+      for (size_type r = 0; r < rank; ++r) {
+        order[r] = r;
+      }
+
+      const array<size_type, rank> none{};
+      auto visit_tile = [&](auto... t) {
+        tile = array<size_type, rank>{{size_type(t)...}};
+        for (size_type r = 0; r < rank; ++r) {
+          lo[r] = tile[r] * tile_[r];
+          hi[r] = std::min(lo[r] + tile_[r], extents_.extent(r));
+        }
+        details::for_each_in_box(lo, hi, order, f);
+      };
+      details::for_each_in_box(none, tiles_, order, visit_tile);
+    }
+
+   private:
+    template <std::size_t... I, typename... Indices>
+    constexpr size_type offset(std::index_sequence<I...>,
+                               Indices... idx) const noexcept {
+      static_assert(sizeof...(I) == extents_type::rank(),
+                    "s21::layout_tiled. one index per dimension");
+
+      size_type tile = 0;
+      size_type inner = 0;
+      ((tile = tile * tiles_[I] + idx / Tiles,
+        inner = inner * Tiles + idx % Tiles),
+       ...);
+      return tile * tile_size_ + inner;
+    }
+
+   private:
+    static constexpr array<size_type, sizeof...(Tiles)> tile_{{Tiles...}};
+
+    extents_type extents_;
+    array<size_type, sizeof...(Tiles)> tiles_;
+  };
+};
+
+// Non-owning multi-dimensional view of contiguous storage, like C++23
+// std::mdspan: m(i, j) is data()[mapping()(i, j)].
+template <typename T, typename Extents, typename Layout = layout_right>
+class mdspan {
+ public:
+  using extents_type = Extents;
+  using layout_type = Layout;
+  using mapping_type = typename Layout::template mapping<Extents>;
+  using element_type = T;
+  using value_type = std::remove_cv_t<T>;
+  using size_type = std::size_t;
+  using pointer = T*;
+  using reference = T&;
+
+ public:
+  constexpr mdspan() noexcept : ptr_(nullptr), map_() {}
+  constexpr mdspan(pointer p, const mapping_type& m) noexcept
+      : ptr_(p), map_(m) {}
+  constexpr mdspan(pointer p, const extents_type& e) noexcept
+      : ptr_(p), map_(e) {}
+  // mdspan<double, dextents<2>>(vec.data(), rows, cols)
+  template <typename... Dyn,
+            typename = std::enable_if_t<sizeof...(Dyn) ==
+                                        Extents::rank_dynamic()>>
+  constexpr explicit mdspan(pointer p, Dyn... dyn) noexcept
+      : ptr_(p), map_(extents_type(dyn...)) {}
+  // A view of a non-const view's elements may be read-only.
+  template <typename U, typename = std::enable_if_t<
+                            std::is_convertible_v<U (*)[], T (*)[]>>>
+  constexpr mdspan(const mdspan<U, Extents, Layout>& o) noexcept
+      : ptr_(o.data()), map_(o.mapping()) {}
+
+  template <typename... Indices>
+  constexpr reference operator()(Indices... idx) const noexcept {
+    return ptr_[map_(idx...)];
+  }
+  template <typename... Indices>
+  constexpr reference at(Indices... idx) const;
+
+  static constexpr size_type rank() noexcept { return Extents::rank(); }
+  constexpr size_type extent(size_type r) const noexcept {
+    return map_.extents().extent(r);
+  }
+  constexpr size_type size() const noexcept { return map_.extents().size(); }
+  constexpr bool empty() const noexcept { return size() == 0; }
+
+  constexpr pointer data() const noexcept { return ptr_; }
+  constexpr const mapping_type& mapping() const noexcept { return map_; }
+  constexpr const extents_type& extents() const noexcept {
+    return map_.extents();
+  }
+
+ private:
+  pointer ptr_;
+  mapping_type map_;
+};
+
+template <typename T, typename Extents, typename Layout>
+template <typename... Indices>
+constexpr typename mdspan<T, Extents, Layout>::reference
+mdspan<T, Extents, Layout>::at(Indices... idx) const {
+  size_type r = 0;
+
+  if (!((size_type(idx) < extent(r++)) && ...)) {
+    throw std::out_of_range("s21::mdspan::at(). index is illegal.");
+  }
+
+  return (*this)(idx...);
+}
+
+namespace details {
+
+// s21::array when every extent is static, sized at compile time; vector
+// otherwise.
+template <typename T, typename Extents, typename Layout,
+          bool Static = Extents::rank_dynamic() == 0>
+struct mdarray_container {
+  using type = s21::vector<T>;
+};
+
+template <typename T, typename Extents, typename Layout>
+struct mdarray_container<T, Extents, Layout, true> {
+  using mapping_type = typename Layout::template mapping<Extents>;
+
+  static constexpr std::size_t size_ =
+      mapping_type(Extents()).required_span_size();
+
+  using type = s21::array<T, size_>;
+};
+
+}  // namespace details
+
+// Owning multi-dimensional array: an mdspan over its own s21::array (all
+// extents static) or s21::vector storage. Elements are value-initialized.
+template <typename T, typename Extents, typename Layout = layout_right>
+class mdarray {
+ private:
+  using this_type = mdarray<T, Extents, Layout>;
+
+ public:
+  using extents_type = Extents;
+  using layout_type = Layout;
+  using mapping_type = typename Layout::template mapping<Extents>;
+  using container_type =
+      typename details::mdarray_container<T, Extents, Layout>::type;
+  using value_type = T;
+  using size_type = std::size_t;
+  using reference = T&;
+  using const_reference = const T&;
+  using pointer = T*;
+  using const_pointer = const T*;
+  using view_type = mdspan<T, Extents, Layout>;
+  using const_view_type = mdspan<const T, Extents, Layout>;
+
+ public:
+  mdarray() : mdarray(extents_type()) {}
+  template <typename... Dyn,
+            typename = std::enable_if_t<sizeof...(Dyn) ==
+                                            Extents::rank_dynamic() &&
+                                        sizeof...(Dyn) != 0>>
+  explicit mdarray(Dyn... dyn) : mdarray(extents_type(dyn...)) {}
+  explicit mdarray(const extents_type& e, const_reference val = value_type());
+
+  template <typename... Indices>
+  reference operator()(Indices... idx) noexcept {
+    return container_.data()[map_(idx...)];
+  }
+  template <typename... Indices>
+  const_reference operator()(Indices... idx) const noexcept {
+    return container_.data()[map_(idx...)];
+  }
+  template <typename... Indices>
+  reference at(Indices... idx) {
+    return view().at(idx...);
+  }
+  template <typename... Indices>
+  const_reference at(Indices... idx) const {
+    return view().at(idx...);
+  }
+
+  static constexpr size_type rank() noexcept { return Extents::rank(); }
+  size_type extent(size_type r) const noexcept {
+    return map_.extents().extent(r);
+  }
+  size_type size() const noexcept { return map_.extents().size(); }
+  bool empty() const noexcept { return size() == 0; }
+
+  pointer data() noexcept { return container_.data(); }
+  const_pointer data() const noexcept { return container_.data(); }
+  const mapping_type& mapping() const noexcept { return map_; }
+  const extents_type& extents() const noexcept { return map_.extents(); }
+  container_type& container() noexcept { return container_; }
+  const container_type& container() const noexcept { return container_; }
+
+  view_type view() noexcept { return view_type(data(), map_); }
+  const_view_type view() const noexcept {
+    return const_view_type(data(), map_);
+  }
+
+ private:
+  mapping_type map_;
+  container_type container_;
+};
+
+template <typename T, typename Extents, typename Layout>
+mdarray<T, Extents, Layout>::mdarray(const extents_type& e,
+                                     const_reference val)
+    : map_(e), container_() {
+  if constexpr (Extents::rank_dynamic() == 0) {
+    container_.fill(val);
+  } else {
+    container_ = container_type(map_.required_span_size(), val);
+  }
+}
+
+// Calls f(i0, i1, ...) for every index of m, in the order its layout stores
+// the elements, so that the innermost loop walks contiguous memory: the last
+// index fastest for layout_right, the first for layout_left, tile by tile
+// for layout_tiled. Works on mdspan and mdarray.
+template <typename MdArray, typename F>
+void for_each_index(const MdArray& m, F&& f) {
+  m.mapping().for_each_index(f);
+}
+
+}  // namespace s21
+
+#endif  // S21_MDSPAN_H_
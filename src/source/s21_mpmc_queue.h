@@ -0,0 +1,373 @@
+#ifndef S21_MPMC_QUEUE_H_
+#define S21_MPMC_QUEUE_H_
+
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <iterator>
+#include <memory>
+#include <new>
+#include <stdexcept>
+#include <type_traits>
+
+#include "s21_concurrency.h"
+#include "s21_vector.h"
+
+namespace s21 {
+
+namespace details {
+
+// A slot of the Vyukov queue. seq_ == pos means the slot is free for the
+// producer of ticket pos, seq_ == pos + 1 means it holds the value for the
+// consumer of ticket pos.
+template <typename T>
+class mpmc_cell {
+ public:
+  explicit mpmc_cell(std::size_t seq) noexcept : seq_(seq) {}
+
+  T* value() noexcept { return std::launder(reinterpret_cast<T*>(data_)); }
+
+ public:
+  std::atomic<std::size_t> seq_;
+  alignas(T) unsigned char data_[sizeof(T)];
+};
+
+}  // namespace details
+
+// Bounded lock-free multi-producer multi-consumer queue (D. Vyukov's
+// sequence-numbered ring). Producers and consumers only contend on their own
+// ticket counter; a full or empty queue is reported without blocking.
+template <typename T, typename Alloc = std::allocator<T>>
+class mpmc_queue {
+ private:
+  using this_type = mpmc_queue<T, Alloc>;
+
+  using cell_type = details::mpmc_cell<T>;
+  using t_allocator_type = Alloc;
+  using t_allocator_traits = std::allocator_traits<t_allocator_type>;
+  using cell_allocator_type =
+      typename t_allocator_traits::template rebind_alloc<cell_type>;
+  using cell_allocator_traits = std::allocator_traits<cell_allocator_type>;
+
+ public:
+  using value_type = T;
+  using reference = T&;
+  using const_reference = const T&;
+  using size_type = std::size_t;
+
+ public:
+  explicit mpmc_queue(size_type capacity);
+  mpmc_queue(const mpmc_queue&) = delete;
+  mpmc_queue(mpmc_queue&&) = delete;
+  this_type& operator=(const mpmc_queue&) = delete;
+  this_type& operator=(mpmc_queue&&) = delete;
+  ~mpmc_queue();
+
+  bool empty() const noexcept { return size() == 0; }
+  size_type size() const noexcept;
+  size_type capacity() const noexcept { return mask_ + 1; }
+
+  bool try_push(const_reference value) { return try_emplace(value); }
+  bool try_push(value_type&& value) { return try_emplace(std::move(value)); }
+  template <typename... Args>
+  bool try_emplace(Args&&... args);
+  void push(const_reference value);
+  void push(value_type&& value);
+  template <typename InputIt>
+  size_type push_bulk(InputIt first, size_type n);
+  template <typename... Args>
+  void insert_many_back(Args&&... args);
+
+  bool try_pop(reference value);
+  void pop(reference value);
+  template <typename OutputIt>
+  size_type pop_bulk(OutputIt out, size_type n);
+
+ private:
+  cell_type* cell(size_type pos) const noexcept {
+    return cells_ + (pos & mask_);
+  }
+  size_type claim_push(size_type& n) noexcept;
+  size_type claim_pop(size_type& n) noexcept;
+  template <typename OutputIt>
+  void release_pop(size_type pos, size_type n, OutputIt out);
+
+ private:
+  cell_allocator_type alloc_;
+  cell_type* cells_;
+  size_type mask_;
+
+  alignas(details::cache_line_size_) std::atomic<size_type> enqueue_pos_;
+  alignas(details::cache_line_size_) std::atomic<size_type> dequeue_pos_;
+};
+
+template <typename T, typename Alloc>
+mpmc_queue<T, Alloc>::mpmc_queue(size_type capacity)
+    : alloc_(), cells_(nullptr), mask_(), enqueue_pos_(0), dequeue_pos_(0) {
+  if (capacity < 2 || capacity > (size_type(0) - 1) / 4 + 1) {
+    throw std::invalid_argument("s21::mpmc_queue(). invalid capacity.");
+  }
+
+  size_type cap = 2;
+
+  while (cap < capacity) {
+    cap *= 2;
+  }
+
+  cells_ = cell_allocator_traits::allocate(alloc_, cap);
+  mask_ = cap - 1;
+
+  for (size_type i = 0; i < cap; ++i) {
+    cell_allocator_traits::construct(alloc_, cells_ + i, i);
+  }
+}
+
+template <typename T, typename Alloc>
+mpmc_queue<T, Alloc>::~mpmc_queue() {
+  const size_type tail = enqueue_pos_.load(std::memory_order_relaxed);
+
+  for (size_type i = dequeue_pos_.load(std::memory_order_relaxed); i != tail;
+       ++i) {
+    cell(i)->value()->~value_type();
+  }
+
+  for (size_type i = 0; i <= mask_; ++i) {
+    cell_allocator_traits::destroy(alloc_, cells_ + i);
+  }
+  cell_allocator_traits::deallocate(alloc_, cells_, mask_ + 1);
+}
+
+template <typename T, typename Alloc>
+typename mpmc_queue<T, Alloc>::size_type mpmc_queue<T, Alloc>::size()
+    const noexcept {
+  const size_type head = dequeue_pos_.load(std::memory_order_acquire);
+  const size_type tail = enqueue_pos_.load(std::memory_order_acquire);
+
+  if (tail - head > capacity()) {
+    return tail < head ? 0 : capacity();
+  }
+
+  return tail - head;
+}
+
+// Claims up to n consecutive free slots for the calling producer, returns the
+// first ticket and stores the number of claimed slots back into n. A slot is
+// free for ticket pos when its sequence equals pos; nobody but the owner of an
+// earlier ticket can change that, so checking the run and then moving
+// enqueue_pos_ past it is race-free.
+template <typename T, typename Alloc>
+typename mpmc_queue<T, Alloc>::size_type mpmc_queue<T, Alloc>::claim_push(
+    size_type& n) noexcept {
+  size_type pos = enqueue_pos_.load(std::memory_order_relaxed);
+
+  for (details::backoff wait;;) {
+    size_type k = 0;
+
+    while (k < n &&
+           cell(pos + k)->seq_.load(std::memory_order_acquire) == pos + k) {
+      ++k;
+    }
+
+    if (k == 0) {
+      const size_type seq = cell(pos)->seq_.load(std::memory_order_acquire);
+
+      if (std::ptrdiff_t(seq - pos) < 0) {
+        return n = 0, pos;
+      }
+      pos = enqueue_pos_.load(std::memory_order_relaxed);
+    } else if (enqueue_pos_.compare_exchange_weak(pos, pos + k,
+                                                  std::memory_order_relaxed)) {
+      return n = k, pos;
+    } else {
+      wait();
+    }
+  }
+}
+
+template <typename T, typename Alloc>
+typename mpmc_queue<T, Alloc>::size_type mpmc_queue<T, Alloc>::claim_pop(
+    size_type& n) noexcept {
+  size_type pos = dequeue_pos_.load(std::memory_order_relaxed);
+
+  for (details::backoff wait;;) {
+    size_type k = 0;
+
+    while (k < n && cell(pos + k)->seq_.load(std::memory_order_acquire) ==
+                        pos + k + 1) {
+      ++k;
+    }
+
+    if (k == 0) {
+      const size_type seq = cell(pos)->seq_.load(std::memory_order_acquire);
+
+      if (std::ptrdiff_t(seq - (pos + 1)) < 0) {
+        return n = 0, pos;
+      }
+      pos = dequeue_pos_.load(std::memory_order_relaxed);
+    } else if (dequeue_pos_.compare_exchange_weak(pos, pos + k,
+                                                  std::memory_order_relaxed)) {
+      return n = k, pos;
+    } else {
+      wait();
+    }
+  }
+}
+
+// A claimed slot must be published, so a constructor that may throw is run
+// on a temporary before claiming and the value is moved in afterwards.
+template <typename T, typename Alloc>
+template <typename... Args>
+bool mpmc_queue<T, Alloc>::try_emplace(Args&&... args) {
+  if constexpr (!std::is_nothrow_constructible_v<value_type, Args&&...>) {
+    static_assert(std::is_nothrow_move_constructible_v<value_type>,
+                  "s21::mpmc_queue requires nothrow move construction");
+
+    if (size() == capacity()) {
+      return false;
+    }
+    return try_emplace(value_type(std::forward<Args>(args)...));
+  } else {
+    size_type n = 1;
+    const size_type pos = claim_push(n);
+
+    if (n == 0) {
+      return false;
+    }
+
+    cell_type* c = cell(pos);
+    ::new (static_cast<void*>(c->data_))
+        value_type(std::forward<Args>(args)...);
+    c->seq_.store(pos + 1, std::memory_order_release);
+
+    return true;
+  }
+}
+
+template <typename T, typename Alloc>
+void mpmc_queue<T, Alloc>::push(const_reference value) {
+  for (details::backoff wait; !try_push(value);) {
+    wait();
+  }
+}
+
+template <typename T, typename Alloc>
+void mpmc_queue<T, Alloc>::push(value_type&& value) {
+  for (details::backoff wait; !try_push(std::move(value));) {
+    wait();
+  }
+}
+
+// Claims one run of up to n slots with a single CAS and fills it from first.
+// Returns how many elements were pushed. Every claimed slot must be
+// published, so elements whose copy may throw are first copied into a local
+// batch and moved into the slots from there.
+template <typename T, typename Alloc>
+template <typename InputIt>
+typename mpmc_queue<T, Alloc>::size_type mpmc_queue<T, Alloc>::push_bulk(
+    InputIt first, size_type n) {
+  using source_reference = typename std::iterator_traits<InputIt>::reference;
+
+  if (n == 0) {
+    return 0;
+  }
+
+  if constexpr (!std::is_nothrow_constructible_v<value_type,
+                                                 source_reference>) {
+    static_assert(std::is_nothrow_move_constructible_v<value_type>,
+                  "s21::mpmc_queue requires nothrow move construction");
+
+    s21::vector<value_type> batch;
+
+    n = std::min(n, capacity() - std::min(size(), capacity()));
+    batch.reserve(n);
+    for (size_type i = 0; i < n; ++i, ++first) {
+      batch.emplace_back(*first);
+    }
+    return push_bulk(std::make_move_iterator(batch.begin()), n);
+  }
+
+  const size_type pos = claim_push(n);
+
+  for (size_type i = 0; i < n; ++i, ++first) {
+    cell_type* c = cell(pos + i);
+    ::new (static_cast<void*>(c->data_)) value_type(*first);
+    c->seq_.store(pos + i + 1, std::memory_order_release);
+  }
+
+  return n;
+}
+
+template <typename T, typename Alloc>
+template <typename... Args>
+void mpmc_queue<T, Alloc>::insert_many_back(Args&&... args) {
+  (..., push(std::forward<Args>(args)));
+}
+
+template <typename T, typename Alloc>
+bool mpmc_queue<T, Alloc>::try_pop(reference value) {
+  size_type n = 1;
+  const size_type pos = claim_pop(n);
+
+  if (n == 0) {
+    return false;
+  }
+
+  release_pop(pos, 1, &value);
+
+  return true;
+}
+
+template <typename T, typename Alloc>
+void mpmc_queue<T, Alloc>::pop(reference value) {
+  for (details::backoff wait; !try_pop(value);) {
+    wait();
+  }
+}
+
+template <typename T, typename Alloc>
+template <typename OutputIt>
+typename mpmc_queue<T, Alloc>::size_type mpmc_queue<T, Alloc>::pop_bulk(
+    OutputIt out, size_type n) {
+  if (n == 0) {
+    return 0;
+  }
+
+  const size_type pos = claim_pop(n);
+
+  release_pop(pos, n, out);
+
+  return n;
+}
+
+// Moves the n claimed values from pos on into out and frees their slots.
+// The slots must be freed for the producers even when writing to out
+// throws, so the values not written by then are dropped.
+template <typename T, typename Alloc>
+template <typename OutputIt>
+void mpmc_queue<T, Alloc>::release_pop(size_type pos, size_type n,
+                                       OutputIt out) {
+  size_type i = 0;
+
+  auto release = [&] {
+    cell_type* c = cell(pos + i);
+    c->value()->~value_type();
+    c->seq_.store(pos + i + mask_ + 1, std::memory_order_release);
+  };
+
+  try {
+    for (; i < n; ++i, ++out) {
+      *out = std::move(*cell(pos + i)->value());
+      release();
+    }
+  } catch (...) {
+    for (; i < n; ++i) {
+      release();
+    }
+    throw;
+  }
+}
+
+}  // namespace s21
+
+#endif  // S21_MPMC_QUEUE_H_
@@ -0,0 +1,24 @@
+#ifndef S21_PLAIN_BYTES_H_
+#define S21_PLAIN_BYTES_H_
+
+#pragma once
+
+#include <type_traits>
+
+namespace s21 {
+
+namespace details {
+
+// Types whose object bytes are exactly their value and for which any byte
+// pattern read back is a valid value: no padding, no pointers, no bool.
+// Only these are written to and read from files and streams as raw bytes.
+template <typename T>
+inline constexpr bool is_plain_bytes_v =
+    (std::is_arithmetic_v<T> && !std::is_same_v<T, bool>) ||
+    std::is_enum_v<T>;
+
+}  // namespace details
+
+}  // namespace s21
+
+#endif  // S21_PLAIN_BYTES_H_
@@ -7,11 +7,11 @@
 #include <iostream>
 #include <limits>
 
-#include "s21_list.h"
+#include "s21_ring_buffer.h"
 
 namespace s21 {
 
-template <typename T, typename queue_list = s21::list<T>>
+template <typename T, typename queue_list = s21::ring_buffer<T>>
 class queue {
  public:
   using value_type = typename queue_list::value_type;
@@ -0,0 +1,127 @@
+#ifndef S21_RADIX_SORT_H_
+#define S21_RADIX_SORT_H_
+
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <functional>
+#include <limits>
+#include <type_traits>
+#include <utility>
+
+namespace s21 {
+
+namespace details {
+
+template <std::size_t Size>
+struct radix_bits;
+
+template <>
+struct radix_bits<1> {
+  using type = std::uint8_t;
+};
+
+template <>
+struct radix_bits<2> {
+  using type = std::uint16_t;
+};
+
+template <>
+struct radix_bits<4> {
+  using type = std::uint32_t;
+};
+
+template <>
+struct radix_bits<8> {
+  using type = std::uint64_t;
+};
+
+// Integers and IEEE floats up to 64 bits.
+template <typename T>
+inline constexpr bool is_radix_sortable_v =
+    std::is_integral_v<T> ||
+    (std::numeric_limits<T>::is_iec559 && (sizeof(T) == 4 || sizeof(T) == 8));
+
+// Unsigned key with the order of val: a signed integer gets its sign bit
+// flipped, a negative float all of its bits and any other float just its
+// sign bit. -0.0 comes before 0.0, NaNs go to the ends by their sign.
+template <typename T>
+typename radix_bits<sizeof(T)>::type radix_key(T val) noexcept {
+  using key_type = typename radix_bits<sizeof(T)>::type;
+  constexpr key_type sign = key_type(1) << (sizeof(T) * 8 - 1);
+
+  key_type bits;
+  std::memcpy(&bits, &val, sizeof(T));
+
+  if constexpr (std::is_floating_point_v<T>) {
+    return bits & sign ? key_type(~bits) : key_type(bits | sign);
+  } else if constexpr (std::is_signed_v<T>) {
+    return key_type(bits ^ sign);
+  } else {
+    return bits;
+  }
+}
+
+static constexpr std::size_t radix_buckets_ = 256;
+
+// LSD radix sort of [data, data + n) by key_of(element), which must be an
+// integer or an IEEE float, one byte per pass. The elements move back and
+// forth between data and scratch, which holds n elements. One read counts
+// every byte of every key up front, so that passes whose byte is the same
+// for all keys are skipped. Stable.
+template <typename T, typename KeyOf>
+void radix_sort(T* data, T* scratch, std::size_t n, KeyOf key_of) {
+  constexpr std::size_t passes = sizeof(radix_key(key_of(*data)));
+  constexpr std::size_t mask = radix_buckets_ - 1;
+
+  std::size_t counts[passes][radix_buckets_] = {};
+  T* src = data;
+  T* dst = scratch;
+
+  for (std::size_t i = 0; i < n; ++i) {
+    const auto key = radix_key(key_of(data[i]));
+
+    for (std::size_t pass = 0; pass < passes; ++pass) {
+      ++counts[pass][std::size_t(key >> pass * 8) & mask];
+    }
+  }
+
+  for (std::size_t pass = 0; pass < passes; ++pass) {
+    std::size_t* next = counts[pass];
+
+    if (std::find(next, next + radix_buckets_, n) != next + radix_buckets_) {
+      continue;
+    }
+
+    for (std::size_t d = 0, pos = 0; d < radix_buckets_; ++d) {
+      pos += std::exchange(next[d], pos);
+    }
+    for (std::size_t i = 0; i < n; ++i) {
+      const auto key = radix_key(key_of(src[i]));
+
+      dst[next[std::size_t(key >> pass * 8) & mask]++] = std::move(src[i]);
+    }
+    std::swap(src, dst);
+  }
+
+  if (src != data) {
+    std::move(src, src + n, data);
+  }
+}
+
+// std::less on keys radix sort orders the same way. Floats only when the
+// order of equal keys is free: radix sort puts -0.0 before 0.0.
+template <typename T, typename Compare>
+inline constexpr bool is_radix_order_v =
+    is_radix_sortable_v<T> &&
+    (std::is_same_v<Compare, std::less<>> ||
+     std::is_same_v<Compare, std::less<T>>);
+
+}  // namespace details
+
+}  // namespace s21
+
+#endif  // S21_RADIX_SORT_H_
@@ -0,0 +1,571 @@
+#ifndef S21_RING_BUFFER_H_
+#define S21_RING_BUFFER_H_
+
+#pragma once
+
+#include <algorithm>
+#include <initializer_list>
+#include <iterator>
+#include <memory>
+#include <stdexcept>
+
+namespace s21 {
+
+namespace details {
+
+// Index-based iterator over a power-of-two circular buffer. pos_ is the
+// unwrapped position (head + offset), it is wrapped with mask_ on access.
+// head is always kept below the capacity, so pos_ never overflows.
+template <typename T, typename Pointer, typename Reference>
+class ring_buffer_iterator {
+ private:
+  using this_type = ring_buffer_iterator<T, Pointer, Reference>;
+
+  using iterator = ring_buffer_iterator<T, T*, T&>;
+  using const_iterator = ring_buffer_iterator<T, const T*, const T&>;
+
+ public:
+  using size_type = std::size_t;
+  using difference_type = std::ptrdiff_t;
+  using value_type = T;
+  using pointer = Pointer;
+  using reference = Reference;
+  using iterator_category = std::random_access_iterator_tag;
+
+ public:
+  ring_buffer_iterator(const T* buf, size_type mask, size_type pos) noexcept
+      : buf_(const_cast<T*>(buf)), mask_(mask), pos_(pos) {}
+  ring_buffer_iterator(const iterator& o) noexcept
+      : buf_(o.buf_), mask_(o.mask_), pos_(o.pos_) {}
+  ring_buffer_iterator(const const_iterator& o) noexcept
+      : buf_(o.buf_), mask_(o.mask_), pos_(o.pos_) {}
+  this_type& operator=(const iterator& o) noexcept {
+    return buf_ = o.buf_, mask_ = o.mask_, pos_ = o.pos_, *this;
+  }
+  this_type& operator=(const const_iterator& o) noexcept {
+    return buf_ = o.buf_, mask_ = o.mask_, pos_ = o.pos_, *this;
+  }
+
+  reference operator*() const noexcept { return buf_[pos_ & mask_]; }
+  pointer operator->() const noexcept { return &buf_[pos_ & mask_]; }
+  reference operator[](difference_type n) const noexcept {
+    return buf_[(pos_ + n) & mask_];
+  }
+
+  this_type& operator++() noexcept { return ++pos_, *this; }
+  this_type operator++(int) noexcept { return this_type(buf_, mask_, pos_++); }
+  this_type& operator--() noexcept { return --pos_, *this; }
+  this_type operator--(int) noexcept { return this_type(buf_, mask_, pos_--); }
+
+  this_type& operator+=(difference_type n) noexcept { return pos_ += n, *this; }
+  this_type& operator-=(difference_type n) noexcept { return pos_ -= n, *this; }
+  this_type operator+(difference_type n) const noexcept {
+    return this_type(buf_, mask_, pos_ + n);
+  }
+  this_type operator-(difference_type n) const noexcept {
+    return this_type(buf_, mask_, pos_ - n);
+  }
+
+ public:
+  T* buf_;
+  size_type mask_;
+  size_type pos_;
+};
+
+template <typename T, typename LPointer, typename LReference, typename RPointer,
+          typename RReference>
+inline bool operator==(
+    const ring_buffer_iterator<T, LPointer, LReference>& lhs,
+    const ring_buffer_iterator<T, RPointer, RReference>& rhs) noexcept {
+  return lhs.pos_ == rhs.pos_;
+}
+
+template <typename T, typename LPointer, typename LReference, typename RPointer,
+          typename RReference>
+inline bool operator!=(
+    const ring_buffer_iterator<T, LPointer, LReference>& lhs,
+    const ring_buffer_iterator<T, RPointer, RReference>& rhs) noexcept {
+  return lhs.pos_ != rhs.pos_;
+}
+
+template <typename T, typename LPointer, typename LReference, typename RPointer,
+          typename RReference>
+inline bool operator<(
+    const ring_buffer_iterator<T, LPointer, LReference>& lhs,
+    const ring_buffer_iterator<T, RPointer, RReference>& rhs) noexcept {
+  return lhs.pos_ < rhs.pos_;
+}
+
+template <typename T, typename LPointer, typename LReference, typename RPointer,
+          typename RReference>
+inline std::ptrdiff_t operator-(
+    const ring_buffer_iterator<T, LPointer, LReference>& lhs,
+    const ring_buffer_iterator<T, RPointer, RReference>& rhs) noexcept {
+  return std::ptrdiff_t(lhs.pos_ - rhs.pos_);
+}
+
+template <typename T, typename LPointer, typename LReference, typename RPointer,
+          typename RReference>
+inline bool operator>(
+    const ring_buffer_iterator<T, LPointer, LReference>& lhs,
+    const ring_buffer_iterator<T, RPointer, RReference>& rhs) noexcept {
+  return rhs < lhs;
+}
+
+template <typename T, typename LPointer, typename LReference, typename RPointer,
+          typename RReference>
+inline bool operator<=(
+    const ring_buffer_iterator<T, LPointer, LReference>& lhs,
+    const ring_buffer_iterator<T, RPointer, RReference>& rhs) noexcept {
+  return !(rhs < lhs);
+}
+
+template <typename T, typename LPointer, typename LReference, typename RPointer,
+          typename RReference>
+inline bool operator>=(
+    const ring_buffer_iterator<T, LPointer, LReference>& lhs,
+    const ring_buffer_iterator<T, RPointer, RReference>& rhs) noexcept {
+  return !(lhs < rhs);
+}
+
+template <typename T, typename Pointer, typename Reference>
+inline ring_buffer_iterator<T, Pointer, Reference> operator+(
+    std::ptrdiff_t n,
+    const ring_buffer_iterator<T, Pointer, Reference>& it) noexcept {
+  return it + n;
+}
+
+template <typename T, typename Alloc>
+class ring_buffer_base {
+ private:
+  using this_type = ring_buffer_base<T, Alloc>;
+
+  using allocator_type = Alloc;
+  using allocator_traits = std::allocator_traits<allocator_type>;
+
+ protected:
+  using size_type = std::size_t;
+  using difference_type = std::ptrdiff_t;
+  using value_type = T;
+  using reference = T&;
+  using const_reference = const T&;
+  using pointer = T*;
+  using const_pointer = const T*;
+
+ protected:
+  ring_buffer_base() : alloc_(), buf_(nullptr), head_(), size_(), cap_() {}
+  ring_buffer_base(const this_type& o);
+  ring_buffer_base(this_type&& o) noexcept;
+  this_type& operator=(const this_type& o);
+  this_type& operator=(this_type&& o) noexcept;
+  ~ring_buffer_base() { clear(); }
+
+  pointer allocate(size_type n) {
+    return allocator_traits::allocate(alloc_, n);
+  }
+  void deallocate(pointer p, size_type n) {
+    allocator_traits::deallocate(alloc_, p, n);
+  }
+
+  template <class... Args>
+  void construct(pointer p, Args&&... args) {
+    allocator_traits::construct(alloc_, p, std::forward<Args>(args)...);
+  }
+  void destroy(pointer p) { allocator_traits::destroy(alloc_, p); }
+
+  pointer slot(size_type pos) const noexcept {
+    return buf_ + (pos & (cap_ - 1));
+  }
+  void relocate(size_type cap);
+
+  void clear();
+
+ protected:
+  static constexpr size_type max_size_ = (size_type(0) - 1) / 2 + 1;
+  static constexpr size_type min_capacity_ = 16;
+
+  allocator_type alloc_;
+  pointer buf_;
+  size_type head_;
+  size_type size_;
+  size_type cap_;
+};
+
+template <typename T, typename Alloc>
+ring_buffer_base<T, Alloc>::ring_buffer_base(const this_type& o)
+    : ring_buffer_base() {
+  alloc_ = o.alloc_;
+
+  if (o.size_ > 0) {
+    relocate(o.cap_);
+
+    for (; size_ < o.size_; ++size_) {
+      construct(buf_ + size_, *o.slot(o.head_ + size_));
+    }
+  }
+}
+
+template <typename T, typename Alloc>
+ring_buffer_base<T, Alloc>::ring_buffer_base(this_type&& o) noexcept
+    : alloc_(std::move(o.alloc_)),
+      buf_(o.buf_),
+      head_(o.head_),
+      size_(o.size_),
+      cap_(o.cap_) {
+  o.buf_ = nullptr;
+  o.head_ = o.size_ = o.cap_ = 0;
+}
+
+template <typename T, typename Alloc>
+typename ring_buffer_base<T, Alloc>::this_type&
+ring_buffer_base<T, Alloc>::operator=(const this_type& o) {
+  if (&o != this) {
+    this_type res(o);
+    *this = std::move(res);
+  }
+
+  return *this;
+}
+
+template <typename T, typename Alloc>
+typename ring_buffer_base<T, Alloc>::this_type&
+ring_buffer_base<T, Alloc>::operator=(this_type&& o) noexcept {
+  if (&o != this) {
+    clear();
+
+    alloc_ = std::move(o.alloc_);
+    buf_ = o.buf_;
+    head_ = o.head_;
+    size_ = o.size_;
+    cap_ = o.cap_;
+
+    o.buf_ = nullptr;
+    o.head_ = o.size_ = o.cap_ = 0;
+  }
+
+  return *this;
+}
+
+// Moves the live elements into a fresh buffer of cap slots (a power of two)
+// so that they start at index 0. The old elements are destroyed only once
+// all are in place, so a throwing copy leaves the buffer as it was.
+template <typename T, typename Alloc>
+void ring_buffer_base<T, Alloc>::relocate(size_type cap) {
+  auto deleter = [this, cap](pointer ptr) -> void { deallocate(ptr, cap); };
+  std::unique_ptr<value_type, decltype(deleter)> res(allocate(cap), deleter);
+  size_type built = 0;
+
+  try {
+    for (; built < size_; ++built) {
+      construct(res.get() + built, std::move_if_noexcept(*slot(head_ + built)));
+    }
+  } catch (...) {
+    while (built != 0) {
+      destroy(res.get() + --built);
+    }
+    throw;
+  }
+
+  for (size_type i = 0; i < size_; ++i) {
+    destroy(slot(head_ + i));
+  }
+
+  if (buf_) {
+    deallocate(buf_, cap_);
+  }
+
+  buf_ = res.release();
+  head_ = 0;
+  cap_ = cap;
+}
+
+template <typename T, typename Alloc>
+void ring_buffer_base<T, Alloc>::clear() {
+  for (size_type i = 0; i < size_; ++i) {
+    destroy(slot(head_ + i));
+  }
+
+  if (buf_) {
+    deallocate(buf_, cap_);
+  }
+  buf_ = nullptr;
+  head_ = size_ = cap_ = 0;
+}
+
+}  // namespace details
+
+// Growable circular buffer over a single contiguous allocation. Capacity is
+// kept a power of two so wrapping is a mask, and push/pop on either end never
+// touch the allocator once the buffer reached its working size.
+template <typename T, typename Alloc = std::allocator<T>>
+class ring_buffer : public details::ring_buffer_base<T, Alloc> {
+ private:
+  using base_type = details::ring_buffer_base<T, Alloc>;
+  using this_type = ring_buffer<T, Alloc>;
+
+  using base_type::alloc_;
+  using base_type::buf_;
+  using base_type::cap_;
+  using base_type::construct;
+  using base_type::destroy;
+  using base_type::head_;
+  using base_type::max_size_;
+  using base_type::min_capacity_;
+  using base_type::relocate;
+  using base_type::size_;
+  using base_type::slot;
+
+ public:
+  using typename base_type::const_pointer;
+  using typename base_type::const_reference;
+  using typename base_type::difference_type;
+  using typename base_type::pointer;
+  using typename base_type::reference;
+  using typename base_type::size_type;
+  using typename base_type::value_type;
+  using iterator = details::ring_buffer_iterator<T, T*, T&>;
+  using const_iterator = details::ring_buffer_iterator<T, const T*, const T&>;
+
+ public:
+  ring_buffer() : base_type() {}
+  ring_buffer(const std::initializer_list<value_type>& items);
+  ring_buffer(const this_type& o) : base_type(o) {}
+  ring_buffer(this_type&& o) noexcept : base_type(std::move(o)) {}
+  this_type& operator=(const this_type& o) {
+    return base_type::operator=(o), *this;
+  }
+  this_type& operator=(this_type&& o) noexcept {
+    return base_type::operator=(std::move(o)), *this;
+  }
+  ~ring_buffer() {}
+
+  reference operator[](size_type pos) noexcept { return *slot(head_ + pos); }
+  const_reference operator[](size_type pos) const noexcept {
+    return *slot(head_ + pos);
+  }
+  reference at(size_type pos);
+  const_reference at(size_type pos) const {
+    return const_cast<this_type*>(this)->at(pos);
+  }
+
+  reference front();
+  const_reference front() const {
+    return const_cast<this_type*>(this)->front();
+  }
+  reference back();
+  const_reference back() const { return const_cast<this_type*>(this)->back(); }
+
+  iterator begin() noexcept { return iterator(buf_, cap_ - 1, head_); }
+  const_iterator begin() const noexcept {
+    return const_iterator(buf_, cap_ - 1, head_);
+  }
+  iterator end() noexcept { return iterator(buf_, cap_ - 1, head_ + size_); }
+  const_iterator end() const noexcept {
+    return const_iterator(buf_, cap_ - 1, head_ + size_);
+  }
+
+  bool empty() const noexcept { return size_ == 0; }
+  size_type size() const noexcept { return size_; }
+  constexpr size_type max_size() const noexcept { return max_size_; }
+  void reserve(size_type size);
+  size_type capacity() const noexcept { return cap_; }
+
+  void clear() noexcept;
+  void push_back(value_type&& val) { emplace_back(std::move(val)); }
+  void push_back(const_reference val) { emplace_back(val); }
+  void pop_back();
+  void push_front(value_type&& val) { emplace_front(std::move(val)); }
+  void push_front(const_reference val) { emplace_front(val); }
+  void pop_front();
+  void swap(this_type& o) noexcept { std::swap(*this, o); }
+
+  template <typename... Args>
+  reference emplace_back(Args&&... args);
+  template <typename... Args>
+  reference emplace_front(Args&&... args);
+  template <typename... Args>
+  void insert_many_back(Args&&... args);
+  template <typename... Args>
+  void insert_many_front(Args&&... args);
+
+ private:
+  void grow() { relocate(cap_ ? cap_ * 2 : size_type(min_capacity_)); }
+};
+
+template <typename T, typename Alloc>
+ring_buffer<T, Alloc>::ring_buffer(
+    const std::initializer_list<value_type>& items)
+    : base_type() {
+  reserve(items.size());
+  std::copy(items.begin(), items.end(), std::back_inserter(*this));
+}
+
+template <typename T, typename Alloc>
+typename ring_buffer<T, Alloc>::reference ring_buffer<T, Alloc>::at(
+    size_type pos) {
+  if (pos >= size_) {
+    throw std::out_of_range("s21::ring_buffer::at(). invalid pos.");
+  }
+
+  return *slot(head_ + pos);
+}
+
+template <typename T, typename Alloc>
+typename ring_buffer<T, Alloc>::reference ring_buffer<T, Alloc>::front() {
+#ifdef DEBUG
+  if (empty()) {
+    throw std::out_of_range("s21::ring_buffer::front(). buffer is empty.");
+  }
+#endif
+
+  return *slot(head_);
+}
+
+template <typename T, typename Alloc>
+typename ring_buffer<T, Alloc>::reference ring_buffer<T, Alloc>::back() {
+#ifdef DEBUG
+  if (empty()) {
+    throw std::out_of_range("s21::ring_buffer::back(). buffer is empty.");
+  }
+#endif
+
+  return *slot(head_ + size_ - 1);
+}
+
+template <typename T, typename Alloc>
+void ring_buffer<T, Alloc>::reserve(size_type size) {
+#ifdef DEBUG
+  if (size > max_size()) {
+    throw std::invalid_argument("s21::ring_buffer::reserve(). size too big.");
+  }
+#endif
+
+  if (size > cap_) {
+    size_type cap = cap_ ? cap_ : size_type(min_capacity_);
+
+    while (cap < size) {
+      cap *= 2;
+    }
+    relocate(cap);
+  }
+}
+
+template <typename T, typename Alloc>
+void ring_buffer<T, Alloc>::clear() noexcept {
+  for (size_type i = 0; i < size_; ++i) {
+    destroy(slot(head_ + i));
+  }
+  head_ = size_ = 0;
+}
+
+template <typename T, typename Alloc>
+void ring_buffer<T, Alloc>::pop_back() {
+#ifdef DEBUG
+  if (empty()) {
+    throw std::out_of_range("s21::ring_buffer::pop_back(). buffer is empty.");
+  }
+#endif
+
+  destroy(slot(head_ + --size_));
+}
+
+template <typename T, typename Alloc>
+void ring_buffer<T, Alloc>::pop_front() {
+#ifdef DEBUG
+  if (empty()) {
+    throw std::out_of_range("s21::ring_buffer::pop_front(). buffer is empty.");
+  }
+#endif
+
+  destroy(slot(head_));
+  head_ = (head_ + 1) & (cap_ - 1);
+  --size_;
+}
+
+template <typename T, typename Alloc>
+template <typename... Args>
+typename ring_buffer<T, Alloc>::reference ring_buffer<T, Alloc>::emplace_back(
+    Args&&... args) {
+  pointer p = nullptr;
+
+  if (size_ == cap_) {
+    // args may refer to an element of this buffer, build the value before
+    // the storage is relocated.
+    value_type val(std::forward<Args>(args)...);
+
+    grow();
+    p = slot(head_ + size_);
+    construct(p, std::move(val));
+  } else {
+    p = slot(head_ + size_);
+    construct(p, std::forward<Args>(args)...);
+  }
+  ++size_;
+
+  return *p;
+}
+
+template <typename T, typename Alloc>
+template <typename... Args>
+typename ring_buffer<T, Alloc>::reference ring_buffer<T, Alloc>::emplace_front(
+    Args&&... args) {
+  pointer p = nullptr;
+
+  if (size_ == cap_) {
+    value_type val(std::forward<Args>(args)...);
+
+    grow();
+    p = slot(head_ + cap_ - 1);
+    construct(p, std::move(val));
+  } else {
+    p = slot(head_ + cap_ - 1);
+    construct(p, std::forward<Args>(args)...);
+  }
+  head_ = (head_ + cap_ - 1) & (cap_ - 1);
+  ++size_;
+
+  return *p;
+}
+
+template <typename T, typename Alloc>
+template <typename... Args>
+void ring_buffer<T, Alloc>::insert_many_back(Args&&... args) {
+  if constexpr (sizeof...(Args) != 0) {
+    if (size_ + sizeof...(Args) > cap_) {
+      // As in emplace_back(), the values are built before relocating.
+      value_type vals[] = {value_type(std::forward<Args>(args))...};
+
+      reserve(size_ + sizeof...(Args));
+      for (auto& val : vals) {
+        emplace_back(std::move(val));
+      }
+      return;
+    }
+  }
+  (..., emplace_back(std::forward<Args>(args)));
+}
+
+template <typename T, typename Alloc>
+template <typename... Args>
+void ring_buffer<T, Alloc>::insert_many_front(Args&&... args) {
+  if constexpr (sizeof...(Args) != 0) {
+    if (size_ + sizeof...(Args) > cap_) {
+      value_type vals[] = {value_type(std::forward<Args>(args))...};
+
+      reserve(size_ + sizeof...(Args));
+      for (auto& val : vals) {
+        emplace_front(std::move(val));
+      }
+    } else {
+      (..., emplace_front(std::forward<Args>(args)));
+    }
+  }
+
+  for (size_type i = 0, n = sizeof...(Args); i < n / 2; ++i) {
+    std::swap(*slot(head_ + i), *slot(head_ + n - 1 - i));
+  }
+}
+
+}  // namespace s21
+
+#endif  // S21_RING_BUFFER_H_
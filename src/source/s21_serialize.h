@@ -0,0 +1,420 @@
+#ifndef S21_SERIALIZE_H_
+#define S21_SERIALIZE_H_
+
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <iterator>
+#include <istream>
+#include <ostream>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+#include <utility>
+
+#include "s21_map.h"
+#include "s21_multiset.h"
+#include "s21_plain_bytes.h"
+#include "s21_set.h"
+#include "s21_vector.h"
+
+namespace s21 {
+
+// Raw byte sink for serialize(). Small writes are gathered in a block that
+// goes to the stream buffer when full and on flush(), which the owner must
+// call: the destructor drops what is left. Throws std::runtime_error and
+// sets badbit when the stream takes fewer bytes than given.
+class binary_writer {
+ public:
+  explicit binary_writer(std::ostream& out) : out_(out), used_(0) {}
+
+  void write(const void* data, std::size_t n);
+  template <typename T>
+  void write_value(const T& val);
+  void flush() { put(buffer_, used_), used_ = 0; }
+
+ private:
+  void put(const void* data, std::size_t n);
+
+ private:
+  static constexpr std::size_t buffer_size_ = 1 << 13;
+
+  std::ostream& out_;
+  std::size_t used_;
+  char buffer_[buffer_size_];
+};
+
+// Raw byte source for deserialize(). Throws std::runtime_error and sets
+// failbit when the stream ends early.
+class binary_reader {
+ public:
+  explicit binary_reader(std::istream& in) : in_(in) {}
+
+  void read(void* data, std::size_t n);
+  template <typename T>
+  void read_value(T& val);
+
+ private:
+  std::istream& in_;
+};
+
+inline void binary_writer::write(const void* data, std::size_t n) {
+  if (n == 0) {
+    return;
+  }
+  if (used_ + n > buffer_size_) {
+    flush();
+  }
+  if (n >= buffer_size_) {
+    put(data, n);
+  } else {
+    std::memcpy(buffer_ + used_, data, n);
+    used_ += n;
+  }
+}
+
+inline void binary_writer::put(const void* data, std::size_t n) {
+  const auto count = std::streamsize(n);
+
+  if (n != 0 &&
+      out_.rdbuf()->sputn(static_cast<const char*>(data), count) != count) {
+    out_.setstate(std::ios_base::badbit);
+    throw std::runtime_error("s21::serialize(). write failed.");
+  }
+}
+
+inline void binary_reader::read(void* data, std::size_t n) {
+  const auto count = std::streamsize(n);
+
+  if (n != 0 && in_.rdbuf()->sgetn(static_cast<char*>(data), count) != count) {
+    in_.setstate(std::ios_base::failbit | std::ios_base::eofbit);
+    throw std::runtime_error("s21::deserialize(). unexpected end of stream.");
+  }
+}
+
+namespace details {
+
+template <typename>
+inline constexpr bool always_false_ = false;
+
+// Counts and lengths come from the stream, so storage for them grows by at
+// most this many bytes ahead of what was actually read: a corrupt count
+// ends in "unexpected end of stream" instead of a huge allocation.
+inline constexpr std::size_t serial_chunk_bytes_ = 1 << 20;
+
+}  // namespace details
+
+// How one element is encoded. Arithmetic and enum types are their bytes,
+// bool one byte that must be 0 or 1, strings a 64-bit length and the
+// characters, pairs their two members and a nested s21::vector its size and
+// elements. Other types, structs included, need a specialization with the
+// same three members, so padding and pointers never reach the stream;
+// fixed_size_ is the encoded size when it is the same for every value, 0
+// otherwise.
+template <typename T, typename = void>
+struct serializer {
+  static_assert(details::always_false_<T>,
+                "s21::serializer. no encoding for this type, specialize "
+                "s21::serializer<T>");
+};
+
+template <typename T>
+struct serializer<T, std::enable_if_t<details::is_plain_bytes_v<T>>> {
+  static constexpr std::size_t fixed_size_ = sizeof(T);
+
+  static void write(binary_writer& out, const T& val) {
+    out.write(&val, sizeof(T));
+  }
+  static void read(binary_reader& in, T& val) { in.read(&val, sizeof(T)); }
+};
+
+template <>
+struct serializer<bool> {
+  static constexpr std::size_t fixed_size_ = 1;
+
+  static void write(binary_writer& out, const bool& val) {
+    const std::uint8_t byte = val;
+    out.write(&byte, 1);
+  }
+  static void read(binary_reader& in, bool& val) {
+    std::uint8_t byte = 0;
+
+    in.read(&byte, 1);
+    if (byte > 1) {
+      throw std::runtime_error("s21::deserialize(). bad bool value.");
+    }
+    val = byte;
+  }
+};
+
+template <typename Char, typename Traits, typename Alloc>
+struct serializer<std::basic_string<Char, Traits, Alloc>> {
+  using string_type = std::basic_string<Char, Traits, Alloc>;
+
+  static constexpr std::size_t fixed_size_ = 0;
+
+  static void write(binary_writer& out, const string_type& val) {
+    out.write_value(std::uint64_t(val.size()));
+    out.write(val.data(), val.size() * sizeof(Char));
+  }
+  static void read(binary_reader& in, string_type& val) {
+    constexpr std::size_t chunk = details::serial_chunk_bytes_ / sizeof(Char);
+    std::uint64_t size = 0;
+
+    in.read_value(size);
+    val.clear();
+    for (std::uint64_t done = 0; done < size;) {
+      const std::size_t n =
+          std::size_t(std::min<std::uint64_t>(chunk, size - done));
+
+      val.resize(std::size_t(done) + n);
+      in.read(&val[std::size_t(done)], n * sizeof(Char));
+      done += n;
+    }
+  }
+};
+
+// The key of a map's pair<const Key, T> is read in place; deserialize()
+// only does that on pairs it owns.
+template <typename First, typename Second>
+struct serializer<std::pair<First, Second>> {
+  using first_serializer = serializer<std::remove_const_t<First>>;
+  using second_serializer = serializer<Second>;
+
+  static constexpr std::size_t fixed_size_ =
+      first_serializer::fixed_size_ && second_serializer::fixed_size_
+          ? first_serializer::fixed_size_ + second_serializer::fixed_size_
+          : 0;
+
+  static void write(binary_writer& out, const std::pair<First, Second>& val) {
+    first_serializer::write(out, val.first);
+    second_serializer::write(out, val.second);
+  }
+  static void read(binary_reader& in, std::pair<First, Second>& val) {
+    first_serializer::read(in, const_cast<std::remove_const_t<First>&>(
+                                   val.first));
+    second_serializer::read(in, val.second);
+  }
+};
+
+template <typename T, typename Alloc>
+struct serializer<vector<T, Alloc>> {
+  static constexpr std::size_t fixed_size_ = 0;
+
+  static void write(binary_writer& out, const vector<T, Alloc>& val);
+  static void read(binary_reader& in, vector<T, Alloc>& val);
+};
+
+template <typename T>
+void binary_writer::write_value(const T& val) {
+  serializer<T>::write(*this, val);
+}
+
+template <typename T>
+void binary_reader::read_value(T& val) {
+  serializer<T>::read(*this, val);
+}
+
+namespace details {
+
+// Stream layout, in host byte order:
+//   u32 magic "S21C", u16 version, u8 kind, u8 reserved (0),
+//   u32 fixed size of an element (0 when variable), u64 element count,
+//   then the elements, sorted for set, multiset and map.
+// Version 1 is the only one so far; readers reject later versions.
+inline constexpr std::uint32_t serial_magic_ = 0x43313253;
+inline constexpr std::uint16_t serial_version_ = 1;
+
+enum class serial_kind : std::uint8_t { vector = 1, set, multiset, map };
+
+// Elements that are their own bytes move in blocks rather than one by one.
+template <typename T>
+inline constexpr bool is_bulk_serializable_v = is_plain_bytes_v<T>;
+
+template <typename Value>
+void write_header(binary_writer& out, serial_kind kind, std::size_t size) {
+  out.write_value(serial_magic_);
+  out.write_value(serial_version_);
+  out.write_value(std::uint8_t(kind));
+  out.write_value(std::uint8_t(0));
+  out.write_value(std::uint32_t(serializer<Value>::fixed_size_));
+  out.write_value(std::uint64_t(size));
+}
+
+// Checks the header against what the caller expects and returns the count.
+template <typename Value>
+std::uint64_t read_header(binary_reader& in, serial_kind kind) {
+  std::uint32_t magic = 0;
+  std::uint16_t version = 0;
+  std::uint8_t stored_kind = 0;
+  std::uint8_t reserved = 0;
+  std::uint32_t fixed_size = 0;
+  std::uint64_t size = 0;
+
+  in.read_value(magic);
+  if (magic != serial_magic_) {
+    throw std::runtime_error("s21::deserialize(). not an s21 stream.");
+  }
+  in.read_value(version);
+  if (version == 0 || version > serial_version_) {
+    throw std::runtime_error("s21::deserialize(). unsupported version.");
+  }
+  in.read_value(stored_kind);
+  in.read_value(reserved);
+  if (stored_kind != std::uint8_t(kind)) {
+    throw std::runtime_error("s21::deserialize(). wrong container kind.");
+  }
+  in.read_value(fixed_size);
+  if (fixed_size != serializer<Value>::fixed_size_) {
+    throw std::runtime_error("s21::deserialize(). wrong element type.");
+  }
+  in.read_value(size);
+
+  return size;
+}
+
+template <typename Value, typename InputIt>
+void write_values(binary_writer& out, InputIt first, InputIt last) {
+  for (; first != last; ++first) {
+    out.write_value(*first);
+  }
+}
+
+// Reads in chunks of serial_chunk_bytes_, so memory follows the data
+// actually present rather than the count.
+template <typename Value, typename Alloc>
+void read_values(binary_reader& in, std::uint64_t size,
+                 vector<Value, Alloc>& res) {
+  constexpr std::size_t chunk =
+      std::max<std::size_t>(serial_chunk_bytes_ / sizeof(Value), 1);
+  vector<Value, Alloc> values;
+
+  values.reserve(std::size_t(std::min<std::uint64_t>(size, chunk)));
+  if constexpr (is_bulk_serializable_v<Value>) {
+    for (std::uint64_t done = 0; done < size;) {
+      const std::size_t n =
+          std::size_t(std::min<std::uint64_t>(chunk, size - done));
+
+      for (std::size_t i = 0; i < n; ++i) {
+        values.emplace_back();
+      }
+      in.read(values.data() + done, n * sizeof(Value));
+      done += n;
+    }
+  } else {
+    for (std::uint64_t i = 0; i < size; ++i) {
+      values.emplace_back();
+      in.read_value(values.back());
+    }
+  }
+  res = std::move(values);
+}
+
+template <typename Value, typename Tree>
+void serialize_tree(std::ostream& out, const Tree& tree, serial_kind kind) {
+  binary_writer writer(out);
+
+  write_header<Value>(writer, kind, tree.size());
+  write_values<Value>(writer, tree.begin(), tree.end());
+  writer.flush();
+}
+
+// The elements arrive sorted, so assign_unsorted() links them into a
+// balanced tree in linear time without sorting or rebalancing.
+template <typename Value, typename Tree>
+void deserialize_tree(std::istream& in, Tree& tree, serial_kind kind) {
+  binary_reader reader(in);
+  vector<Value> values;
+
+  read_values(reader, read_header<Value>(reader, kind), values);
+  tree.assign_unsorted(std::make_move_iterator(values.begin()),
+                       std::make_move_iterator(values.end()));
+}
+
+}  // namespace details
+
+template <typename T, typename Alloc>
+void serializer<vector<T, Alloc>>::write(binary_writer& out,
+                                         const vector<T, Alloc>& val) {
+  out.write_value(std::uint64_t(val.size()));
+  if constexpr (details::is_bulk_serializable_v<T>) {
+    out.write(val.data(), val.size() * sizeof(T));
+  } else {
+    details::write_values<T>(out, val.begin(), val.end());
+  }
+}
+
+template <typename T, typename Alloc>
+void serializer<vector<T, Alloc>>::read(binary_reader& in,
+                                        vector<T, Alloc>& val) {
+  std::uint64_t size = 0;
+
+  in.read_value(size);
+  details::read_values(in, size, val);
+}
+
+// Binary snapshots of containers in a versioned format (see
+// details::write_header). A vector of arithmetic or enum elements is written
+// and read with a single block copy. Ordered containers are stored in order
+// and rebuilt in linear time. deserialize() replaces the contents of c, which
+// stay unchanged when it throws std::runtime_error on a malformed, truncated
+// or mismatched stream.
+template <typename T, typename Alloc>
+void serialize(std::ostream& out, const vector<T, Alloc>& c) {
+  binary_writer writer(out);
+
+  details::write_header<T>(writer, details::serial_kind::vector, c.size());
+  if constexpr (details::is_bulk_serializable_v<T>) {
+    writer.write(c.data(), c.size() * sizeof(T));
+  } else {
+    details::write_values<T>(writer, c.begin(), c.end());
+  }
+  writer.flush();
+}
+
+template <typename T, typename Alloc>
+void deserialize(std::istream& in, vector<T, Alloc>& c) {
+  binary_reader reader(in);
+
+  details::read_values(
+      reader, details::read_header<T>(reader, details::serial_kind::vector),
+      c);
+}
+
+template <typename Key, typename Compare, typename Alloc>
+void serialize(std::ostream& out, const set<Key, Compare, Alloc>& c) {
+  details::serialize_tree<Key>(out, c, details::serial_kind::set);
+}
+
+template <typename Key, typename Compare, typename Alloc>
+void deserialize(std::istream& in, set<Key, Compare, Alloc>& c) {
+  details::deserialize_tree<Key>(in, c, details::serial_kind::set);
+}
+
+template <typename Key, typename Compare, typename Alloc>
+void serialize(std::ostream& out, const multiset<Key, Compare, Alloc>& c) {
+  details::serialize_tree<Key>(out, c, details::serial_kind::multiset);
+}
+
+template <typename Key, typename Compare, typename Alloc>
+void deserialize(std::istream& in, multiset<Key, Compare, Alloc>& c) {
+  details::deserialize_tree<Key>(in, c, details::serial_kind::multiset);
+}
+
+template <typename Key, typename T, typename Compare, typename Alloc>
+void serialize(std::ostream& out, const map<Key, T, Compare, Alloc>& c) {
+  details::serialize_tree<std::pair<Key, T>>(out, c, details::serial_kind::map);
+}
+
+template <typename Key, typename T, typename Compare, typename Alloc>
+void deserialize(std::istream& in, map<Key, T, Compare, Alloc>& c) {
+  details::deserialize_tree<std::pair<Key, T>>(in, c,
+                                               details::serial_kind::map);
+}
+
+}  // namespace s21
+
+#endif  // S21_SERIALIZE_H_
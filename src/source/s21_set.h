@@ -3,6 +3,8 @@
 
 #pragma once
 
+#include <vector>
+
 #include "../rb_tree/s21_rb_tree.h"
 
 namespace s21 {
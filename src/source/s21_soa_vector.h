@@ -0,0 +1,496 @@
+#ifndef S21_SOA_VECTOR_H_
+#define S21_SOA_VECTOR_H_
+
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <initializer_list>
+#include <iterator>
+#include <stdexcept>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
+#include "s21_span.h"
+#include "s21_vector.h"
+
+namespace s21 {
+
+// Row of a soa_vector: references to one element of every field, standing in
+// for value_type& the way vector<bool>::reference stands in for bool&.
+// Assignment writes through, swap() swaps the fields, and it converts to
+// value_type. Structured bindings give the field references:
+//   auto [x, v] = particles[i];
+template <typename... Ts>
+class soa_reference {
+ private:
+  using this_type = soa_reference<Ts...>;
+
+ public:
+  using value_type = std::tuple<std::remove_const_t<Ts>...>;
+
+ public:
+  explicit soa_reference(Ts&... fields) noexcept : fields_(fields...) {}
+  soa_reference(const this_type& o) noexcept = default;
+  // A row of a soa_vector converts to a row of a const one.
+  template <typename... Us,
+            typename = std::enable_if_t<
+                (std::is_convertible_v<Us&, Ts&> && ...) &&
+                !std::is_same_v<soa_reference<Us...>, this_type>>>
+  soa_reference(const soa_reference<Us...>& o) noexcept
+      : fields_(o.fields()) {}
+
+  this_type& operator=(const this_type& o) {
+    return fields_ = o.fields_, *this;
+  }
+  this_type& operator=(this_type&& o) {
+    return assign(std::move(o), std::index_sequence_for<Ts...>()), *this;
+  }
+  this_type& operator=(const value_type& val) {
+    return fields_ = val, *this;
+  }
+  this_type& operator=(value_type&& val) {
+    return fields_ = std::move(val), *this;
+  }
+
+  operator value_type() const& { return value_type(fields_); }
+  operator value_type() && {
+    return move_out(std::index_sequence_for<Ts...>());
+  }
+
+  template <std::size_t I>
+  auto& get() const noexcept {
+    return std::get<I>(fields_);
+  }
+  const std::tuple<Ts&...>& fields() const noexcept { return fields_; }
+
+  friend void swap(this_type lhs, this_type rhs) {
+    lhs.swap_fields(rhs, std::index_sequence_for<Ts...>());
+  }
+
+ private:
+  template <std::size_t... I>
+  void assign(this_type&& o, std::index_sequence<I...>) {
+    ((std::get<I>(fields_) = std::move(std::get<I>(o.fields_))), ...);
+  }
+  template <std::size_t... I>
+  value_type move_out(std::index_sequence<I...>) {
+    return value_type(std::move(std::get<I>(fields_))...);
+  }
+  template <std::size_t... I>
+  void swap_fields(this_type& o, std::index_sequence<I...>) {
+    using std::swap;
+    (swap(std::get<I>(fields_), std::get<I>(o.fields_)), ...);
+  }
+
+ private:
+  std::tuple<Ts&...> fields_;
+};
+
+// Rows compare like tuples of their fields, with each other and with
+// value_type, so std::sort and std::find work on them.
+template <typename... Ts, typename... Us>
+bool operator==(const soa_reference<Ts...>& lhs,
+                const soa_reference<Us...>& rhs) {
+  return lhs.fields() == rhs.fields();
+}
+
+template <typename... Ts, typename... Us>
+bool operator==(const soa_reference<Ts...>& lhs, const std::tuple<Us...>& rhs) {
+  return lhs.fields() == rhs;
+}
+
+template <typename... Ts, typename... Us>
+bool operator==(const std::tuple<Us...>& lhs, const soa_reference<Ts...>& rhs) {
+  return lhs == rhs.fields();
+}
+
+template <typename... Ts, typename... Us>
+bool operator!=(const soa_reference<Ts...>& lhs,
+                const soa_reference<Us...>& rhs) {
+  return !(lhs == rhs);
+}
+
+template <typename... Ts, typename... Us>
+bool operator!=(const soa_reference<Ts...>& lhs, const std::tuple<Us...>& rhs) {
+  return !(lhs == rhs);
+}
+
+template <typename... Ts, typename... Us>
+bool operator!=(const std::tuple<Us...>& lhs, const soa_reference<Ts...>& rhs) {
+  return !(lhs == rhs);
+}
+
+template <typename... Ts, typename... Us>
+bool operator<(const soa_reference<Ts...>& lhs,
+               const soa_reference<Us...>& rhs) {
+  return lhs.fields() < rhs.fields();
+}
+
+template <typename... Ts, typename... Us>
+bool operator<(const soa_reference<Ts...>& lhs, const std::tuple<Us...>& rhs) {
+  return lhs.fields() < rhs;
+}
+
+template <typename... Ts, typename... Us>
+bool operator<(const std::tuple<Us...>& lhs, const soa_reference<Ts...>& rhs) {
+  return lhs < rhs.fields();
+}
+
+namespace details {
+
+// Random access iterator over the rows of a soa_vector: one pointer per field
+// and a position. Dereferencing gives a soa_reference by value.
+template <typename... Ts>
+class soa_iterator {
+ private:
+  using this_type = soa_iterator<Ts...>;
+
+ public:
+  using iterator_category = std::random_access_iterator_tag;
+  using value_type = std::tuple<std::remove_const_t<Ts>...>;
+  using difference_type = std::ptrdiff_t;
+  using reference = soa_reference<Ts...>;
+  using pointer = void;
+
+ public:
+  soa_iterator() noexcept : columns_(), pos_(0) {}
+  soa_iterator(Ts*... columns, difference_type pos) noexcept
+      : columns_(columns...), pos_(pos) {}
+  template <typename... Us,
+            typename = std::enable_if_t<
+                (std::is_convertible_v<Us*, Ts*> && ...) &&
+                !std::is_same_v<soa_iterator<Us...>, this_type>>>
+  soa_iterator(const soa_iterator<Us...>& o) noexcept
+      : columns_(o.columns()), pos_(o.pos()) {}
+
+  reference operator*() const noexcept {
+    return row(std::index_sequence_for<Ts...>());
+  }
+  reference operator[](difference_type n) const noexcept {
+    return *(*this + n);
+  }
+
+  this_type& operator++() noexcept { return ++pos_, *this; }
+  this_type operator++(int) noexcept {
+    this_type res(*this);
+    ++pos_;
+    return res;
+  }
+  this_type& operator--() noexcept { return --pos_, *this; }
+  this_type operator--(int) noexcept {
+    this_type res(*this);
+    --pos_;
+    return res;
+  }
+  this_type& operator+=(difference_type n) noexcept { return pos_ += n, *this; }
+  this_type& operator-=(difference_type n) noexcept { return pos_ -= n, *this; }
+
+  friend this_type operator+(this_type it, difference_type n) noexcept {
+    return it += n;
+  }
+  friend this_type operator+(difference_type n, this_type it) noexcept {
+    return it += n;
+  }
+  friend this_type operator-(this_type it, difference_type n) noexcept {
+    return it -= n;
+  }
+  friend difference_type operator-(const this_type& lhs,
+                                   const this_type& rhs) noexcept {
+    return lhs.pos_ - rhs.pos_;
+  }
+
+  friend bool operator==(const this_type& lhs, const this_type& rhs) noexcept {
+    return lhs.pos_ == rhs.pos_;
+  }
+  friend bool operator!=(const this_type& lhs, const this_type& rhs) noexcept {
+    return lhs.pos_ != rhs.pos_;
+  }
+  friend bool operator<(const this_type& lhs, const this_type& rhs) noexcept {
+    return lhs.pos_ < rhs.pos_;
+  }
+  friend bool operator>(const this_type& lhs, const this_type& rhs) noexcept {
+    return lhs.pos_ > rhs.pos_;
+  }
+  friend bool operator<=(const this_type& lhs, const this_type& rhs) noexcept {
+    return lhs.pos_ <= rhs.pos_;
+  }
+  friend bool operator>=(const this_type& lhs, const this_type& rhs) noexcept {
+    return lhs.pos_ >= rhs.pos_;
+  }
+
+  const std::tuple<Ts*...>& columns() const noexcept { return columns_; }
+  difference_type pos() const noexcept { return pos_; }
+
+ private:
+  template <std::size_t... I>
+  reference row(std::index_sequence<I...>) const noexcept {
+    return reference(std::get<I>(columns_)[pos_]...);
+  }
+
+ private:
+  std::tuple<Ts*...> columns_;
+  difference_type pos_;
+};
+
+}  // namespace details
+
+// Structure of arrays: a sequence of rows (Ts...) with every field kept in
+// its own s21::vector, so a loop over one field streams through memory that
+// holds nothing else. The columns grow together and always have equal sizes.
+// field<I>() is the span of field I, and the row iterators let algorithms
+// that take value_type& work on whole rows through soa_reference.
+template <typename... Ts>
+class soa_vector {
+  static_assert(sizeof...(Ts) > 0, "s21::soa_vector needs a field");
+
+ private:
+  using this_type = soa_vector<Ts...>;
+  using columns_type = std::tuple<vector<Ts>...>;
+
+ public:
+  using value_type = std::tuple<Ts...>;
+  using size_type = std::size_t;
+  using difference_type = std::ptrdiff_t;
+  using reference = soa_reference<Ts...>;
+  using const_reference = soa_reference<const Ts...>;
+  using iterator = details::soa_iterator<Ts...>;
+  using const_iterator = details::soa_iterator<const Ts...>;
+
+  template <std::size_t I>
+  using field_type = std::tuple_element_t<I, value_type>;
+
+  static constexpr double growth_factor_ = vector<int>::growth_factor_;
+
+ public:
+  soa_vector() : columns_() {}
+  explicit soa_vector(size_type n) : columns_(vector<Ts>(n)...) {}
+  soa_vector(size_type n, const Ts&... vals)
+      : columns_(vector<Ts>(n, vals)...) {}
+  soa_vector(const std::initializer_list<value_type>& items);
+
+  reference operator[](size_type pos) noexcept { return begin()[pos]; }
+  const_reference operator[](size_type pos) const noexcept {
+    return begin()[pos];
+  }
+  reference at(size_type pos);
+  const_reference at(size_type pos) const {
+    return const_cast<this_type*>(this)->at(pos);
+  }
+  reference front();
+  const_reference front() const {
+    return const_cast<this_type*>(this)->front();
+  }
+  reference back();
+  const_reference back() const { return const_cast<this_type*>(this)->back(); }
+
+  // Field I of every row, contiguous.
+  template <std::size_t I>
+  span<field_type<I>> field() noexcept {
+    return span<field_type<I>>(std::get<I>(columns_));
+  }
+  template <std::size_t I>
+  span<const field_type<I>> field() const noexcept {
+    return span<const field_type<I>>(std::get<I>(columns_));
+  }
+
+  iterator begin() noexcept { return make_iterator<iterator>(columns_, 0); }
+  const_iterator begin() const noexcept {
+    return make_iterator<const_iterator>(columns_, 0);
+  }
+  iterator end() noexcept { return begin() + size(); }
+  const_iterator end() const noexcept { return begin() + size(); }
+
+  bool empty() const noexcept { return size() == 0; }
+  size_type size() const noexcept { return std::get<0>(columns_).size(); }
+  size_type max_size() const noexcept {
+    return std::get<0>(columns_).max_size();
+  }
+  void reserve(size_type size);
+  size_type capacity() const noexcept;
+  void shrink_to_fit();
+
+  void clear() noexcept;
+  void push_back(const value_type& val) { emplace_back_row(val); }
+  void push_back(value_type&& val) { emplace_back_row(std::move(val)); }
+  // One argument per field.
+  template <typename... Args>
+  reference emplace_back(Args&&... args);
+  void pop_back();
+  void swap(this_type& o) noexcept { std::swap(columns_, o.columns_); }
+
+ private:
+  template <typename Iterator, typename Columns>
+  static Iterator make_iterator(Columns& columns, difference_type pos) {
+    return std::apply(
+        [pos](auto&... column) { return Iterator(column.data()..., pos); },
+        columns);
+  }
+
+  template <typename Row>
+  void emplace_back_row(Row&& row) {
+    std::apply(
+        [this](auto&&... fields) {
+          emplace_back(std::forward<decltype(fields)>(fields)...);
+        },
+        std::forward<Row>(row));
+  }
+
+  template <std::size_t... I>
+  void pop_back_first(size_type n, std::index_sequence<I...>) noexcept {
+    ((I < n ? std::get<I>(columns_).pop_back() : void()), ...);
+  }
+
+ private:
+  columns_type columns_;
+};
+
+template <typename... Ts>
+soa_vector<Ts...>::soa_vector(const std::initializer_list<value_type>& items)
+    : columns_() {
+  reserve(items.size());
+  for (const auto& item : items) {
+    push_back(item);
+  }
+}
+
+template <typename... Ts>
+typename soa_vector<Ts...>::reference soa_vector<Ts...>::at(size_type pos) {
+  if (pos >= size()) {
+    throw std::out_of_range("s21::soa_vector::at(). invalid pos.");
+  }
+
+  return (*this)[pos];
+}
+
+template <typename... Ts>
+typename soa_vector<Ts...>::reference soa_vector<Ts...>::front() {
+#ifdef DEBUG
+  if (empty()) {
+    throw std::out_of_range("s21::soa_vector::front(). vector is empty.");
+  }
+#endif
+
+  return (*this)[0];
+}
+
+template <typename... Ts>
+typename soa_vector<Ts...>::reference soa_vector<Ts...>::back() {
+#ifdef DEBUG
+  if (empty()) {
+    throw std::out_of_range("s21::soa_vector::back(). vector is empty.");
+  }
+#endif
+
+  return (*this)[size() - 1];
+}
+
+template <typename... Ts>
+void soa_vector<Ts...>::reserve(size_type size) {
+  std::apply([size](auto&... column) { (column.reserve(size), ...); },
+             columns_);
+}
+
+template <typename... Ts>
+typename soa_vector<Ts...>::size_type soa_vector<Ts...>::capacity()
+    const noexcept {
+  // A column may be ahead when reserve() threw halfway.
+  return std::apply(
+      [](const auto&... column) { return std::min({column.capacity()...}); },
+      columns_);
+}
+
+template <typename... Ts>
+void soa_vector<Ts...>::shrink_to_fit() {
+  std::apply([](auto&... column) { (column.shrink_to_fit(), ...); },
+             columns_);
+}
+
+template <typename... Ts>
+void soa_vector<Ts...>::clear() noexcept {
+  std::apply([](auto&... column) { (column.clear(), ...); }, columns_);
+}
+
+template <typename... Ts>
+template <typename... Args>
+typename soa_vector<Ts...>::reference soa_vector<Ts...>::emplace_back(
+    Args&&... args) {
+  static_assert(sizeof...(Args) == sizeof...(Ts),
+                "s21::soa_vector::emplace_back(). one argument per field");
+
+#ifdef DEBUG
+  if (size() == max_size()) {
+    throw std::invalid_argument(
+        "s21::soa_vector::emplace_back(). size too big.");
+  }
+#endif
+
+  // Every column gets room first, so that a throwing field only has to undo
+  // the fields appended before it. args may refer to a row of this vector,
+  // so the row is built before the columns are relocated.
+  if (size() == capacity()) {
+    std::tuple<Ts...> row(std::forward<Args>(args)...);
+
+    reserve(std::max(size() + 1, size_type(growth_factor_ * capacity())));
+    return std::apply(
+        [this](Ts&... fields) -> reference {
+          return emplace_back(std::move(fields)...);
+        },
+        row);
+  }
+
+  size_type done = 0;
+
+  try {
+    std::apply(
+        [&](auto&... column) {
+          ((column.emplace_back(std::forward<Args>(args)), ++done), ...);
+        },
+        columns_);
+  } catch (...) {
+    pop_back_first(done, std::index_sequence_for<Ts...>());
+    throw;
+  }
+
+  return back();
+}
+
+template <typename... Ts>
+void soa_vector<Ts...>::pop_back() {
+#ifdef DEBUG
+  if (empty()) {
+    throw std::out_of_range("s21::soa_vector::pop_back(). vector is empty.");
+  }
+#endif
+
+  std::apply([](auto&... column) { (column.pop_back(), ...); }, columns_);
+}
+
+template <typename... Ts>
+bool operator==(const soa_vector<Ts...>& lhs, const soa_vector<Ts...>& rhs) {
+  return lhs.size() == rhs.size() &&
+         std::equal(lhs.begin(), lhs.end(), rhs.begin());
+}
+
+template <typename... Ts>
+bool operator!=(const soa_vector<Ts...>& lhs, const soa_vector<Ts...>& rhs) {
+  return !(lhs == rhs);
+}
+
+}  // namespace s21
+
+namespace std {
+
+template <typename... Ts>
+struct tuple_size<s21::soa_reference<Ts...>>
+    : std::integral_constant<std::size_t, sizeof...(Ts)> {};
+
+template <std::size_t I, typename... Ts>
+struct tuple_element<I, s21::soa_reference<Ts...>> {
+  using type = std::tuple_element_t<I, std::tuple<Ts...>>&;
+};
+
+}  // namespace std
+
+#endif  // S21_SOA_VECTOR_H_
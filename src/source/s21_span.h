@@ -0,0 +1,91 @@
+#ifndef S21_SPAN_H_
+#define S21_SPAN_H_
+
+#pragma once
+
+#include <cstddef>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+
+namespace s21 {
+
+inline constexpr std::size_t dynamic_extent = std::size_t(0) - 1;
+
+// Non-owning view of size() contiguous elements, like C++20 std::span with a
+// dynamic extent. Built from a pointer and a size, a C array or anything with
+// data() and size(), s21::vector and s21::array included.
+template <typename T>
+class span {
+ public:
+  using element_type = T;
+  using value_type = std::remove_cv_t<T>;
+  using size_type = std::size_t;
+  using difference_type = std::ptrdiff_t;
+  using pointer = T*;
+  using const_pointer = const T*;
+  using reference = T&;
+  using const_reference = const T&;
+  using iterator = T*;
+
+ public:
+  constexpr span() noexcept : data_(nullptr), size_(0) {}
+  constexpr span(pointer data, size_type size) noexcept
+      : data_(data), size_(size) {}
+  constexpr span(pointer first, pointer last) noexcept
+      : data_(first), size_(last - first) {}
+  template <std::size_t N>
+  constexpr span(element_type (&arr)[N]) noexcept : data_(arr), size_(N) {}
+  template <typename Container,
+            typename = std::enable_if_t<std::is_convertible_v<
+                decltype(std::declval<Container&>().data()), pointer>>>
+  constexpr span(Container& c) noexcept : data_(c.data()), size_(c.size()) {}
+  // span<T> converts to span<const T>.
+  template <typename U, typename = std::enable_if_t<
+                            std::is_convertible_v<U (*)[], T (*)[]>>>
+  constexpr span(const span<U>& o) noexcept
+      : data_(o.data()), size_(o.size()) {}
+
+  constexpr reference operator[](size_type pos) const noexcept {
+    return data_[pos];
+  }
+  constexpr reference at(size_type pos) const;
+  constexpr reference front() const noexcept { return data_[0]; }
+  constexpr reference back() const noexcept { return data_[size_ - 1]; }
+  constexpr pointer data() const noexcept { return data_; }
+
+  constexpr iterator begin() const noexcept { return data_; }
+  constexpr iterator end() const noexcept { return data_ + size_; }
+
+  constexpr bool empty() const noexcept { return size_ == 0; }
+  constexpr size_type size() const noexcept { return size_; }
+  constexpr size_type size_bytes() const noexcept {
+    return size_ * sizeof(T);
+  }
+
+  constexpr span first(size_type n) const noexcept { return span(data_, n); }
+  constexpr span last(size_type n) const noexcept {
+    return span(data_ + size_ - n, n);
+  }
+  constexpr span subspan(size_type offset,
+                         size_type n = dynamic_extent) const noexcept {
+    return span(data_ + offset, n == dynamic_extent ? size_ - offset : n);
+  }
+
+ private:
+  pointer data_;
+  size_type size_;
+};
+
+template <typename T>
+constexpr typename span<T>::reference span<T>::at(size_type pos) const {
+  if (pos >= size_) {
+    throw std::out_of_range("s21::span::at(). pos is illegal.");
+  }
+
+  return data_[pos];
+}
+
+}  // namespace s21
+
+#endif  // S21_SPAN_H_
@@ -0,0 +1,264 @@
+#ifndef S21_SPSC_QUEUE_H_
+#define S21_SPSC_QUEUE_H_
+
+#pragma once
+
+#include <atomic>
+#include <memory>
+#include <stdexcept>
+
+#include "s21_concurrency.h"
+
+namespace s21 {
+
+// Bounded wait-free queue for exactly one producer and one consumer thread.
+// head_ and tail_ live on separate cache lines, and each side keeps a cached
+// copy of the other side's index so the shared line is only re-read when the
+// queue looks full (producer) or empty (consumer).
+template <typename T, typename Alloc = std::allocator<T>>
+class spsc_queue {
+ private:
+  using this_type = spsc_queue<T, Alloc>;
+
+  using allocator_type = Alloc;
+  using allocator_traits = std::allocator_traits<allocator_type>;
+
+ public:
+  using value_type = T;
+  using reference = T &;
+  using const_reference = const T &;
+  using size_type = std::size_t;
+
+ public:
+  explicit spsc_queue(size_type capacity);
+  spsc_queue(const spsc_queue &) = delete;
+  spsc_queue(spsc_queue &&) = delete;
+  this_type &operator=(const spsc_queue &) = delete;
+  this_type &operator=(spsc_queue &&) = delete;
+  ~spsc_queue();
+
+  bool empty() const noexcept { return size() == 0; }
+  size_type size() const noexcept;
+  size_type capacity() const noexcept { return mask_ + 1; }
+
+  // producer side
+  bool try_push(const_reference value) { return try_emplace(value); }
+  bool try_push(value_type &&value) { return try_emplace(std::move(value)); }
+  template <typename... Args>
+  bool try_emplace(Args &&...args);
+  void push(const_reference value);
+  void push(value_type &&value);
+  template <typename InputIt>
+  size_type push_bulk(InputIt first, size_type n);
+  template <typename... Args>
+  void insert_many_back(Args &&...args);
+
+  // consumer side
+  bool try_pop(reference value);
+  void pop(reference value);
+  template <typename OutputIt>
+  size_type pop_bulk(OutputIt out, size_type n);
+
+ private:
+  value_type *slot(size_type pos) const noexcept {
+    return buf_ + (pos & mask_);
+  }
+  size_type free_slots(size_type n) noexcept;
+  size_type used_slots(size_type n) noexcept;
+
+ private:
+  allocator_type alloc_;
+  value_type *buf_;
+  size_type mask_;
+
+  alignas(details::cache_line_size_) std::atomic<size_type> head_;
+  size_type tail_cache_;
+
+  alignas(details::cache_line_size_) std::atomic<size_type> tail_;
+  size_type head_cache_;
+};
+
+template <typename T, typename Alloc>
+spsc_queue<T, Alloc>::spsc_queue(size_type capacity)
+    : alloc_(),
+      buf_(nullptr),
+      mask_(),
+      head_(0),
+      tail_cache_(0),
+      tail_(0),
+      head_cache_(0) {
+  if (capacity == 0 || capacity > (size_type(0) - 1) / 2 + 1) {
+    throw std::invalid_argument("s21::spsc_queue(). invalid capacity.");
+  }
+
+  size_type cap = 1;
+
+  while (cap < capacity) {
+    cap *= 2;
+  }
+
+  buf_ = allocator_traits::allocate(alloc_, cap);
+  mask_ = cap - 1;
+}
+
+template <typename T, typename Alloc>
+spsc_queue<T, Alloc>::~spsc_queue() {
+  const size_type tail = tail_.load(std::memory_order_relaxed);
+
+  for (size_type i = head_.load(std::memory_order_relaxed); i != tail; ++i) {
+    allocator_traits::destroy(alloc_, slot(i));
+  }
+  allocator_traits::deallocate(alloc_, buf_, mask_ + 1);
+}
+
+template <typename T, typename Alloc>
+typename spsc_queue<T, Alloc>::size_type spsc_queue<T, Alloc>::size()
+    const noexcept {
+  const size_type head = head_.load(std::memory_order_acquire);
+  const size_type tail = tail_.load(std::memory_order_acquire);
+
+  return tail - head < capacity() ? tail - head : capacity();
+}
+
+// Number of slots (at most n) the producer may fill right now.
+template <typename T, typename Alloc>
+typename spsc_queue<T, Alloc>::size_type spsc_queue<T, Alloc>::free_slots(
+    size_type n) noexcept {
+  const size_type tail = tail_.load(std::memory_order_relaxed);
+  size_type free = capacity() - (tail - head_cache_);
+
+  if (free < n) {
+    head_cache_ = head_.load(std::memory_order_acquire);
+    free = capacity() - (tail - head_cache_);
+  }
+
+  return free < n ? free : n;
+}
+
+// Number of elements (at most n) the consumer may take right now.
+template <typename T, typename Alloc>
+typename spsc_queue<T, Alloc>::size_type spsc_queue<T, Alloc>::used_slots(
+    size_type n) noexcept {
+  const size_type head = head_.load(std::memory_order_relaxed);
+  size_type used = tail_cache_ - head;
+
+  if (used < n) {
+    tail_cache_ = tail_.load(std::memory_order_acquire);
+    used = tail_cache_ - head;
+  }
+
+  return used < n ? used : n;
+}
+
+template <typename T, typename Alloc>
+template <typename... Args>
+bool spsc_queue<T, Alloc>::try_emplace(Args &&...args) {
+  if (free_slots(1) == 0) {
+    return false;
+  }
+
+  const size_type tail = tail_.load(std::memory_order_relaxed);
+  allocator_traits::construct(alloc_, slot(tail), std::forward<Args>(args)...);
+  tail_.store(tail + 1, std::memory_order_release);
+
+  return true;
+}
+
+template <typename T, typename Alloc>
+void spsc_queue<T, Alloc>::push(const_reference value) {
+  for (details::backoff wait; !try_push(value);) {
+    wait();
+  }
+}
+
+template <typename T, typename Alloc>
+void spsc_queue<T, Alloc>::push(value_type &&value) {
+  for (details::backoff wait; !try_push(std::move(value));) {
+    wait();
+  }
+}
+
+// Copies up to n elements starting at first and publishes them with a single
+// release store. Returns how many were pushed.
+template <typename T, typename Alloc>
+template <typename InputIt>
+typename spsc_queue<T, Alloc>::size_type spsc_queue<T, Alloc>::push_bulk(
+    InputIt first, size_type n) {
+  const size_type tail = tail_.load(std::memory_order_relaxed);
+  size_type i = 0;
+
+  n = free_slots(n);
+
+  try {
+    for (; i < n; ++i, ++first) {
+      allocator_traits::construct(alloc_, slot(tail + i), *first);
+    }
+  } catch (...) {
+    tail_.store(tail + i, std::memory_order_release);
+    throw;
+  }
+  tail_.store(tail + n, std::memory_order_release);
+
+  return n;
+}
+
+template <typename T, typename Alloc>
+template <typename... Args>
+void spsc_queue<T, Alloc>::insert_many_back(Args &&...args) {
+  (..., push(std::forward<Args>(args)));
+}
+
+template <typename T, typename Alloc>
+bool spsc_queue<T, Alloc>::try_pop(reference value) {
+  if (used_slots(1) == 0) {
+    return false;
+  }
+
+  const size_type head = head_.load(std::memory_order_relaxed);
+  value_type *p = slot(head);
+
+  value = std::move(*p);
+  allocator_traits::destroy(alloc_, p);
+  head_.store(head + 1, std::memory_order_release);
+
+  return true;
+}
+
+template <typename T, typename Alloc>
+void spsc_queue<T, Alloc>::pop(reference value) {
+  for (details::backoff wait; !try_pop(value);) {
+    wait();
+  }
+}
+
+// Moves up to n elements into out and releases their slots with a single
+// store. Returns how many were popped. If writing to out throws, the
+// elements written so far are popped and the rest stay in the queue.
+template <typename T, typename Alloc>
+template <typename OutputIt>
+typename spsc_queue<T, Alloc>::size_type spsc_queue<T, Alloc>::pop_bulk(
+    OutputIt out, size_type n) {
+  const size_type head = head_.load(std::memory_order_relaxed);
+  size_type i = 0;
+
+  n = used_slots(n);
+
+  try {
+    for (; i < n; ++i, ++out) {
+      value_type *p = slot(head + i);
+
+      *out = std::move(*p);
+      allocator_traits::destroy(alloc_, p);
+    }
+  } catch (...) {
+    head_.store(head + i, std::memory_order_release);
+    throw;
+  }
+  head_.store(head + n, std::memory_order_release);
+
+  return n;
+}
+
+}  // namespace s21
+
+#endif  // S21_SPSC_QUEUE_H_
@@ -7,11 +7,11 @@
 #include <memory>
 #include <stdexcept>
 
-#include "s21_list.h"
+#include "s21_vector.h"
 
 namespace s21 {
 
-template <typename T, class Container = s21::list<T>>
+template <typename T, class Container = s21::vector<T>>
 class stack {
  public:
   using value_type = T;
@@ -37,7 +37,11 @@ class stack {
 
   const_reference top();
   void push(const_reference value);
+  void push(value_type &&value);
+  template <class... Args>
+  reference emplace(Args &&...args);
   void pop();
+  void reserve(size_type size);
   void swap(stack &other);
 
   template <class... Args>
@@ -52,7 +56,7 @@ stack<T, Container>::stack() noexcept {}
 
 template <typename T, class Container>
 stack<T, Container>::stack(std::initializer_list<value_type> const &items) {
-  for (const auto value : items) {
+  for (const auto &value : items) {
     container_.push_back(value);
   }
 }
@@ -101,11 +105,27 @@ void stack<T, Container>::push(const_reference value) {
   container_.push_back(value);
 }
 
+template <typename T, class Container>
+void stack<T, Container>::push(value_type &&value) {
+  container_.push_back(std::move(value));
+}
+
+template <typename T, class Container>
+template <class... Args>
+T &stack<T, Container>::emplace(Args &&...args) {
+  return container_.emplace_back(std::forward<Args>(args)...);
+}
+
 template <typename T, class Container>
 void stack<T, Container>::pop() {
   container_.pop_back();
 }
 
+template <typename T, class Container>
+void stack<T, Container>::reserve(size_type size) {
+  container_.reserve(size);
+}
+
 template <typename T, class Container>
 void stack<T, Container>::swap(stack &other) {
   return container_.swap(other.container_);
@@ -119,7 +139,7 @@ const T &stack<T, Container>::top() {
 template <typename T, class Container>
 template <class... Args>
 void stack<T, Container>::insert_many_back(Args &&...args) {
-  container_.insert_many_back(args...);
+  container_.insert_many_back(std::forward<Args>(args)...);
 }
 
 }  // namespace s21
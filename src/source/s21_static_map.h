@@ -0,0 +1,308 @@
+#ifndef S21_STATIC_MAP_H_
+#define S21_STATIC_MAP_H_
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <stdexcept>
+#include <string_view>
+#include <type_traits>
+#include <utility>
+
+#include "s21_array.h"
+
+namespace s21 {
+
+namespace details {
+
+// splitmix64 finalizer: every input bit affects every output bit.
+constexpr std::uint64_t mix64(std::uint64_t x) noexcept {
+  x = (x ^ (x >> 30)) * 0xBF58476D1CE4E5B9ull;
+  x = (x ^ (x >> 27)) * 0x94D049BB133111EBull;
+  return x ^ (x >> 31);
+}
+
+}  // namespace details
+
+// Hash usable in constant expressions: integers and enums are mixed, strings
+// (anything convertible to std::string_view) go through 64-bit FNV-1a.
+template <typename Key, typename = void>
+struct static_hash {
+  constexpr std::uint64_t operator()(std::string_view key) const noexcept {
+    std::uint64_t res = 0xCBF29CE484222325ull;
+
+    for (char c : key) {
+      res = (res ^ static_cast<unsigned char>(c)) * 0x100000001B3ull;
+    }
+
+    return res;
+  }
+};
+
+template <typename Key>
+struct static_hash<Key, std::enable_if_t<std::is_integral_v<Key> ||
+                                         std::is_enum_v<Key>>> {
+  constexpr std::uint64_t operator()(Key key) const noexcept {
+    return details::mix64(static_cast<std::uint64_t>(key));
+  }
+};
+
+namespace details {
+
+// Bucket entries with this bit hold a slot, the others a seed to rehash the
+// bucket's keys with.
+static constexpr std::uint64_t static_map_direct_ = std::uint64_t(1) << 63;
+
+template <std::size_t N>
+struct static_map_layout {
+  std::uint64_t seed_ = 0;
+  array<std::uint64_t, N> buckets_{};
+  // slots_[slot] is the index of the item stored there.
+  array<std::size_t, N> slots_{};
+};
+
+constexpr std::size_t static_map_bucket(std::uint64_t hash, std::uint64_t seed,
+                                        std::size_t n) noexcept {
+  return mix64(hash + seed) % n;
+}
+
+constexpr std::size_t static_map_slot(std::uint64_t hash, std::uint64_t entry,
+                                      std::size_t n) noexcept {
+  return entry & static_map_direct_ ? std::size_t(entry & ~static_map_direct_)
+                                    : std::size_t(mix64(hash ^ entry) % n);
+}
+
+// One round of hash and displace with the given seed: hashes go into N
+// buckets, and the buckets, biggest first, each look for a seed that sends
+// all of their keys to free slots. Buckets with a single key just take the
+// next free slot. Returns false when some bucket finds no seed.
+template <std::size_t N>
+constexpr bool try_static_map_layout(const array<std::uint64_t, N>& hashes,
+                                     std::uint64_t seed,
+                                     static_map_layout<N>& res) {
+  constexpr std::uint64_t max_tries = 1 << 12;
+
+  array<std::size_t, N> count{};
+  array<std::size_t, N> start{};
+  array<std::size_t, N> keys{};
+  array<std::size_t, N> order{};
+  array<bool, N> taken{};
+
+  for (std::size_t i = 0; i < N; ++i) {
+    ++count[static_map_bucket(hashes[i], seed, N)];
+  }
+  for (std::size_t b = 1; b < N; ++b) {
+    start[b] = start[b - 1] + count[b - 1];
+  }
+  for (std::size_t i = 0; i < N; ++i) {
+    const std::size_t b = static_map_bucket(hashes[i], seed, N);
+
+    keys[start[b] + order[b]++] = i;
+  }
+  for (std::size_t b = 0; b < N; ++b) {
+    order[b] = b;
+  }
+  order.sort([&count](std::size_t lhs, std::size_t rhs) {
+    return count[lhs] > count[rhs];
+  });
+
+  res.seed_ = seed;
+  std::size_t free_slot = 0;
+
+  for (std::size_t b : order) {
+    const std::size_t* first = keys.data() + start[b];
+    const std::size_t* last = first + count[b];
+
+    if (count[b] == 1) {
+      while (taken[free_slot]) {
+        ++free_slot;
+      }
+      taken[free_slot] = true;
+      res.slots_[free_slot] = *first;
+      res.buckets_[b] = static_map_direct_ | free_slot;
+      continue;
+    }
+
+    std::uint64_t entry = 1;
+
+    for (; entry <= max_tries; ++entry) {
+      const std::size_t* it = first;
+
+      for (; it != last; ++it) {
+        const std::size_t slot = static_map_slot(hashes[*it], entry, N);
+
+        if (taken[slot]) {
+          break;
+        }
+        taken[slot] = true;
+      }
+      if (it == last) {
+        break;
+      }
+      // Undo the slots this seed already took.
+      for (const std::size_t* j = first; j != it; ++j) {
+        taken[static_map_slot(hashes[*j], entry, N)] = false;
+      }
+    }
+    if (entry > max_tries) {
+      return false;
+    }
+
+    res.buckets_[b] = entry;
+    for (const std::size_t* it = first; it != last; ++it) {
+      res.slots_[static_map_slot(hashes[*it], entry, N)] = *it;
+    }
+  }
+
+  return true;
+}
+
+template <std::size_t N>
+constexpr static_map_layout<N> make_static_map_layout(
+    const array<std::uint64_t, N>& hashes) {
+  array<std::uint64_t, N> sorted = hashes;
+
+  sorted.sort();
+  for (std::size_t i = 1; i < N; ++i) {
+    if (sorted[i - 1] == sorted[i]) {
+      throw std::invalid_argument("s21::static_map. keys hash the same.");
+    }
+  }
+
+  static_map_layout<N> res;
+
+  for (std::uint64_t seed = 0;; ++seed) {
+    res = static_map_layout<N>();
+    if (try_static_map_layout(hashes, seed, res)) {
+      return res;
+    }
+  }
+}
+
+}  // namespace details
+
+// Immutable map from N keys fixed at construction, meant to be built by the
+// compiler:
+//   constexpr s21::static_map<std::string_view, int, 3> codes(
+//       {{"get", 1}, {"put", 2}, {"del", 3}});
+// The constructor lays the items out with a minimal perfect hash (hash and
+// displace), so find() hashes the key once, mixes the hash with a per-bucket
+// seed and compares with the one item in the resulting slot. Keys and values
+// must be literal types for a constexpr map; std::string_view keys can be
+// looked up with std::string or const char*. Equal keys do not compile in a
+// constant expression and throw std::invalid_argument otherwise. Iteration
+// visits the items in slot order.
+template <typename Key, typename Value, std::size_t N,
+          typename Hash = static_hash<Key>, typename KeyEqual = std::equal_to<>>
+class static_map {
+  static_assert(N > 0, "s21::static_map needs at least one key");
+
+ private:
+  using this_type = static_map<Key, Value, N, Hash, KeyEqual>;
+  using layout_type = details::static_map_layout<N>;
+
+ public:
+  using key_type = Key;
+  using mapped_type = Value;
+  using value_type = std::pair<const Key, Value>;
+  using size_type = std::size_t;
+  using difference_type = std::ptrdiff_t;
+  using reference = value_type&;
+  using const_reference = const value_type&;
+  using iterator = value_type*;
+  using const_iterator = const value_type*;
+
+ public:
+  constexpr explicit static_map(const value_type (&items)[N])
+      : static_map(items, details::make_static_map_layout(hashes(items)),
+                   std::make_index_sequence<N>()) {}
+  // Items filled in at run time, where pairs with a const key cannot be
+  // assigned.
+  constexpr explicit static_map(const array<std::pair<Key, Value>, N>& items)
+      : static_map(items, details::make_static_map_layout(hashes(items)),
+                   std::make_index_sequence<N>()) {}
+
+  constexpr iterator begin() noexcept { return items_.begin(); }
+  constexpr const_iterator begin() const noexcept { return items_.begin(); }
+  constexpr iterator end() noexcept { return items_.end(); }
+  constexpr const_iterator end() const noexcept { return items_.end(); }
+
+  constexpr bool empty() const noexcept { return false; }
+  constexpr size_type size() const noexcept { return N; }
+  constexpr size_type max_size() const noexcept { return N; }
+
+  template <typename K>
+  constexpr iterator find(const K& key) noexcept {
+    value_type& item = items_[slot(key)];
+
+    return KeyEqual()(item.first, key) ? &item : end();
+  }
+  template <typename K>
+  constexpr const_iterator find(const K& key) const noexcept {
+    return const_cast<this_type*>(this)->find(key);
+  }
+  template <typename K>
+  constexpr bool contains(const K& key) const noexcept {
+    return find(key) != end();
+  }
+  template <typename K>
+  constexpr size_type count(const K& key) const noexcept {
+    return contains(key) ? 1 : 0;
+  }
+  template <typename K>
+  constexpr mapped_type& at(const K& key);
+  template <typename K>
+  constexpr const mapped_type& at(const K& key) const {
+    return const_cast<this_type*>(this)->at(key);
+  }
+
+ private:
+  template <typename Items, std::size_t... I>
+  constexpr static_map(const Items& items, const layout_type& layout,
+                       std::index_sequence<I...>)
+      : items_{{value_type(items[layout.slots_[I]])...}},
+        buckets_(layout.buckets_),
+        seed_(layout.seed_) {}
+
+  template <typename Items>
+  static constexpr array<std::uint64_t, N> hashes(const Items& items) {
+    array<std::uint64_t, N> res{};
+
+    for (size_type i = 0; i < N; ++i) {
+      res[i] = Hash()(items[i].first);
+    }
+
+    return res;
+  }
+
+  template <typename K>
+  constexpr size_type slot(const K& key) const noexcept {
+    const std::uint64_t hash = Hash()(key);
+
+    return details::static_map_slot(
+        hash, buckets_[details::static_map_bucket(hash, seed_, N)], N);
+  }
+
+ private:
+  array<value_type, N> items_;
+  array<std::uint64_t, N> buckets_;
+  std::uint64_t seed_;
+};
+
+template <typename Key, typename Value, std::size_t N, typename Hash,
+          typename KeyEqual>
+template <typename K>
+constexpr typename static_map<Key, Value, N, Hash, KeyEqual>::mapped_type&
+static_map<Key, Value, N, Hash, KeyEqual>::at(const K& key) {
+  if (auto it = find(key); it != end()) {
+    return it->second;
+  } else {
+    throw std::out_of_range("s21::static_map::at(). invalid key.");
+  }
+}
+
+}  // namespace s21
+
+#endif  // S21_STATIC_MAP_H_
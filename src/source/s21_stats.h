@@ -0,0 +1,150 @@
+#ifndef S21_STATS_H_
+#define S21_STATS_H_
+
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <ostream>
+
+namespace s21 {
+
+namespace stats {
+
+// Event counters for the containers, compiled in only with -DS21_STATS.
+// Without it every count() is an empty inline function, so the containers
+// build to the same code as before, and snapshot() reads zeros. Counters
+// are process-wide, per kind of container, and relaxed atomics, so they
+// are exact under concurrency but not ordered with anything else. Every
+// translation unit of a program must agree on S21_STATS: the containers'
+// inline code differs with it, and mixing the two is an ODR violation.
+#ifdef S21_STATS
+inline constexpr bool enabled_ = true;
+#else
+inline constexpr bool enabled_ = false;
+#endif
+
+enum class container : std::uint8_t { vector, list, set, multiset, map };
+
+enum class event : std::uint8_t {
+  // Blocks of the container's allocator (vector storage, list and tree nodes).
+  allocations,
+  deallocations,
+  allocated_bytes,
+  // Moves of a vector to new storage and the elements moved with it.
+  relocations,
+  relocated_elements,
+  // Rebalancing work in set, multiset and map.
+  rotations,
+  recolorings,
+  // Searches for an insert position, the nodes they visited in total and
+  // the most any single one visited.
+  insert_searches,
+  insert_depth,
+  max_insert_depth,
+};
+
+inline constexpr std::size_t containers_ = 5;
+inline constexpr std::size_t events_ = 10;
+
+inline const char* name(container c) noexcept {
+  static const char* const names[containers_] = {"vector", "list", "set",
+                                                 "multiset", "map"};
+  return names[std::size_t(c)];
+}
+
+inline const char* name(event e) noexcept {
+  static const char* const names[events_] = {
+      "allocations",        "deallocations", "allocated_bytes",
+      "relocations",        "relocated_elements", "rotations",
+      "recolorings",        "insert_searches",    "insert_depth",
+      "max_insert_depth"};
+  return names[std::size_t(e)];
+}
+
+// Values of all counters at one moment.
+struct counters {
+  std::uint64_t operator()(container c, event e) const noexcept {
+    return values_[std::size_t(c)][std::size_t(e)];
+  }
+
+  std::uint64_t values_[containers_][events_];
+};
+
+namespace details {
+
+inline std::atomic<std::uint64_t> table_[containers_][events_];
+
+}  // namespace details
+
+inline void count(container c, event e, std::uint64_t n = 1) noexcept {
+  if constexpr (enabled_) {
+    details::table_[std::size_t(c)][std::size_t(e)].fetch_add(
+        n, std::memory_order_relaxed);
+  }
+}
+
+// Raises the counter to value if it is lower.
+inline void count_max(container c, event e, std::uint64_t value) noexcept {
+  if constexpr (enabled_) {
+    auto& counter = details::table_[std::size_t(c)][std::size_t(e)];
+    std::uint64_t cur = counter.load(std::memory_order_relaxed);
+
+    while (cur < value && !counter.compare_exchange_weak(
+                              cur, value, std::memory_order_relaxed)) {
+    }
+  }
+}
+
+inline counters snapshot() noexcept {
+  counters res{};
+
+  for (std::size_t c = 0; c < containers_; ++c) {
+    for (std::size_t e = 0; e < events_; ++e) {
+      res.values_[c][e] = details::table_[c][e].load(std::memory_order_relaxed);
+    }
+  }
+
+  return res;
+}
+
+inline void reset() noexcept {
+  for (auto& row : details::table_) {
+    for (auto& counter : row) {
+      counter.store(0, std::memory_order_relaxed);
+    }
+  }
+}
+
+// One "container.event value" line per non-zero counter.
+inline void dump_text(std::ostream& out, const counters& values = snapshot()) {
+  for (std::size_t c = 0; c < containers_; ++c) {
+    for (std::size_t e = 0; e < events_; ++e) {
+      if (values.values_[c][e] != 0) {
+        out << name(container(c)) << '.' << name(event(e)) << ' '
+            << values.values_[c][e] << '\n';
+      }
+    }
+  }
+}
+
+// {"vector": {"allocations": 3, ...}, ...} with every counter.
+inline void dump_json(std::ostream& out, const counters& values = snapshot()) {
+  out << '{';
+  for (std::size_t c = 0; c < containers_; ++c) {
+    out << (c ? ", \"" : "\"") << name(container(c)) << "\": {";
+    for (std::size_t e = 0; e < events_; ++e) {
+      out << (e ? ", \"" : "\"") << name(event(e))
+          << "\": " << values.values_[c][e];
+    }
+    out << '}';
+  }
+  out << "}\n";
+}
+
+}  // namespace stats
+
+}  // namespace s21
+
+#endif  // S21_STATS_H_
@@ -0,0 +1,571 @@
+#ifndef S21_THREAD_POOL_H_
+#define S21_THREAD_POOL_H_
+
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <exception>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <thread>
+#include <type_traits>
+#include <utility>
+
+#include "s21_concurrency.h"
+#include "s21_deque.h"
+
+namespace s21 {
+
+namespace details {
+
+// Type-erased unit of work owned by the pool until it runs. invoke_ both
+// runs (if asked to) and frees the task, so a queue slot is one pointer.
+class pool_task {
+ protected:
+  using invoke_type = void (*)(pool_task*, bool);
+
+ public:
+  explicit pool_task(invoke_type invoke) noexcept : invoke_(invoke) {}
+
+  void run() { invoke_(this, true); }
+  void discard() noexcept { invoke_(this, false); }
+
+ private:
+  invoke_type invoke_;
+};
+
+template <typename F>
+class pool_task_impl : public pool_task {
+ public:
+  template <typename G>
+  explicit pool_task_impl(G&& f)
+      : pool_task(&pool_task_impl::invoke), f_(std::forward<G>(f)) {}
+
+ private:
+  static void invoke(pool_task* task, bool run) {
+    std::unique_ptr<pool_task_impl> self(static_cast<pool_task_impl*>(task));
+
+    if (run) {
+      self->f_();
+    }
+  }
+
+ private:
+  F f_;
+};
+
+template <typename F>
+pool_task* make_pool_task(F&& f) {
+  return new pool_task_impl<std::decay_t<F>>(std::forward<F>(f));
+}
+
+// Chase-Lev work-stealing deque, in the weak-memory formulation of Le et
+// al. (PPoPP 2013). The owning thread pushes and takes at the bottom
+// without locking; any other thread steals from the top with a single CAS.
+// A buffer outgrown by push() is kept until the deque dies, because a thief
+// may still be reading from it. bottom_ is published with seq_cst stores
+// instead of the paper's fences, which also gives thread_pool the ordering
+// its sleep handshake needs.
+template <typename T>
+class chase_lev_deque {
+  static_assert(std::is_trivially_copyable_v<T>,
+                "s21::details::chase_lev_deque holds trivially copyable T");
+
+ private:
+  using index_type = std::int64_t;
+
+  class buffer {
+   public:
+    explicit buffer(std::size_t capacity, buffer* prev)
+        : mask_(capacity - 1),
+          items_(new std::atomic<T>[capacity]),
+          prev_(prev) {}
+
+    std::size_t capacity() const noexcept { return mask_ + 1; }
+    T get(index_type i) const noexcept {
+      return items_[i & mask_].load(std::memory_order_relaxed);
+    }
+    void put(index_type i, T item) noexcept {
+      items_[i & mask_].store(item, std::memory_order_relaxed);
+    }
+
+   public:
+    const std::size_t mask_;
+    std::unique_ptr<std::atomic<T>[]> items_;
+    buffer* const prev_;
+  };
+
+ public:
+  chase_lev_deque() : buffer_(new buffer(initial_capacity_, nullptr)) {}
+  chase_lev_deque(const chase_lev_deque&) = delete;
+  chase_lev_deque& operator=(const chase_lev_deque&) = delete;
+  ~chase_lev_deque();
+
+  // Owner only.
+  void push(T item);
+  bool take(T& item) noexcept;
+  // Any thread. Fails on an empty deque and on losing a race.
+  bool steal(T& item) noexcept;
+
+  bool empty() const noexcept { return bottom_.load() <= top_.load(); }
+
+ private:
+  buffer* grow(buffer* old, index_type top, index_type bottom);
+
+ private:
+  static constexpr std::size_t initial_capacity_ = 64;
+
+  alignas(cache_line_size_) std::atomic<index_type> top_{0};
+  alignas(cache_line_size_) std::atomic<index_type> bottom_{0};
+  std::atomic<buffer*> buffer_;
+};
+
+template <typename T>
+chase_lev_deque<T>::~chase_lev_deque() {
+  for (buffer* cur = buffer_.load(); cur;) {
+    buffer* prev = cur->prev_;
+
+    delete cur;
+    cur = prev;
+  }
+}
+
+template <typename T>
+typename chase_lev_deque<T>::buffer* chase_lev_deque<T>::grow(
+    buffer* old, index_type top, index_type bottom) {
+  buffer* res = new buffer(old->capacity() * 2, old);
+
+  for (index_type i = top; i < bottom; ++i) {
+    res->put(i, old->get(i));
+  }
+  buffer_.store(res, std::memory_order_release);
+
+  return res;
+}
+
+template <typename T>
+void chase_lev_deque<T>::push(T item) {
+  const index_type b = bottom_.load(std::memory_order_relaxed);
+  const index_type t = top_.load(std::memory_order_acquire);
+  buffer* buf = buffer_.load(std::memory_order_relaxed);
+
+  if (b - t >= index_type(buf->capacity())) {
+    buf = grow(buf, t, b);
+  }
+
+  buf->put(b, item);
+  bottom_.store(b + 1);
+}
+
+template <typename T>
+bool chase_lev_deque<T>::take(T& item) noexcept {
+  const index_type b = bottom_.load(std::memory_order_relaxed) - 1;
+  buffer* buf = buffer_.load(std::memory_order_relaxed);
+
+  bottom_.store(b);
+  index_type t = top_.load();
+
+  if (t > b) {
+    bottom_.store(b + 1, std::memory_order_relaxed);
+    return false;
+  }
+
+  item = buf->get(b);
+
+  if (t == b) {
+    // Last item: race the thieves for it.
+    const bool won = top_.compare_exchange_strong(t, t + 1);
+
+    bottom_.store(b + 1, std::memory_order_relaxed);
+    return won;
+  }
+
+  return true;
+}
+
+template <typename T>
+bool chase_lev_deque<T>::steal(T& item) noexcept {
+  index_type t = top_.load();
+  const index_type b = bottom_.load();
+
+  if (t >= b) {
+    return false;
+  }
+
+  const T res = buffer_.load(std::memory_order_acquire)->get(t);
+
+  if (!top_.compare_exchange_strong(t, t + 1)) {
+    return false;
+  }
+
+  item = res;
+
+  return true;
+}
+
+}  // namespace details
+
+class wait_group;
+
+// Fixed set of worker threads, each with its own Chase-Lev deque. A task
+// spawned by a worker goes to the bottom of that worker's deque and is
+// usually run by it, newest first; idle workers steal the oldest tasks from
+// the top of the others. Tasks from threads outside the pool go through one
+// shared locked queue. A thread waiting for tasks (wait_group::wait(),
+// help_until()) runs queued tasks instead of blocking, so nested fork-join
+// never deadlocks and a pool without workers still makes progress.
+class thread_pool {
+ public:
+  using size_type = std::size_t;
+
+ public:
+  explicit thread_pool(size_type workers = default_workers());
+  thread_pool(const thread_pool&) = delete;
+  thread_pool& operator=(const thread_pool&) = delete;
+  // Joins the workers; tasks that never ran are dropped.
+  ~thread_pool();
+
+  // Shared pool used by the s21::par algorithms.
+  static thread_pool& instance();
+  // One worker per hardware thread besides the caller.
+  static size_type default_workers() noexcept {
+    return std::max(1u, std::thread::hardware_concurrency()) - 1;
+  }
+
+  // Threads that run tasks: the workers plus the one waiting on them.
+  size_type concurrency() const noexcept { return workers_ + 1; }
+
+  template <typename F>
+  auto submit(F&& f) -> std::future<std::invoke_result_t<std::decay_t<F>&>>;
+  // Calls f(i) for every i in [first, last), splitting the range in halves
+  // as tasks so that idle workers steal the biggest pieces left.
+  template <typename Index, typename F>
+  void parallel_for(Index first, Index last, F&& f);
+
+  // Runs one queued task, if there is any.
+  bool run_one();
+  template <typename Done>
+  void help_until(Done done);
+
+ private:
+  friend class wait_group;
+
+  struct alignas(details::cache_line_size_) worker {
+    details::chase_lev_deque<details::pool_task*> tasks_;
+  };
+
+  struct thread_info {
+    const thread_pool* pool_ = nullptr;
+    size_type index_ = 0;
+  };
+
+  static thread_info& current() noexcept {
+    thread_local thread_info info;
+
+    return info;
+  }
+
+  // Takes ownership of task, also when it throws.
+  void push(details::pool_task* task);
+  details::pool_task* find_task();
+  bool has_work() const noexcept;
+  void wake();
+  void work(size_type index);
+
+ private:
+  const size_type workers_;
+  std::unique_ptr<worker[]> queues_;
+  std::unique_ptr<std::thread[]> threads_;
+
+  details::spin_lock injected_lock_;
+  s21::deque<details::pool_task*> injected_;
+  std::atomic<size_type> injected_size_{0};
+
+  std::atomic<size_type> sleepers_{0};
+  std::atomic<bool> stop_{false};
+  std::mutex sleep_lock_;
+  std::condition_variable wake_;
+};
+
+// Tasks spawned by one fork-join step. run() may be called from any thread,
+// tasks of the group included. wait() helps run queued tasks until every
+// task of the group finished and rethrows the first exception one of them
+// threw. The destructor waits too, so tasks may safely refer to locals of
+// the scope that owns the group.
+class wait_group {
+ public:
+  using size_type = std::size_t;
+
+ public:
+  explicit wait_group(thread_pool& pool = thread_pool::instance()) noexcept
+      : pool_(pool) {}
+  wait_group(const wait_group&) = delete;
+  wait_group& operator=(const wait_group&) = delete;
+  ~wait_group() {
+    pool_.help_until([this] { return pending_.load() == 0; });
+  }
+
+  thread_pool& pool() const noexcept { return pool_; }
+
+  template <typename F>
+  void run(F&& f);
+  void wait();
+
+ private:
+  thread_pool& pool_;
+  std::atomic<size_type> pending_{0};
+  details::spin_lock error_lock_;
+  std::exception_ptr error_;
+};
+
+inline thread_pool::thread_pool(size_type workers)
+    : workers_(workers),
+      queues_(new worker[workers]),
+      threads_(new std::thread[workers]) {
+  for (size_type i = 0; i < workers_; ++i) {
+    threads_[i] = std::thread([this, i] { work(i); });
+  }
+}
+
+inline thread_pool::~thread_pool() {
+  {
+    std::lock_guard<std::mutex> lock(sleep_lock_);
+    stop_.store(true);
+  }
+  wake_.notify_all();
+
+  for (size_type i = 0; i < workers_; ++i) {
+    threads_[i].join();
+  }
+
+  details::pool_task* task = nullptr;
+
+  for (size_type i = 0; i < workers_; ++i) {
+    while (queues_[i].tasks_.take(task)) {
+      task->discard();
+    }
+  }
+  for (details::pool_task* tmp : injected_) {
+    tmp->discard();
+  }
+}
+
+inline thread_pool& thread_pool::instance() {
+  static thread_pool pool;
+
+  return pool;
+}
+
+// A sleeping worker registers in sleepers_ and then checks every queue, all
+// seq_cst; push() publishes the task and then reads sleepers_. One of the
+// two always sees the other, and taking sleep_lock_ before notifying makes
+// sure the worker is really waiting by then.
+inline void thread_pool::wake() {
+  if (sleepers_.load() != 0) {
+    { std::lock_guard<std::mutex> lock(sleep_lock_); }
+    wake_.notify_one();
+  }
+}
+
+inline void thread_pool::push(details::pool_task* task) {
+  const thread_info& info = current();
+
+  try {
+    if (info.pool_ == this) {
+      queues_[info.index_].tasks_.push(task);
+    } else {
+      std::lock_guard<details::spin_lock> lock(injected_lock_);
+
+      injected_.push_back(task);
+      injected_size_.store(injected_.size());
+    }
+  } catch (...) {
+    task->discard();
+    throw;
+  }
+
+  wake();
+}
+
+// Own deque first, then the other workers starting right after this one,
+// then the shared queue: from its front for workers, like a steal, and from
+// its back for outside threads, like a take.
+inline details::pool_task* thread_pool::find_task() {
+  const thread_info& info = current();
+  const bool own = info.pool_ == this;
+  details::pool_task* task = nullptr;
+
+  if (own && queues_[info.index_].tasks_.take(task)) {
+    return task;
+  }
+
+  for (size_type i = own ? 1 : 0; i < workers_; ++i) {
+    if (queues_[(info.index_ + i) % workers_].tasks_.steal(task)) {
+      return task;
+    }
+  }
+
+  if (injected_size_.load(std::memory_order_relaxed) != 0) {
+    std::lock_guard<details::spin_lock> lock(injected_lock_);
+
+    if (!injected_.empty()) {
+      // Outside threads only push here, so they too take their own newest
+      // task first; that keeps helping from nesting deeper than the
+      // fork-join recursion itself.
+      if (own) {
+        task = injected_.front();
+        injected_.pop_front();
+      } else {
+        task = injected_.back();
+        injected_.pop_back();
+      }
+      injected_size_.store(injected_.size());
+
+      return task;
+    }
+  }
+
+  return nullptr;
+}
+
+inline bool thread_pool::has_work() const noexcept {
+  for (size_type i = 0; i < workers_; ++i) {
+    if (!queues_[i].tasks_.empty()) {
+      return true;
+    }
+  }
+
+  return injected_size_.load() != 0;
+}
+
+inline bool thread_pool::run_one() {
+  details::pool_task* task = find_task();
+
+  if (!task) {
+    return false;
+  }
+
+  task->run();
+
+  return true;
+}
+
+template <typename Done>
+void thread_pool::help_until(Done done) {
+  for (details::backoff wait; !done();) {
+    if (run_one()) {
+      wait.reset();
+    } else {
+      wait();
+    }
+  }
+}
+
+inline void thread_pool::work(size_type index) {
+  current() = thread_info{this, index};
+
+  while (!stop_.load(std::memory_order_relaxed)) {
+    if (run_one()) {
+      continue;
+    }
+
+    std::unique_lock<std::mutex> lock(sleep_lock_);
+
+    sleepers_.fetch_add(1);
+    wake_.wait(lock, [this] { return stop_.load() || has_work(); });
+    sleepers_.fetch_sub(1);
+  }
+}
+
+template <typename F>
+auto thread_pool::submit(F&& f)
+    -> std::future<std::invoke_result_t<std::decay_t<F>&>> {
+  using result_type = std::invoke_result_t<std::decay_t<F>&>;
+
+  std::packaged_task<result_type()> job(std::forward<F>(f));
+  std::future<result_type> res = job.get_future();
+
+  push(details::make_pool_task(std::move(job)));
+
+  return res;
+}
+
+template <typename Index, typename F>
+void thread_pool::parallel_for(Index first, Index last, F&& f) {
+  if (!(first < last)) {
+    return;
+  }
+
+  // Pieces below the grain run inline: about eight per thread.
+  const Index grain =
+      std::max<Index>(Index(1), Index((last - first) / (concurrency() * 8)));
+  wait_group group(*this);
+
+  struct splitter {
+    void operator()(Index from, Index to) const {
+      while (to - from > grain_) {
+        const Index mid = from + (to - from) / 2;
+
+        group_.run([*this, mid, to] { (*this)(mid, to); });
+        to = mid;
+      }
+      for (; from < to; ++from) {
+        f_(from);
+      }
+    }
+
+    const Index grain_;
+    wait_group& group_;
+    std::remove_reference_t<F>& f_;
+  };
+
+  splitter{grain, group, f}(first, last);
+  group.wait();
+}
+
+// f is destroyed before the count drops: once wait() returns, the caller
+// may tear down whatever f refers to.
+template <typename F>
+void wait_group::run(F&& f) {
+  pending_.fetch_add(1);
+
+  try {
+    pool_.push(details::make_pool_task(
+        [this, f = std::optional<std::decay_t<F>>(
+                   std::in_place, std::forward<F>(f))]() mutable {
+          try {
+            (*f)();
+          } catch (...) {
+            std::lock_guard<details::spin_lock> lock(error_lock_);
+
+            if (!error_) {
+              error_ = std::current_exception();
+            }
+          }
+          f.reset();
+          pending_.fetch_sub(1, std::memory_order_release);
+        }));
+  } catch (...) {
+    pending_.fetch_sub(1);
+    throw;
+  }
+}
+
+inline void wait_group::wait() {
+  pool_.help_until(
+      [this] { return pending_.load(std::memory_order_acquire) == 0; });
+
+  if (error_) {
+    std::rethrow_exception(std::exchange(error_, nullptr));
+  }
+}
+
+}  // namespace s21
+
+#endif  // S21_THREAD_POOL_H_
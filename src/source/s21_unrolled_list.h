@@ -0,0 +1,774 @@
+#ifndef S21_UNROLLED_LIST_H_
+#define S21_UNROLLED_LIST_H_
+
+#pragma once
+
+#include <algorithm>
+#include <functional>
+#include <initializer_list>
+#include <iterator>
+#include <memory>
+#include <new>
+#include <stdexcept>
+#include <utility>
+
+#include "s21_list.h"
+#include "s21_vector.h"
+
+namespace s21 {
+
+namespace details {
+
+// Elements per block: about 512 bytes of payload, but at least 8 elements.
+template <typename T>
+constexpr std::size_t unrolled_list_block_size() noexcept {
+  return sizeof(T) < 64 ? 512 / sizeof(T) : 8;
+}
+
+// Links plus element count. The list's sentinel is a bare block_base with
+// size_ == 0, so iterators can step onto it without knowing about it.
+class unrolled_list_block_base : public list_node_base {
+ public:
+  using size_type = std::size_t;
+
+  unrolled_list_block_base() noexcept : list_node_base(), size_() {}
+
+  unrolled_list_block_base* next() const noexcept {
+    return static_cast<unrolled_list_block_base*>(next_);
+  }
+  unrolled_list_block_base* prev() const noexcept {
+    return static_cast<unrolled_list_block_base*>(prev_);
+  }
+
+ public:
+  size_type size_;
+};
+
+template <typename T, std::size_t N>
+class unrolled_list_block : public unrolled_list_block_base {
+ public:
+  T* slot(size_type pos) noexcept {
+    return std::launder(reinterpret_cast<T*>(data_)) + pos;
+  }
+
+ private:
+  alignas(T) unsigned char data_[N * sizeof(T)];
+};
+
+template <typename T, std::size_t N, typename Pointer, typename Reference>
+class unrolled_list_iterator {
+ private:
+  using this_type = unrolled_list_iterator<T, N, Pointer, Reference>;
+  using block_base_type = unrolled_list_block_base;
+  using block_type = unrolled_list_block<T, N>;
+
+  using iterator = unrolled_list_iterator<T, N, T*, T&>;
+  using const_iterator = unrolled_list_iterator<T, N, const T*, const T&>;
+
+ public:
+  using iterator_category = std::bidirectional_iterator_tag;
+  using size_type = std::size_t;
+  using difference_type = std::ptrdiff_t;
+  using value_type = T;
+  using pointer = Pointer;
+  using reference = Reference;
+
+ public:
+  unrolled_list_iterator(const block_base_type* block, size_type pos) noexcept
+      : block_(const_cast<block_base_type*>(block)), pos_(pos) {}
+  unrolled_list_iterator(const iterator& o) noexcept
+      : block_(o.block_), pos_(o.pos_) {}
+  unrolled_list_iterator(const const_iterator& o) noexcept
+      : block_(o.block_), pos_(o.pos_) {}
+  this_type& operator=(const iterator& o) noexcept {
+    return block_ = o.block_, pos_ = o.pos_, *this;
+  }
+  this_type& operator=(const const_iterator& o) noexcept {
+    return block_ = o.block_, pos_ = o.pos_, *this;
+  }
+
+  reference operator*() const noexcept {
+    return *static_cast<block_type*>(block_)->slot(pos_);
+  }
+  pointer operator->() const noexcept { return &**this; }
+
+  this_type& operator++() noexcept {
+    if (++pos_ == block_->size_) {
+      block_ = block_->next();
+      pos_ = 0;
+    }
+    return *this;
+  }
+  this_type operator++(int) noexcept {
+    this_type tmp(*this);
+    return ++*this, tmp;
+  }
+  this_type& operator--() noexcept {
+    if (pos_ == 0) {
+      block_ = block_->prev();
+      pos_ = block_->size_;
+    }
+    return --pos_, *this;
+  }
+  this_type operator--(int) noexcept {
+    this_type tmp(*this);
+    return --*this, tmp;
+  }
+
+ public:
+  block_base_type* block_;
+  size_type pos_;
+};
+
+template <typename T, std::size_t N, typename LPointer, typename LReference,
+          typename RPointer, typename RReference>
+inline bool operator==(
+    const unrolled_list_iterator<T, N, LPointer, LReference>& lhs,
+    const unrolled_list_iterator<T, N, RPointer, RReference>& rhs) noexcept {
+  return lhs.block_ == rhs.block_ && lhs.pos_ == rhs.pos_;
+}
+
+template <typename T, std::size_t N, typename LPointer, typename LReference,
+          typename RPointer, typename RReference>
+inline bool operator!=(
+    const unrolled_list_iterator<T, N, LPointer, LReference>& lhs,
+    const unrolled_list_iterator<T, N, RPointer, RReference>& rhs) noexcept {
+  return !(lhs == rhs);
+}
+
+template <typename T, std::size_t N, typename Alloc>
+class unrolled_list_base {
+ private:
+  using this_type = unrolled_list_base<T, N, Alloc>;
+
+  using t_allocator_type = Alloc;
+  using t_allocator_traits = std::allocator_traits<t_allocator_type>;
+  using block_allocator_type =
+      typename t_allocator_traits::template rebind_alloc<
+          unrolled_list_block<T, N>>;
+  using block_allocator_traits = std::allocator_traits<block_allocator_type>;
+
+ protected:
+  using size_type = std::size_t;
+  using difference_type = std::ptrdiff_t;
+  using value_type = T;
+  using reference = T&;
+  using const_reference = const T&;
+  using pointer = T*;
+  using block_base_type = unrolled_list_block_base;
+  using block_type = unrolled_list_block<T, N>;
+
+ protected:
+  unrolled_list_base() : alloc_(), block_alloc_(), node_base_(), size_() {}
+  unrolled_list_base(const this_type& o);
+  unrolled_list_base(this_type&& o) noexcept;
+  this_type& operator=(const this_type& o);
+  this_type& operator=(this_type&& o) noexcept;
+  ~unrolled_list_base() { clear(); }
+
+  // Allocates an empty block and links it right before next.
+  block_type* allocate_block(block_base_type* next);
+  // Unlinks and frees a block whose elements are already destroyed.
+  void deallocate_block(block_base_type* block) noexcept;
+
+  template <class... Args>
+  void construct(pointer p, Args&&... args) {
+    t_allocator_traits::construct(alloc_, p, std::forward<Args>(args)...);
+  }
+  void destroy(pointer p) { t_allocator_traits::destroy(alloc_, p); }
+  static pointer slot(block_base_type* block, size_type pos) noexcept {
+    return static_cast<block_type*>(block)->slot(pos);
+  }
+
+  void clear();
+
+ protected:
+  static constexpr size_type max_size_ = size_type(0) - 2;
+
+  t_allocator_type alloc_;
+  block_allocator_type block_alloc_;
+  block_base_type node_base_;
+  size_type size_;
+};
+
+template <typename T, std::size_t N, typename Alloc>
+unrolled_list_base<T, N, Alloc>::unrolled_list_base(const this_type& o)
+    : unrolled_list_base() {
+  alloc_ = o.alloc_;
+  block_alloc_ = o.block_alloc_;
+
+  try {
+    for (block_base_type* b = o.node_base_.next(); b != &o.node_base_;
+         b = b->next()) {
+      block_type* block = allocate_block(&node_base_);
+
+      for (; block->size_ < b->size_; ++block->size_, ++size_) {
+        construct(block->slot(block->size_), *slot(b, block->size_));
+      }
+    }
+  } catch (...) {
+    clear();
+    throw;
+  }
+}
+
+template <typename T, std::size_t N, typename Alloc>
+unrolled_list_base<T, N, Alloc>::unrolled_list_base(this_type&& o) noexcept
+    : alloc_(std::move(o.alloc_)),
+      block_alloc_(std::move(o.block_alloc_)),
+      node_base_(),
+      size_(o.size_) {
+  block_base_type::swap(&node_base_, &o.node_base_);
+  o.size_ = 0;
+}
+
+template <typename T, std::size_t N, typename Alloc>
+typename unrolled_list_base<T, N, Alloc>::this_type&
+unrolled_list_base<T, N, Alloc>::operator=(const this_type& o) {
+  if (&o != this) {
+    this_type res(o);
+    *this = std::move(res);
+  }
+
+  return *this;
+}
+
+template <typename T, std::size_t N, typename Alloc>
+typename unrolled_list_base<T, N, Alloc>::this_type&
+unrolled_list_base<T, N, Alloc>::operator=(this_type&& o) noexcept {
+  if (&o != this) {
+    clear();
+
+    alloc_ = std::move(o.alloc_);
+    block_alloc_ = std::move(o.block_alloc_);
+    block_base_type::swap(&node_base_, &o.node_base_);
+    size_ = o.size_;
+
+    o.size_ = 0;
+  }
+
+  return *this;
+}
+
+template <typename T, std::size_t N, typename Alloc>
+typename unrolled_list_base<T, N, Alloc>::block_type*
+unrolled_list_base<T, N, Alloc>::allocate_block(block_base_type* next) {
+  block_type* block = block_allocator_traits::allocate(block_alloc_, 1);
+
+  ::new (static_cast<void*>(block)) block_type();
+  block->insert(next);
+
+  return block;
+}
+
+template <typename T, std::size_t N, typename Alloc>
+void unrolled_list_base<T, N, Alloc>::deallocate_block(
+    block_base_type* block) noexcept {
+  block->erase();
+  block_allocator_traits::deallocate(block_alloc_,
+                                     static_cast<block_type*>(block), 1);
+}
+
+template <typename T, std::size_t N, typename Alloc>
+void unrolled_list_base<T, N, Alloc>::clear() {
+  for (block_base_type* b = node_base_.next(); b != &node_base_;) {
+    block_base_type* next = b->next();
+
+    for (size_type i = 0; i < b->size_; ++i) {
+      destroy(slot(b, i));
+    }
+    deallocate_block(b);
+    b = next;
+  }
+  size_ = 0;
+}
+
+}  // namespace details
+
+// Doubly linked list of fixed-capacity blocks, each holding up to BlockSize
+// elements contiguously. Iteration walks arrays instead of chasing a pointer
+// per element, and there is one allocation per block instead of per element.
+// Inserting into a full block splits it in half; erasing merges a block into
+// its neighbour once both fit in half a block. Unlike s21::list, insert and
+// erase invalidate iterators into the affected blocks. splice() relinks whole
+// blocks, while sort() and merge() move the elements and keep the blocks.
+template <typename T,
+          std::size_t BlockSize = details::unrolled_list_block_size<T>(),
+          typename Alloc = std::allocator<T>>
+class unrolled_list : public details::unrolled_list_base<T, BlockSize, Alloc> {
+  static_assert(BlockSize >= 2, "s21::unrolled_list needs BlockSize >= 2");
+
+ private:
+  using base_type = details::unrolled_list_base<T, BlockSize, Alloc>;
+  using this_type = unrolled_list<T, BlockSize, Alloc>;
+
+  using typename base_type::block_base_type;
+  using typename base_type::block_type;
+
+  using base_type::allocate_block;
+  using base_type::construct;
+  using base_type::deallocate_block;
+  using base_type::destroy;
+  using base_type::max_size_;
+  using base_type::node_base_;
+  using base_type::size_;
+  using base_type::slot;
+
+ public:
+  using typename base_type::const_reference;
+  using typename base_type::difference_type;
+  using typename base_type::pointer;
+  using typename base_type::reference;
+  using typename base_type::size_type;
+  using typename base_type::value_type;
+  using iterator = details::unrolled_list_iterator<T, BlockSize, T*, T&>;
+  using const_iterator =
+      details::unrolled_list_iterator<T, BlockSize, const T*, const T&>;
+
+ public:
+  unrolled_list() {}
+  unrolled_list(const std::initializer_list<value_type>& items);
+  unrolled_list(const this_type& o) : base_type(o) {}
+  unrolled_list(this_type&& o) noexcept : base_type(std::move(o)) {}
+  this_type& operator=(const this_type& o) {
+    return base_type::operator=(o), *this;
+  }
+  this_type& operator=(this_type&& o) noexcept {
+    return base_type::operator=(std::move(o)), *this;
+  }
+  ~unrolled_list() {}
+
+  reference front();
+  const_reference front() const {
+    return const_cast<this_type*>(this)->front();
+  }
+  reference back();
+  const_reference back() const { return const_cast<this_type*>(this)->back(); }
+
+  iterator begin() noexcept { return iterator(node_base_.next(), 0); }
+  const_iterator begin() const noexcept {
+    return const_iterator(node_base_.next(), 0);
+  }
+  iterator end() noexcept { return iterator(&node_base_, 0); }
+  const_iterator end() const noexcept { return const_iterator(&node_base_, 0); }
+
+  bool empty() const noexcept { return size_ == 0; }
+  size_type size() const noexcept { return size_; }
+  constexpr size_type max_size() const noexcept { return max_size_; }
+  static constexpr size_type block_size() noexcept { return BlockSize; }
+
+  void clear() noexcept { base_type::clear(); }
+  iterator insert(const_iterator pos, value_type&& val) {
+    return emplace(pos, std::move(val));
+  }
+  iterator insert(const_iterator pos, const_reference val) {
+    return emplace(pos, val);
+  }
+  iterator erase(const_iterator pos);
+  void push_back(value_type&& val) { emplace_back(std::move(val)); }
+  void push_back(const_reference val) { emplace_back(val); }
+  void pop_back() { erase(--end()); }
+  void push_front(value_type&& val) { emplace_front(std::move(val)); }
+  void push_front(const_reference val) { emplace_front(val); }
+  void pop_front() { erase(begin()); }
+  void swap(this_type& o) noexcept { std::swap(*this, o); }
+  void reverse() noexcept;
+  size_type unique() { return unique(std::equal_to<value_type>()); }
+  template <typename BinaryPredicate>
+  size_type unique(BinaryPredicate pred);
+  void splice(const_iterator pos, this_type&& o);
+  void splice(const_iterator pos, this_type& o) { splice(pos, std::move(o)); }
+  void merge(this_type&& o) { merge(std::move(o), std::less<value_type>()); }
+  void merge(this_type& o) { merge(std::move(o)); }
+  template <typename Compare>
+  void merge(this_type&& o, Compare comp);
+  template <typename Compare>
+  void merge(this_type& o, Compare comp) {
+    merge(std::move(o), comp);
+  }
+  void sort() { sort(std::less<value_type>()); }
+  template <typename Compare>
+  void sort(Compare comp);
+
+  template <typename... Args>
+  iterator emplace(const_iterator pos, Args&&... args);
+  template <typename... Args>
+  reference emplace_back(Args&&... args) {
+    return *emplace(end(), std::forward<Args>(args)...);
+  }
+  template <typename... Args>
+  reference emplace_front(Args&&... args) {
+    return *emplace(begin(), std::forward<Args>(args)...);
+  }
+
+  template <typename... Args>
+  iterator insert_many(const_iterator pos, Args&&... args);
+  template <typename... Args>
+  void insert_many_back(Args&&... args);
+  template <typename... Args>
+  void insert_many_front(Args&&... args);
+
+ private:
+  iterator make_room(const_iterator pos);
+  block_base_type* split(block_base_type* block, size_type at);
+  void arrange(const s21::vector<pointer>& order);
+};
+
+template <typename T, std::size_t BlockSize, typename Alloc>
+unrolled_list<T, BlockSize, Alloc>::unrolled_list(
+    const std::initializer_list<value_type>& items) {
+  for (const auto& item : items) {
+    emplace_back(item);
+  }
+}
+
+template <typename T, std::size_t BlockSize, typename Alloc>
+typename unrolled_list<T, BlockSize, Alloc>::reference
+unrolled_list<T, BlockSize, Alloc>::front() {
+#ifdef DEBUG
+  if (empty()) {
+    throw std::out_of_range("s21::unrolled_list::front(). list is empty.");
+  }
+#endif
+
+  return *begin();
+}
+
+template <typename T, std::size_t BlockSize, typename Alloc>
+typename unrolled_list<T, BlockSize, Alloc>::reference
+unrolled_list<T, BlockSize, Alloc>::back() {
+#ifdef DEBUG
+  if (empty()) {
+    throw std::out_of_range("s21::unrolled_list::back(). list is empty.");
+  }
+#endif
+
+  return *--end();
+}
+
+// Opens a gap for one element in front of pos and returns where it is. An
+// insertion at the start of a block goes to the end of the previous block if
+// that has room; a full block is split in half first.
+template <typename T, std::size_t BlockSize, typename Alloc>
+typename unrolled_list<T, BlockSize, Alloc>::iterator
+unrolled_list<T, BlockSize, Alloc>::make_room(const_iterator pos) {
+  block_base_type* block = pos.block_;
+  size_type i = pos.pos_;
+
+  if (i == 0) {
+    block_base_type* prev = block->prev();
+
+    if (prev != &node_base_ && prev->size_ < BlockSize) {
+      return iterator(prev, prev->size_);
+    }
+  }
+
+  if (block == &node_base_) {
+    return iterator(allocate_block(&node_base_), 0);
+  }
+
+  if (block->size_ == BlockSize) {
+    if (i == 0) {
+      return iterator(allocate_block(block), 0);
+    }
+
+    constexpr size_type half = BlockSize / 2;
+    block_base_type* upper = split(block, half);
+
+    if (i > half) {
+      block = upper;
+      i -= half;
+    }
+  }
+
+  if (i < block->size_) {
+    pointer last = slot(block, block->size_ - 1);
+
+    construct(last + 1, std::move_if_noexcept(*last));
+    std::move_backward(slot(block, i), last, last + 1);
+    destroy(slot(block, i));
+  }
+
+  return iterator(block, i);
+}
+
+// Moves the elements from at on into a new block linked after block and
+// returns it. The old elements are destroyed only once all are in place, so
+// a throwing copy leaves the list as it was.
+template <typename T, std::size_t BlockSize, typename Alloc>
+typename unrolled_list<T, BlockSize, Alloc>::block_base_type*
+unrolled_list<T, BlockSize, Alloc>::split(block_base_type* block,
+                                          size_type at) {
+  block_type* upper = allocate_block(block->next());
+
+  try {
+    for (; at + upper->size_ < block->size_; ++upper->size_) {
+      construct(upper->slot(upper->size_),
+                std::move_if_noexcept(*slot(block, at + upper->size_)));
+    }
+  } catch (...) {
+    for (size_type i = 0; i < upper->size_; ++i) {
+      destroy(upper->slot(i));
+    }
+    deallocate_block(upper);
+    throw;
+  }
+
+  for (size_type i = at; i < block->size_; ++i) {
+    destroy(slot(block, i));
+  }
+  block->size_ = at;
+
+  return upper;
+}
+
+// The value is built before make_room() moves anything, so args may refer
+// to elements of this list.
+template <typename T, std::size_t BlockSize, typename Alloc>
+template <typename... Args>
+typename unrolled_list<T, BlockSize, Alloc>::iterator
+unrolled_list<T, BlockSize, Alloc>::emplace(const_iterator pos,
+                                            Args&&... args) {
+#ifdef DEBUG
+  if (size_ == max_size()) {
+    throw std::invalid_argument("s21::unrolled_list::emplace(). size too big.");
+  }
+#endif
+
+  value_type tmp(std::forward<Args>(args)...);
+  iterator res = make_room(pos);
+
+  try {
+    construct(slot(res.block_, res.pos_), std::move(tmp));
+  } catch (...) {
+    // Close the gap again.
+    block_base_type* block = res.block_;
+    const size_type i = res.pos_;
+
+    if (i < block->size_) {
+      construct(slot(block, i), std::move(*slot(block, i + 1)));
+      std::move(slot(block, i + 2), slot(block, block->size_ + 1),
+                slot(block, i + 1));
+      destroy(slot(block, block->size_));
+    }
+    if (block->size_ == 0) {
+      deallocate_block(block);
+    }
+    throw;
+  }
+
+  ++res.block_->size_;
+  ++size_;
+
+  return res;
+}
+
+template <typename T, std::size_t BlockSize, typename Alloc>
+typename unrolled_list<T, BlockSize, Alloc>::iterator
+unrolled_list<T, BlockSize, Alloc>::erase(const_iterator pos) {
+#ifdef DEBUG
+  if (empty()) {
+    throw std::out_of_range("s21::unrolled_list::erase(). list is empty.");
+  }
+
+  if (pos == end()) {
+    throw std::out_of_range("s21::unrolled_list::erase(). pos is illegal.");
+  }
+#endif
+
+  block_base_type* block = pos.block_;
+  const size_type i = pos.pos_;
+
+  std::move(slot(block, i + 1), slot(block, block->size_), slot(block, i));
+  destroy(slot(block, --block->size_));
+  --size_;
+
+  if (block->size_ == 0) {
+    block_base_type* next = block->next();
+
+    deallocate_block(block);
+    return iterator(next, 0);
+  }
+
+  block_base_type* next = block->next();
+
+  if (next != &node_base_ && block->size_ + next->size_ <= BlockSize / 2) {
+    // The merge only saves space. Should a copy throw, the copies made so far
+    // are dropped and both blocks stay, so the erase itself still succeeds.
+    const size_type old_size = block->size_;
+    bool merged = true;
+
+    try {
+      for (size_type j = 0; j < next->size_; ++j) {
+        construct(slot(block, block->size_),
+                  std::move_if_noexcept(*slot(next, j)));
+        ++block->size_;
+      }
+    } catch (...) {
+      while (block->size_ != old_size) {
+        destroy(slot(block, --block->size_));
+      }
+      merged = false;
+    }
+
+    if (merged) {
+      for (size_type j = 0; j < next->size_; ++j) {
+        destroy(slot(next, j));
+      }
+      next->size_ = 0;
+      deallocate_block(next);
+    }
+  }
+
+  return i < block->size_ ? iterator(block, i) : iterator(block->next(), 0);
+}
+
+template <typename T, std::size_t BlockSize, typename Alloc>
+void unrolled_list<T, BlockSize, Alloc>::reverse() noexcept {
+  node_base_.reverse();
+
+  for (block_base_type* b = node_base_.next(); b != &node_base_;
+       b = b->next()) {
+    std::reverse(slot(b, 0), slot(b, b->size_));
+  }
+}
+
+template <typename T, std::size_t BlockSize, typename Alloc>
+template <typename BinaryPredicate>
+typename unrolled_list<T, BlockSize, Alloc>::size_type
+unrolled_list<T, BlockSize, Alloc>::unique(BinaryPredicate pred) {
+  const size_type old_size = size_;
+
+  if (!empty()) {
+    for (iterator first = begin(), next = std::next(first); next != end();) {
+      if (pred(*first, *next)) {
+        // Erasing never moves elements in front of the erased one.
+        next = erase(next);
+      } else {
+        first = next++;
+      }
+    }
+  }
+
+  return old_size - size_;
+}
+
+// Links the blocks of o in front of pos, splitting the block of pos first
+// when pos is inside it. No element of o is moved.
+template <typename T, std::size_t BlockSize, typename Alloc>
+void unrolled_list<T, BlockSize, Alloc>::splice(const_iterator pos,
+                                                this_type&& o) {
+  if (this != &o && !o.empty()) {
+#ifdef DEBUG
+    if (this->block_alloc_ != o.block_alloc_) {
+      throw std::runtime_error(
+          "s21::unrolled_list::splice(). cant splice list with different "
+          "allocator.");
+    }
+#endif
+
+    block_base_type* next = pos.block_;
+
+    if (pos.pos_ != 0) {
+      next = split(next, pos.pos_);
+    }
+    next->splice(o.node_base_.next_, &o.node_base_);
+    size_ += o.size_;
+    o.size_ = 0;
+  }
+}
+
+// The merged order is worked out on pointers, so a throwing comp changes
+// nothing. Then the blocks of o are linked at the end and the elements are
+// moved into place.
+template <typename T, std::size_t BlockSize, typename Alloc>
+template <typename Compare>
+void unrolled_list<T, BlockSize, Alloc>::merge(this_type&& o, Compare comp) {
+  if (this != &o && !o.empty()) {
+#ifdef DEBUG
+    if (this->block_alloc_ != o.block_alloc_) {
+      throw std::runtime_error(
+          "s21::unrolled_list::merge(). cant merge list with different "
+          "allocator.");
+    }
+#endif
+
+    s21::vector<pointer> lhs;
+    s21::vector<pointer> rhs;
+    s21::vector<pointer> order(size_ + o.size_);
+
+    lhs.reserve(size_);
+    rhs.reserve(o.size_);
+    for (reference val : *this) {
+      lhs.push_back(&val);
+    }
+    for (reference val : o) {
+      rhs.push_back(&val);
+    }
+    std::merge(lhs.begin(), lhs.end(), rhs.begin(), rhs.end(), order.begin(),
+               [&comp](pointer l, pointer r) { return comp(*l, *r); });
+
+    splice(end(), std::move(o));
+    arrange(order);
+  }
+}
+
+// Stable, like s21::list::sort(). A throwing comp leaves the list as it was.
+template <typename T, std::size_t BlockSize, typename Alloc>
+template <typename Compare>
+void unrolled_list<T, BlockSize, Alloc>::sort(Compare comp) {
+  s21::vector<pointer> order;
+
+  order.reserve(size_);
+  for (reference val : *this) {
+    order.push_back(&val);
+  }
+  std::stable_sort(order.begin(), order.end(),
+                   [&comp](pointer l, pointer r) { return comp(*l, *r); });
+  arrange(order);
+}
+
+// Puts the elements, given by address, into that order with the blocks kept
+// as they are. They pass through a buffer, moved when that cannot throw and
+// copied otherwise, so a throwing copy leaves the list untouched.
+template <typename T, std::size_t BlockSize, typename Alloc>
+void unrolled_list<T, BlockSize, Alloc>::arrange(
+    const s21::vector<pointer>& order) {
+  s21::vector<value_type> values;
+
+  values.reserve(order.size());
+  for (pointer p : order) {
+    values.push_back(std::move_if_noexcept(*p));
+  }
+  std::move(values.begin(), values.end(), begin());
+}
+
+template <typename T, std::size_t BlockSize, typename Alloc>
+template <typename... Args>
+typename unrolled_list<T, BlockSize, Alloc>::iterator
+unrolled_list<T, BlockSize, Alloc>::insert_many(const_iterator pos,
+                                                Args&&... args) {
+  iterator res(pos);
+
+  // Each insertion may invalidate pos, so keep inserting in front of the
+  // element that followed the previous one.
+  (..., (res = std::next(emplace(res, std::forward<Args>(args)))));
+
+  return --res;
+}
+
+template <typename T, std::size_t BlockSize, typename Alloc>
+template <typename... Args>
+void unrolled_list<T, BlockSize, Alloc>::insert_many_back(Args&&... args) {
+  (..., emplace_back(std::forward<Args>(args)));
+}
+
+template <typename T, std::size_t BlockSize, typename Alloc>
+template <typename... Args>
+void unrolled_list<T, BlockSize, Alloc>::insert_many_front(Args&&... args) {
+  insert_many(begin(), std::forward<Args>(args)...);
+}
+
+}  // namespace s21
+
+#endif  // S21_UNROLLED_LIST_H_
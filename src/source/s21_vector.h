@@ -8,6 +8,9 @@
 #include <memory>
 #include <stdexcept>
 
+#include "s21_aligned_allocator.h"
+#include "s21_stats.h"
+
 namespace s21 {
 
 namespace details {
@@ -39,9 +42,15 @@ class vector_base {
   ~vector_base() { clear(); }
 
   pointer allocate(size_type n) {
+    stats::count(stats::container::vector, stats::event::allocations);
+    stats::count(stats::container::vector, stats::event::allocated_bytes,
+                 n * sizeof(T));
     return allocator_traits::allocate(alloc_, n);
   }
   void deallocate(pointer p, size_type n) {
+    if (p) {
+      stats::count(stats::container::vector, stats::event::deallocations);
+    }
     allocator_traits::deallocate(alloc_, p, n);
   }
 
@@ -184,6 +193,9 @@ class vector : public details::vector_base<T, Alloc> {
   using const_iterator = const T*;
 
   static constexpr double growth_factor_ = 2.0;
+  // data() is a multiple of this, e.g. 64 with s21::aligned_allocator.
+  static constexpr size_type alignment_ =
+      details::allocator_alignment_v<Alloc>;
 
  public:
   vector() : base_type() {}
@@ -215,11 +227,13 @@ class vector : public details::vector_base<T, Alloc> {
   }
   reference back();
   const_reference back() const { return const_cast<this_type*>(this)->back(); }
-  pointer data() noexcept { return begin_; }
-  const_pointer data() const noexcept { return begin_; }
+  pointer data() noexcept { return assume_aligned<alignment_>(begin_); }
+  const_pointer data() const noexcept {
+    return assume_aligned<alignment_>(begin_);
+  }
 
-  iterator begin() noexcept { return begin_; }
-  const_iterator begin() const noexcept { return begin_; }
+  iterator begin() noexcept { return data(); }
+  const_iterator begin() const noexcept { return data(); }
   iterator end() noexcept { return end_; }
   const_iterator end() const noexcept { return end_; }
 
@@ -241,12 +255,23 @@ class vector : public details::vector_base<T, Alloc> {
   void pop_back() { erase(end_ - 1); }
   void swap(this_type& o) noexcept { std::swap(*this, o); }
 
+  template <typename... Args>
+  reference emplace_back(Args&&... args);
   template <typename... Args>
   iterator insert_many(const_iterator pos, Args&&... args);
   template <typename... Args>
   void insert_many_back(Args&&... args);
+
+ private:
+  void grow(size_type size) {
+    reserve(std::max(size, size_type(growth_factor_ * capacity())));
+  }
 };
 
+// Vector whose data() starts on an Align-byte boundary.
+template <typename T, std::size_t Align = 64>
+using aligned_vector = vector<T, aligned_allocator<T, Align>>;
+
 template <typename T, typename Alloc>
 vector<T, Alloc>::vector(const std::initializer_list<value_type>& items)
     : base_type() {
@@ -304,6 +329,9 @@ void vector<T, Alloc>::reserve(size_type size) {
     auto res_end = std::uninitialized_move(begin_, end_, res_begin.get());
     auto res_cap = res_begin.get() + size;
 
+    stats::count(stats::container::vector, stats::event::relocations);
+    stats::count(stats::container::vector, stats::event::relocated_elements,
+                 this->size());
     deallocate(begin_, capacity());
 
     begin_ = res_begin.release();
@@ -322,6 +350,9 @@ void vector<T, Alloc>::shrink_to_fit() {
   auto res_end = std::uninitialized_move(begin_, end_, res_begin.get());
   auto res_cap = res_begin.get() + size();
 
+  stats::count(stats::container::vector, stats::event::relocations);
+  stats::count(stats::container::vector, stats::event::relocated_elements,
+               size());
   deallocate(begin_, capacity());
 
   begin_ = res_begin.release();
@@ -392,6 +423,29 @@ typename vector<T, Alloc>::iterator vector<T, Alloc>::erase(
   return begin_ + diff;
 }
 
+template <typename T, typename Alloc>
+template <typename... Args>
+typename vector<T, Alloc>::reference vector<T, Alloc>::emplace_back(
+    Args&&... args) {
+#ifdef DEBUG
+  if (size() == max_size()) {
+    throw std::invalid_argument("s21::vector::emplace_back(). size too big.");
+  }
+#endif
+
+  if (end_ == cap_) {
+    // args may refer to an element of this vector, build the value before
+    // the storage is relocated.
+    value_type val(std::forward<Args>(args)...);
+    grow(size() + 1);
+    construct(end_, std::move(val));
+  } else {
+    construct(end_, std::forward<Args>(args)...);
+  }
+
+  return *end_++;
+}
+
 template <typename T, typename Alloc>
 template <typename... Args>
 typename vector<T, Alloc>::iterator vector<T, Alloc>::insert_many(
@@ -408,7 +462,22 @@ typename vector<T, Alloc>::iterator vector<T, Alloc>::insert_many(
 template <typename T, typename Alloc>
 template <typename... Args>
 void vector<T, Alloc>::insert_many_back(Args&&... args) {
-  insert_many(end_, std::forward<Args>(args)...);
+  if constexpr (sizeof...(Args) != 0) {
+    if (size() + sizeof...(Args) > capacity()) {
+      // args may refer to elements of this vector, build the values before
+      // the storage is relocated.
+      value_type vals[] = {value_type(std::forward<Args>(args))...};
+
+      grow(size() + sizeof...(Args));
+      for (auto& val : vals) {
+        construct(end_, std::move(val));
+        ++end_;
+      }
+      return;
+    }
+  }
+
+  (..., emplace_back(std::forward<Args>(args)));
 }
 
 }  // namespace s21
@@ -1,8 +1,24 @@
 #include <gtest/gtest.h>
 
 #include <array>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <cstddef>
+#include <cstring>
+#include <deque>
+#include <fstream>
+#include <future>
 #include <list>
+#include <map>
+#include <memory>
 #include <queue>
+#include <set>
+#include <random>
+#include <sstream>
+#include <stack>
+#include <string>
+#include <thread>
 #include <vector>
 
 #include "../s21_containers.h"
@@ -240,6 +256,65 @@ TEST(set, InsertMany) {
   EXPECT_TRUE(s1.contains(5));
   EXPECT_TRUE(s1.contains(6));
 }
+// Black nodes on every path below node, or -1 if the red-black rules break.
+int black_height(const s21::details::rb_tree_node_base* node) {
+  using color = s21::details::rb_tree_node_base::node_color;
+
+  if (!node) {
+    return 1;
+  }
+  for (const auto* child : {node->left_, node->right_}) {
+    const bool red_pair =
+        child && node->color_ == color::red && child->color_ == color::red;
+
+    if (red_pair || (child && child->parent_ != node)) {
+      return -1;
+    }
+  }
+
+  const int left = black_height(node->left_);
+  const int right = black_height(node->right_);
+
+  if (left < 0 || left != right) {
+    return -1;
+  }
+  return left + (node->color_ == color::black);
+}
+
+TEST(set, AssignUnsorted) {
+  std::mt19937_64 gen(40);
+  s21::set<std::uint64_t> s21_set({7, 8});
+  std::set<std::uint64_t> std_set;
+  std::vector<std::uint64_t> batch;
+
+  for (int n : {0, 1, 2, 3, 7, 8, 1000, 30000}) {
+    batch.clear();
+    for (int i = 0; i < n; ++i) {
+      batch.push_back(gen() % (n + 1) * 0x10001);
+    }
+    std_set = std::set<std::uint64_t>(batch.begin(), batch.end());
+    s21_set.assign_unsorted(batch.begin(), batch.end());
+
+    const auto* root = s21_set.end().node_base_->parent_;
+    EXPECT_EQ(s21_set.size(), std_set.size());
+    EXPECT_TRUE(std::equal(s21_set.begin(), s21_set.end(), std_set.begin(),
+                           std_set.end()));
+    EXPECT_GT(black_height(root), 0);
+  }
+
+  for (int i = 0; i < 5000; ++i) {
+    s21_set.insert(i * 0x10001 + 1);
+    s21_set.erase(i * 0x10001);
+  }
+  EXPECT_GT(black_height(s21_set.end().node_base_->parent_), 0);
+
+  s21::set<std::string, std::greater<std::string>> words;
+  std::vector<std::string> unsorted{"pear", "fig", "apple", "fig", "kiwi"};
+  words.assign_unsorted(unsorted.begin(), unsorted.end());
+  EXPECT_EQ(words.size(), 4U);
+  EXPECT_EQ(*words.begin(), "pear");
+}
+
 // multisetTest
 TEST(multiset, ConstructorDefaultSet) {
   s21::multiset<int> my_empty_set;
@@ -557,6 +632,34 @@ TEST(multiset, MaxSize) {
   s21::multiset<int> ms2({1, 1, 1, 2, 3, 3, 4, 5, 5});
   EXPECT_EQ(ms1.max_size(), ms2.max_size());
 }
+struct first_less {
+  bool operator()(const std::pair<int, int>& lhs,
+                  const std::pair<int, int>& rhs) const {
+    return lhs.first < rhs.first;
+  }
+};
+
+TEST(multiset, AssignUnsorted) {
+  using item = std::pair<int, int>;
+  first_less by_first;
+  s21::multiset<item, first_less> s21_multiset;
+  std::vector<item> batch;
+
+  for (int i = 0; i < 20000; ++i) {
+    batch.push_back({(i * 7919) % 300, i});
+  }
+  s21_multiset.assign_unsorted(batch.begin(), batch.end());
+  std::stable_sort(batch.begin(), batch.end(), by_first);
+  EXPECT_TRUE(std::equal(s21_multiset.begin(), s21_multiset.end(),
+                         batch.begin(), batch.end()));
+
+  s21::multiset<short> shorts;
+  std::vector<short> values{5, -3, 5, 0, -3, 5};
+  shorts.assign_unsorted(values.begin(), values.end());
+  EXPECT_EQ(shorts.count(5), 3U);
+  EXPECT_EQ(*shorts.begin(), -3);
+}
+
 // mapTest
 TEST(map, ConstructorDefaultMap) {
   s21::map<int, int> my_empty_sap;
@@ -1028,6 +1131,25 @@ TEST(map, InsertMany) {
   EXPECT_EQ(m1.contains(4), true);
 }
 
+TEST(map, AssignUnsorted) {
+  s21::map<int, int> s21_map({{1, 1}});
+  std::map<int, int> std_map;
+  std::vector<std::pair<int, int>> batch;
+
+  for (int i = 0; i < 50000; ++i) {
+    batch.push_back({int(std::int64_t(i) * 104729 % 20011) - 10000, i});
+    std_map.insert(batch.back());
+  }
+  s21_map.assign_unsorted(batch.begin(), batch.end());
+
+  EXPECT_EQ(s21_map.size(), std_map.size());
+  EXPECT_TRUE(std::equal(s21_map.begin(), s21_map.end(), std_map.begin(),
+                         std_map.end()));
+  EXPECT_EQ(s21_map.at(-10000), std_map.at(-10000));
+  s21_map[123456] = 1;
+  EXPECT_TRUE(s21_map.contains(123456));
+}
+
 // queueTest
 
 TEST(QueueMemberFunctions, TestDefault) {
@@ -1484,6 +1606,16 @@ TEST(vectorTest, InsertManyBack) {
   EXPECT_EQ(vec[5], 6);
 }
 
+TEST(vectorTest, InsertManyBackOwnElements) {
+  s21::vector<std::string> vec({"first element", "second element"});
+  vec.shrink_to_fit();
+
+  vec.insert_many_back(vec[0], vec[1]);
+  ASSERT_EQ(vec.size(), 4ul);
+  EXPECT_EQ(vec[2], "first element");
+  EXPECT_EQ(vec[3], "second element");
+}
+
 TEST(vectorTest, AtExcept1) {
   s21::vector<int> vec;
   EXPECT_THROW(vec.at(4), std::out_of_range);
@@ -1697,6 +1829,39 @@ TEST(list, ModifierSort) {
   }
 }
 
+TEST(list, ModifierSortCompareStable) {
+  s21::list<std::pair<int, int>> s21_list;
+  std::list<std::pair<int, int>> std_list;
+  for (int i = 0; i < 1000; ++i) {
+    s21_list.push_back({i * 37 % 17, i});
+    std_list.push_back({i * 37 % 17, i});
+  }
+  auto cmp = [](const auto& lhs, const auto& rhs) {
+    return lhs.first > rhs.first;
+  };
+  s21_list.sort(cmp);
+  std_list.sort(cmp);
+  EXPECT_EQ(s21_list.size(), std_list.size());
+  EXPECT_TRUE(std::equal(s21_list.begin(), s21_list.end(), std_list.begin()));
+  EXPECT_TRUE(std::equal(std::make_reverse_iterator(s21_list.end()),
+                         std::make_reverse_iterator(s21_list.begin()),
+                         std_list.rbegin()));
+}
+
+TEST(list, ModifierSortThrowingCompare) {
+  s21::list<int> s21_list{5, 3, 8, 1, 9, 2, 7};
+  int calls = 0;
+  EXPECT_THROW(s21_list.sort([&calls](int lhs, int rhs) {
+    if (++calls == 5) throw std::runtime_error("cmp");
+    return lhs < rhs;
+  }),
+               std::runtime_error);
+  s21_list.sort();
+  s21::list<int> expected{1, 2, 3, 5, 7, 8, 9};
+  EXPECT_TRUE(std::equal(s21_list.begin(), s21_list.end(), expected.begin(),
+                         expected.end()));
+}
+
 TEST(list, Splice) {
   s21::list<int> our_list_first({1});
   s21::list<int> our_list_second({2, 3, 4, 5});
@@ -1727,6 +1892,85 @@ TEST(list, ModifierSplice) {
   }
 }
 
+TEST(list, ModifierSpliceElementAndRange) {
+  s21::list<int> s21_list1{1, 2, 3, 4, 5};
+  std::list<int> std_list1{1, 2, 3, 4, 5};
+  s21::list<int> s21_list2{10, 20, 30, 40, 50};
+  std::list<int> std_list2{10, 20, 30, 40, 50};
+  s21_list1.splice(s21_list1.begin(), s21_list2, ++s21_list2.begin());
+  std_list1.splice(std_list1.begin(), std_list2, ++std_list2.begin());
+  s21_list1.splice(s21_list1.end(), s21_list2, s21_list2.begin(),
+                   --s21_list2.end());
+  std_list1.splice(std_list1.end(), std_list2, std_list2.begin(),
+                   --std_list2.end());
+  s21_list1.splice(s21_list1.begin(), s21_list1, --s21_list1.end());
+  std_list1.splice(std_list1.begin(), std_list1, --std_list1.end());
+  s21_list1.splice(s21_list1.begin(), s21_list1, s21_list1.begin());
+  std_list1.splice(std_list1.begin(), std_list1, std_list1.begin());
+  EXPECT_EQ(s21_list1.size(), std_list1.size());
+  EXPECT_EQ(s21_list2.size(), std_list2.size());
+  EXPECT_TRUE(std::equal(s21_list1.begin(), s21_list1.end(),
+                         std_list1.begin(), std_list1.end()));
+  EXPECT_TRUE(std::equal(s21_list2.begin(), s21_list2.end(),
+                         std_list2.begin(), std_list2.end()));
+}
+
+TEST(list, ModifierSpliceRangeWithCount) {
+  s21::list<int> s21_list1{1, 2, 3};
+  s21::list<int> s21_list2{10, 20, 30, 40, 50};
+  std::list<int> std_list1{1, 2, 3};
+  std::list<int> std_list2{10, 20, 30, 40, 50};
+  auto s21_last = std::next(s21_list2.begin(), 4);
+  s21_list1.splice(++s21_list1.begin(), s21_list2, ++s21_list2.begin(),
+                   s21_last, 3);
+  std_list1.splice(++std_list1.begin(), std_list2, ++std_list2.begin(),
+                   std::next(std_list2.begin(), 4));
+  s21_list1.splice(s21_list1.end(), s21_list1, s21_list1.begin(),
+                   ++s21_list1.begin(), 1);
+  std_list1.splice(std_list1.end(), std_list1, std_list1.begin(),
+                   ++std_list1.begin());
+  EXPECT_EQ(s21_list1.size(), std_list1.size());
+  EXPECT_EQ(s21_list2.size(), std_list2.size());
+  EXPECT_TRUE(std::equal(s21_list1.begin(), s21_list1.end(),
+                         std_list1.begin(), std_list1.end()));
+  EXPECT_TRUE(std::equal(s21_list2.begin(), s21_list2.end(),
+                         std_list2.begin(), std_list2.end()));
+#ifdef DEBUG
+  EXPECT_THROW(s21_list1.splice(s21_list1.end(), s21_list2,
+                                s21_list2.begin(), s21_list2.end(), 1),
+               std::invalid_argument);
+#endif
+}
+
+TEST(list, ModifierMergeCompare) {
+  s21::list<int> s21_list1{9, 7, 3, 1};
+  std::list<int> std_list1{9, 7, 3, 1};
+  s21::list<int> s21_list2{8, 7, 2};
+  std::list<int> std_list2{8, 7, 2};
+  s21_list1.merge(s21_list2, std::greater<int>());
+  std_list1.merge(std_list2, std::greater<int>());
+  EXPECT_EQ(s21_list1.size(), std_list1.size());
+  EXPECT_TRUE(s21_list2.empty());
+  EXPECT_TRUE(std::equal(s21_list1.begin(), s21_list1.end(),
+                         std_list1.begin(), std_list1.end()));
+}
+
+TEST(list, ModifierRemoveAndUniquePredicate) {
+  s21::list<int> s21_list{1, 2, 2, 3, 4, 4, 4, 5, 6, 1};
+  std::list<int> std_list{1, 2, 2, 3, 4, 4, 4, 5, 6, 1};
+  EXPECT_EQ(s21_list.remove(s21_list.front()), size_t(2));
+  std_list.remove(1);
+  EXPECT_EQ(s21_list.remove_if([](int x) { return x == 5; }), size_t(1));
+  std_list.remove_if([](int x) { return x == 5; });
+  auto pred = [](int lhs, int rhs) { return rhs - lhs <= 1; };
+  EXPECT_EQ(s21_list.unique(pred), size_t(4));
+  std_list.unique(pred);
+  EXPECT_EQ(s21_list.size(), std_list.size());
+  EXPECT_TRUE(std::equal(s21_list.begin(), s21_list.end(), std_list.begin(),
+                         std_list.end()));
+  EXPECT_EQ(s21_list.remove(7), size_t(0));
+}
+
 TEST(list, Insert_Many) {
   s21::list<int> our_list({1, 2, 3, 4, 5});
   s21::list<int>::const_iterator our_it = our_list.begin();
@@ -1941,6 +2185,2196 @@ TEST(arrayTest, ConstData) {
   for (auto i = 0, c = 0; i < 5; ++i) EXPECT_EQ(*(iter + i), ++c);
 }
 
+// Reflected CRC-32 table, built by the compiler.
+constexpr s21::array<std::uint32_t, 256> crc32_table() {
+  s21::array<std::uint32_t, 256> table{};
+
+  for (std::uint32_t i = 0; i < 256; ++i) {
+    std::uint32_t crc = i;
+    for (int bit = 0; bit < 8; ++bit) {
+      crc = crc & 1 ? 0xEDB88320u ^ (crc >> 1) : crc >> 1;
+    }
+    table[i] = crc;
+  }
+
+  return table;
+}
+
+constexpr s21::array<int, 7> sorted_primes() {
+  s21::array<int, 7> primes{{13, 2, 17, 5, 3, 11, 7}};
+  primes.sort();
+  return primes;
+}
+
+template class s21::array<int, 0>;
+
+TEST(arrayTest, Constexpr) {
+  constexpr auto table = crc32_table();
+  static_assert(table[1] == 0x77073096u);
+  static_assert(table[255] == 0x2D02EF8Du);
+
+  constexpr auto primes = sorted_primes();
+  static_assert(primes == s21::to_array({2, 3, 5, 7, 11, 13, 17}));
+  static_assert(*primes.lower_bound(6) == 7);
+  static_assert(primes.lower_bound(18) == primes.end());
+  static_assert(primes.find(11) - primes.begin() == 4);
+  static_assert(primes.find(4) == primes.end());
+  static_assert(s21::get<6>(primes) == 17);
+  static_assert(std::tuple_size_v<decltype(primes)> == 7);
+
+  constexpr auto word = s21::to_array("abc");
+  static_assert(word.size() == 4 && word[3] == '\0');
+  static_assert(s21::to_array({1, 2}) < s21::to_array({1, 3}));
+  static_assert(s21::to_array({2, 0}) >= s21::to_array({1, 9}));
+  static_assert(s21::to_array({1, 2}) != s21::to_array({2, 1}));
+
+  constexpr s21::array<int, 0> empty{};
+  static_assert(empty.find(1) == empty.end());
+  static_assert(std::is_same_v<decltype(empty[0]), const int&>);
+}
+
+TEST(arrayTest, AlgorithmsAndStructuredBindings) {
+  s21::array<std::string, 3> words{{"pear", "fig", "apple"}};
+  words.sort(std::greater<>());
+  auto& [first, second, third] = words;
+  EXPECT_EQ(first, "pear");
+  EXPECT_EQ(second, "fig");
+  EXPECT_EQ(third, "apple");
+  EXPECT_EQ(words.lower_bound("banana", std::greater<>()), &third);
+
+  s21::array<std::string, 3> other{{"x", "y", "z"}};
+  swap(words, other);
+  EXPECT_EQ(other[0], "pear");
+  EXPECT_EQ(words[2], "z");
+  words.swap(words);
+  EXPECT_EQ(words[0], "x");
+  EXPECT_TRUE(words > other);
+
+  s21::array<int, 100> big{};
+  for (int i = 0; i < 100; ++i) {
+    big[i] = (i * 37) % 100;
+  }
+  big.sort();
+  for (int i = 0; i < 100; ++i) {
+    EXPECT_EQ(big[i], i);
+  }
+}
+
+// ringBufferTest
+
+TEST(ringBuffer, PushPopWrap) {
+  s21::ring_buffer<int> s21_buf;
+  std::queue<int> std_queue;
+  for (int i = 0; i < 1000; ++i) {
+    s21_buf.push_back(i);
+    std_queue.push(i);
+    if (i % 3 == 0) {
+      s21_buf.pop_front();
+      std_queue.pop();
+    }
+  }
+  EXPECT_EQ(s21_buf.size(), std_queue.size());
+  while (!std_queue.empty()) {
+    EXPECT_EQ(s21_buf.front(), std_queue.front());
+    s21_buf.pop_front(), std_queue.pop();
+  }
+  EXPECT_TRUE(s21_buf.empty());
+}
+
+TEST(ringBuffer, BothEnds) {
+  s21::ring_buffer<int> s21_buf{3, 4};
+  s21_buf.push_front(2);
+  s21_buf.push_front(1);
+  s21_buf.push_back(5);
+  EXPECT_EQ(s21_buf.size(), size_t(5));
+  for (size_t i = 0; i < s21_buf.size(); ++i) {
+    EXPECT_EQ(s21_buf[i], static_cast<int>(i) + 1);
+  }
+  s21_buf.pop_back();
+  EXPECT_EQ(s21_buf.back(), 4);
+  EXPECT_THROW(s21_buf.at(4), std::out_of_range);
+}
+
+TEST(ringBuffer, CopyMove) {
+  s21::ring_buffer<std::string> s21_buf;
+  for (int i = 0; i < 40; ++i) {
+    s21_buf.push_front(std::to_string(i));
+  }
+  s21::ring_buffer<std::string> s21_copy(s21_buf);
+  s21::ring_buffer<std::string> s21_move(std::move(s21_buf));
+  EXPECT_TRUE(s21_buf.empty());
+  EXPECT_EQ(s21_copy.size(), s21_move.size());
+  auto it = s21_move.begin();
+  for (const auto& str : s21_copy) {
+    EXPECT_EQ(str, *it++);
+  }
+  EXPECT_EQ(s21_copy.front(), "39");
+}
+
+TEST(ringBuffer, ReserveInsertMany) {
+  s21::ring_buffer<int> s21_buf;
+  s21_buf.reserve(17);
+  EXPECT_EQ(s21_buf.capacity(), size_t(32));
+  s21_buf.insert_many_back(4, 5, 6);
+  s21_buf.insert_many_front(1, 2, 3);
+  int c = 0;
+  for (auto val : s21_buf) {
+    EXPECT_EQ(val, ++c);
+  }
+  EXPECT_EQ(c, 6);
+}
+
+TEST(ringBuffer, PushOwnElementWhenFull) {
+  s21::ring_buffer<std::string> s21_buf;
+  s21_buf.push_back("a string too long for the small buffer");
+  while (s21_buf.size() != s21_buf.capacity()) {
+    s21_buf.push_back(std::to_string(s21_buf.size()));
+  }
+
+  s21_buf.push_back(s21_buf.front());
+  EXPECT_EQ(s21_buf.back(), "a string too long for the small buffer");
+  while (s21_buf.size() != s21_buf.capacity()) {
+    s21_buf.push_back(s21_buf.back());
+  }
+  s21_buf.push_front(s21_buf.back());
+  EXPECT_EQ(s21_buf.front(), "a string too long for the small buffer");
+  while (s21_buf.size() != s21_buf.capacity()) {
+    s21_buf.push_back("x");
+  }
+  s21_buf.insert_many_back(s21_buf.front(), s21_buf.back());
+  EXPECT_EQ(s21_buf[s21_buf.size() - 2],
+            "a string too long for the small buffer");
+  EXPECT_EQ(s21_buf.back(), "x");
+}
+
+// Copied on relocation, since its move may throw, and fails on the copy
+// given.
+struct ring_throwing {
+  ring_throwing(int val) : val_(std::to_string(val) + " on the heap, please") {}
+  ring_throwing(const ring_throwing& o) : val_(o.val_) {
+    if (--copies_left_ == 0) {
+      throw std::runtime_error("copy");
+    }
+  }
+
+  std::string val_;
+  static inline int copies_left_ = 0;
+};
+
+TEST(ringBuffer, ThrowingRelocationKeepsElements) {
+  s21::ring_buffer<ring_throwing> s21_buf;
+  s21_buf.reserve(16);
+  for (int i = 0; i < 16; ++i) {
+    s21_buf.emplace_back(i);
+  }
+
+  ring_throwing::copies_left_ = 8;
+  EXPECT_THROW(s21_buf.reserve(64), std::runtime_error);
+  ring_throwing::copies_left_ = 0;
+
+  EXPECT_EQ(s21_buf.capacity(), 16u);
+  ASSERT_EQ(s21_buf.size(), 16u);
+  for (int i = 0; i < 16; ++i) {
+    EXPECT_EQ(s21_buf[i].val_, std::to_string(i) + " on the heap, please");
+  }
+}
+
+// dequeTest
+
+TEST(deque, PushPopBothEnds) {
+  s21::deque<int> s21_deque;
+  std::deque<int> std_deque;
+  for (int i = 0; i < 5000; ++i) {
+    if (i % 2) {
+      s21_deque.push_back(i), std_deque.push_back(i);
+    } else {
+      s21_deque.push_front(i), std_deque.push_front(i);
+    }
+    if (i % 7 == 0) {
+      s21_deque.pop_back(), std_deque.pop_back();
+    }
+    if (i % 11 == 0 && !std_deque.empty()) {
+      s21_deque.pop_front(), std_deque.pop_front();
+    }
+  }
+  ASSERT_EQ(s21_deque.size(), std_deque.size());
+  for (size_t i = 0; i < std_deque.size(); ++i) {
+    EXPECT_EQ(s21_deque[i], std_deque[i]);
+  }
+  EXPECT_EQ(s21_deque.front(), std_deque.front());
+  EXPECT_EQ(s21_deque.back(), std_deque.back());
+}
+
+TEST(deque, FifoReusesBlocks) {
+  s21::deque<int> s21_deque;
+  long long sum = 0;
+  for (int i = 0; i < 100000; ++i) {
+    s21_deque.push_back(i);
+    if (s21_deque.size() > 100) {
+      sum += s21_deque.front();
+      s21_deque.pop_front();
+    }
+  }
+  EXPECT_EQ(s21_deque.size(), size_t(100));
+  EXPECT_EQ(s21_deque.front(), 99900);
+  EXPECT_EQ(sum, 99899LL * 99900 / 2);
+}
+
+TEST(deque, CopyMoveIterators) {
+  s21::deque<std::string> s21_deque{"b", "c"};
+  s21_deque.insert_many_front("x", "a");
+  s21_deque.insert_many_back("d", "e");
+  s21_deque.pop_front();
+  s21::deque<std::string> s21_copy = s21_deque;
+  s21::deque<std::string> s21_move = std::move(s21_deque);
+  EXPECT_TRUE(s21_deque.empty());
+  std::string res;
+  for (const auto& str : s21_copy) {
+    res += str;
+  }
+  EXPECT_EQ(res, "abcde");
+  EXPECT_EQ(s21_move.end() - s21_move.begin(), 5);
+  EXPECT_EQ(s21_move.at(4), "e");
+  EXPECT_THROW(s21_move.at(5), std::out_of_range);
+}
+
+TEST(deque, RandomAccessIteratorOperators) {
+  s21::deque<int> s21_deque;
+  s21::ring_buffer<int> s21_buf;
+  unsigned seed = 26;
+  for (int i = 0; i < 1000; ++i) {
+    seed = seed * 1103515245 + 12345;
+    s21_deque.push_front(int(seed >> 16));
+    s21_buf.push_front(int(seed >> 16));
+  }
+
+  const auto& const_deque = s21_deque;
+  auto first = const_deque.begin();
+  auto last = 2 + first;
+  EXPECT_TRUE(last > first && first < last);
+  EXPECT_TRUE(first <= first && last >= first && !(first >= last));
+  const auto& const_buf = s21_buf;
+  EXPECT_TRUE(s21_buf.begin() <= 3 + const_buf.begin());
+
+  std::sort(s21_deque.begin(), s21_deque.end(), std::greater<int>());
+  std::sort(s21_buf.begin(), s21_buf.end());
+  const auto reversed = std::make_reverse_iterator(s21_deque.end());
+  EXPECT_TRUE(std::is_sorted(reversed, std::make_reverse_iterator(
+                                           s21_deque.begin())));
+  EXPECT_TRUE(std::equal(s21_buf.begin(), s21_buf.end(), reversed));
+}
+
+TEST(Queue, UnderlyingContainers) {
+  s21::queue<int, s21::deque<int>> s21_deque_queue{1, 2, 3};
+  s21::queue<int, s21::list<int>> s21_list_queue{1, 2, 3};
+  s21_deque_queue.insert_many_back(4, 5);
+  s21_list_queue.insert_many_back(4, 5);
+  while (!s21_list_queue.empty()) {
+    EXPECT_EQ(s21_deque_queue.front(), s21_list_queue.front());
+    s21_deque_queue.pop(), s21_list_queue.pop();
+  }
+  EXPECT_TRUE(s21_deque_queue.empty());
+}
+
+// stackTest
+
+TEST(stack, PushPopTop) {
+  s21::stack<int> s21_stack{1, 2, 3};
+  std::stack<int> std_stack;
+  std_stack.push(1), std_stack.push(2), std_stack.push(3);
+  for (int i = 4; i < 1000; ++i) {
+    s21_stack.push(i), std_stack.push(i);
+  }
+  EXPECT_EQ(s21_stack.size(), std_stack.size());
+  while (!std_stack.empty()) {
+    EXPECT_EQ(s21_stack.top(), std_stack.top());
+    s21_stack.pop(), std_stack.pop();
+  }
+  EXPECT_TRUE(s21_stack.empty());
+}
+
+TEST(stack, EmplaceMovePush) {
+  s21::stack<std::string> s21_stack;
+  s21_stack.reserve(8);
+  std::string str(100, 'a');
+  s21_stack.push(std::move(str));
+  EXPECT_TRUE(str.empty());
+  EXPECT_EQ(s21_stack.emplace(3, 'b'), "bbb");
+  EXPECT_EQ(s21_stack.top(), "bbb");
+  s21_stack.pop();
+  EXPECT_EQ(s21_stack.top(), std::string(100, 'a'));
+}
+
+TEST(stack, InsertManyBackCopySwap) {
+  s21::stack<int> s21_stack_1;
+  s21_stack_1.insert_many_back(1, 2, 3);
+  s21::stack<int> s21_stack_2(s21_stack_1);
+  s21::stack<int> s21_stack_3{7};
+  s21_stack_2.swap(s21_stack_3);
+  EXPECT_EQ(s21_stack_1.top(), 3);
+  EXPECT_EQ(s21_stack_3.top(), 3);
+  EXPECT_EQ(s21_stack_3.size(), size_t(3));
+  EXPECT_EQ(s21_stack_2.top(), 7);
+}
+
+TEST(stack, ListContainer) {
+  s21::stack<std::string, s21::list<std::string>> s21_stack{"a"};
+  s21_stack.emplace(2, 'b');
+  s21_stack.insert_many_back("c", "d");
+  EXPECT_EQ(s21_stack.size(), size_t(4));
+  EXPECT_EQ(s21_stack.top(), "d");
+  s21_stack.pop(), s21_stack.pop();
+  EXPECT_EQ(s21_stack.top(), "bb");
+}
+
+// spscQueueTest
+
+TEST(spscQueue, TryPushPop) {
+  s21::spsc_queue<std::string> s21_queue(3);
+  EXPECT_EQ(s21_queue.capacity(), size_t(4));
+  for (int i = 0; i < 4; ++i) {
+    EXPECT_TRUE(s21_queue.try_push(std::to_string(i)));
+  }
+  EXPECT_FALSE(s21_queue.try_push("x"));
+  EXPECT_EQ(s21_queue.size(), size_t(4));
+  std::string str;
+  for (int i = 0; i < 4; ++i) {
+    EXPECT_TRUE(s21_queue.try_pop(str));
+    EXPECT_EQ(str, std::to_string(i));
+  }
+  EXPECT_FALSE(s21_queue.try_pop(str));
+  EXPECT_TRUE(s21_queue.empty());
+  s21_queue.insert_many_back("a", "b");
+  EXPECT_EQ(s21_queue.size(), size_t(2));
+  EXPECT_THROW(s21::spsc_queue<int>(0), std::invalid_argument);
+}
+
+TEST(spscQueue, Bulk) {
+  s21::spsc_queue<int> s21_queue(8);
+  std::vector<int> in{1, 2, 3, 4, 5, 6, 7, 8, 9, 10};
+  std::vector<int> out(10);
+  EXPECT_EQ(s21_queue.push_bulk(in.begin(), in.size()), size_t(8));
+  EXPECT_EQ(s21_queue.pop_bulk(out.begin(), 5), size_t(5));
+  EXPECT_EQ(s21_queue.push_bulk(in.begin() + 8, 2), size_t(2));
+  EXPECT_EQ(s21_queue.pop_bulk(out.begin() + 5, 10), size_t(5));
+  EXPECT_EQ(in, out);
+}
+
+// Output iterator that throws on the write given.
+struct throwing_output {
+  throwing_output& operator*() { return *this; }
+  throwing_output& operator++() { return *this; }
+  throwing_output& operator=(std::string value) {
+    if (--writes_left_ == 0) {
+      throw std::runtime_error("write");
+    }
+    values_->push_back(std::move(value));
+    return *this;
+  }
+
+  std::vector<std::string>* values_;
+  int writes_left_;
+};
+
+TEST(spscQueue, BulkPopThrowKeepsRest) {
+  s21::spsc_queue<std::string> s21_queue(8);
+  std::vector<std::string> in{"a", "b", "c", "d"};
+  std::vector<std::string> out;
+  EXPECT_EQ(s21_queue.push_bulk(in.begin(), in.size()), size_t(4));
+  EXPECT_THROW(s21_queue.pop_bulk(throwing_output{&out, 3}, 4),
+               std::runtime_error);
+  EXPECT_EQ(out, std::vector<std::string>({"a", "b"}));
+  EXPECT_EQ(s21_queue.size(), size_t(2));
+  EXPECT_EQ(s21_queue.pop_bulk(throwing_output{&out, 0}, 4), size_t(2));
+  EXPECT_EQ(out.back(), "d");
+}
+
+TEST(spscQueue, StressOrder) {
+  constexpr int n = 1000000;
+  s21::spsc_queue<int> s21_queue(1024);
+  std::thread producer([&] {
+    int buf[32];
+    for (int i = 0; i < n;) {
+      if (i % 3 == 0) {
+        int k = 0;
+        for (; k < 32 && i + k < n; ++k) buf[k] = i + k;
+        const size_t pushed = s21_queue.push_bulk(buf, k);
+        if (pushed == 0) std::this_thread::yield();
+        i += int(pushed);
+      } else {
+        s21_queue.push(i++);
+      }
+    }
+  });
+  bool ordered = true;
+  int buf[32];
+  for (int expected = 0; expected < n;) {
+    size_t k = s21_queue.pop_bulk(buf, 32);
+    if (k == 0) std::this_thread::yield();
+    for (size_t j = 0; j < k; ++j) ordered &= buf[j] == expected++;
+  }
+  producer.join();
+  EXPECT_TRUE(ordered);
+  EXPECT_TRUE(s21_queue.empty());
+}
+
+// mpmcQueueTest
+
+TEST(mpmcQueue, TryPushPop) {
+  s21::mpmc_queue<std::string> s21_queue(4);
+  s21_queue.insert_many_back("0", "1");
+  EXPECT_TRUE(s21_queue.try_push("2"));
+  EXPECT_TRUE(s21_queue.try_emplace(1, '3'));
+  EXPECT_FALSE(s21_queue.try_push("4"));
+  EXPECT_EQ(s21_queue.size(), size_t(4));
+  std::string str;
+  for (int i = 0; i < 4; ++i) {
+    EXPECT_TRUE(s21_queue.try_pop(str));
+    EXPECT_EQ(str, std::to_string(i));
+  }
+  EXPECT_FALSE(s21_queue.try_pop(str));
+  EXPECT_TRUE(s21_queue.try_push("leftover"));
+}
+
+TEST(mpmcQueue, Bulk) {
+  s21::mpmc_queue<int> s21_queue(8);
+  int in[10] = {1, 2, 3, 4, 5, 6, 7, 8, 9, 10};
+  int out[10] = {};
+  EXPECT_EQ(s21_queue.push_bulk(in, 10), size_t(8));
+  EXPECT_EQ(s21_queue.pop_bulk(out, 3), size_t(3));
+  EXPECT_EQ(s21_queue.push_bulk(in + 8, 2), size_t(2));
+  EXPECT_EQ(s21_queue.pop_bulk(out + 3, 10), size_t(7));
+  for (int i = 0; i < 10; ++i) EXPECT_EQ(in[i], out[i]);
+}
+
+TEST(mpmcQueue, BulkThrowingValues) {
+  s21::mpmc_queue<std::string> s21_queue(4);
+  std::vector<std::string> in{"first long string", "second long string",
+                              "third long string", "fourth long string",
+                              "fifth long string"};
+  std::vector<std::string> out;
+  EXPECT_EQ(s21_queue.push_bulk(in.begin(), in.size()), size_t(4));
+  EXPECT_THROW(s21_queue.pop_bulk(throwing_output{&out, 2}, 4),
+               std::runtime_error);
+  EXPECT_EQ(out, std::vector<std::string>({"first long string"}));
+  // The slots of the dropped values are free again.
+  EXPECT_TRUE(s21_queue.empty());
+  EXPECT_EQ(s21_queue.push_bulk(in.begin(), in.size()), size_t(4));
+  EXPECT_EQ(s21_queue.pop_bulk(throwing_output{&out, 0}, 4), size_t(4));
+  EXPECT_EQ(out.back(), "fourth long string");
+}
+
+TEST(mpmcQueue, StressManyThreads) {
+  constexpr int threads = 4;
+  constexpr long long per_thread = 100000;
+  s21::mpmc_queue<long long> s21_queue(256);
+  std::atomic<long long> sum{0};
+  std::atomic<long long> popped{0};
+  std::vector<std::thread> workers;
+  for (int t = 0; t < threads; ++t) {
+    workers.emplace_back([&, t] {
+      for (long long i = 0; i < per_thread;) {
+        long long buf[8];
+        int k = 0;
+        for (; k < 8 && i + k < per_thread; ++k) {
+          buf[k] = t * per_thread + i + k;
+        }
+        const size_t pushed = s21_queue.push_bulk(buf, k);
+        if (pushed == 0) std::this_thread::yield();
+        i += (long long)pushed;
+      }
+    });
+    workers.emplace_back([&] {
+      long long local = 0, val = 0;
+      while (popped.load() < threads * per_thread) {
+        if (s21_queue.try_pop(val)) {
+          local += val;
+          popped.fetch_add(1);
+        } else {
+          std::this_thread::yield();
+        }
+      }
+      sum.fetch_add(local);
+    });
+  }
+  for (auto& worker : workers) worker.join();
+  const long long n = threads * per_thread;
+  EXPECT_EQ(popped.load(), n);
+  EXPECT_EQ(sum.load(), n * (n - 1) / 2);
+  EXPECT_TRUE(s21_queue.empty());
+}
+
+// concurrentStackTest
+
+TEST(concurrentStack, PushPopTop) {
+  s21::concurrent_stack<std::string> s21_stack;
+  std::stack<std::string> std_stack;
+  std::string str;
+  EXPECT_TRUE(s21_stack.empty());
+  EXPECT_FALSE(s21_stack.top(str));
+  EXPECT_FALSE(s21_stack.try_pop(str));
+  s21_stack.insert_many_back("0", "1");
+  s21_stack.push("2");
+  s21_stack.emplace(1, '3');
+  std_stack.push("0");
+  std_stack.push("1");
+  std_stack.push("2");
+  std_stack.push("3");
+  while (!std_stack.empty()) {
+    EXPECT_TRUE(s21_stack.top(str));
+    EXPECT_EQ(str, std_stack.top());
+    EXPECT_TRUE(s21_stack.try_pop(str));
+    EXPECT_EQ(str, std_stack.top());
+    std_stack.pop();
+  }
+  EXPECT_TRUE(s21_stack.empty());
+  s21_stack.push("leftover");
+}
+
+TEST(concurrentStack, MoveOnly) {
+  s21::concurrent_stack<std::unique_ptr<int>, true> s21_stack;
+  s21_stack.push(std::make_unique<int>(1));
+  s21_stack.emplace(new int(2));
+  std::unique_ptr<int> ptr;
+  s21_stack.pop(ptr);
+  EXPECT_EQ(*ptr, 2);
+  s21_stack.pop(ptr);
+  EXPECT_EQ(*ptr, 1);
+  EXPECT_TRUE(s21_stack.empty());
+}
+
+template <bool Elimination>
+void concurrent_stack_stress() {
+  constexpr int threads = 4;
+  constexpr long long per_thread = 50000;
+  s21::concurrent_stack<std::string, Elimination> s21_stack;
+  std::atomic<long long> sum{0};
+  std::atomic<long long> popped{0};
+  std::vector<std::thread> workers;
+  for (int t = 0; t < threads; ++t) {
+    workers.emplace_back([&, t] {
+      for (long long i = 0; i < per_thread; ++i) {
+        s21_stack.push(std::to_string(t * per_thread + i));
+      }
+    });
+    workers.emplace_back([&] {
+      long long local = 0;
+      std::string val;
+      while (popped.load() < threads * per_thread) {
+        if (s21_stack.try_pop(val)) {
+          local += std::stoll(val);
+          popped.fetch_add(1);
+        } else {
+          std::this_thread::yield();
+        }
+      }
+      sum.fetch_add(local);
+    });
+  }
+  workers.emplace_back([&] {
+    std::string val;
+    while (popped.load() < threads * per_thread) {
+      if (s21_stack.top(val)) {
+        EXPECT_FALSE(val.empty());
+      }
+      std::this_thread::yield();
+    }
+  });
+  for (auto& worker : workers) worker.join();
+  const long long n = threads * per_thread;
+  EXPECT_EQ(popped.load(), n);
+  EXPECT_EQ(sum.load(), n * (n - 1) / 2);
+  EXPECT_TRUE(s21_stack.empty());
+}
+
+TEST(concurrentStack, StressManyThreads) { concurrent_stack_stress<false>(); }
+
+TEST(concurrentStack, StressElimination) { concurrent_stack_stress<true>(); }
+
+// concurrentMapTest
+
+TEST(concurrentMap, InsertFindErase) {
+  s21::concurrent_map<int, std::string> s21_map = {{5, "5"}, {1, "1"}};
+  std::map<int, std::string> std_map = {{5, "5"}, {1, "1"}};
+  EXPECT_TRUE(s21_map.insert(3, "3").second);
+  EXPECT_FALSE(s21_map.insert(3, "three").second);
+  EXPECT_EQ(s21_map.emplace(std::make_pair(4, "4")).first->second, "4");
+  s21_map.insert_many(std::make_pair(2, "2"), std::make_pair(0, "0"));
+  std_map.insert({{3, "3"}, {4, "4"}, {2, "2"}, {0, "0"}});
+  EXPECT_EQ(s21_map.size(), std_map.size());
+  auto it = std_map.begin();
+  for (const auto& item : s21_map) {
+    EXPECT_EQ(item, *it++);
+  }
+  EXPECT_EQ(s21_map.find(3)->second, "3");
+  EXPECT_TRUE(s21_map.find(7) == s21_map.end());
+  EXPECT_TRUE(s21_map.contains(0));
+  EXPECT_EQ(s21_map.erase(3), size_t(1));
+  EXPECT_EQ(s21_map.erase(3), size_t(0));
+  EXPECT_FALSE(s21_map.contains(3));
+  EXPECT_EQ(s21_map.lower_bound(3)->first, 4);
+  EXPECT_EQ(s21_map.upper_bound(4)->first, 5);
+  EXPECT_TRUE(s21_map.upper_bound(5) == s21_map.end());
+  EXPECT_EQ(s21_map.size(), size_t(5));
+}
+
+TEST(concurrentMap, EraseAll) {
+  s21::concurrent_map<int, int> s21_map;
+  for (int i = 0; i < 1000; ++i) s21_map.insert(i * 7 % 1000, i);
+  EXPECT_EQ(s21_map.size(), size_t(1000));
+  for (int i = 0; i < 1000; ++i) EXPECT_EQ(s21_map.erase(i), size_t(1));
+  EXPECT_TRUE(s21_map.empty());
+  EXPECT_TRUE(s21_map.begin() == s21_map.end());
+}
+
+TEST(concurrentMap, StressManyThreads) {
+  constexpr int threads = 4;
+  constexpr int per_thread = 20000;
+  s21::concurrent_map<int, int> s21_map;
+  std::atomic<bool> done{false};
+  std::vector<std::thread> workers;
+  for (int t = 0; t < threads; ++t) {
+    workers.emplace_back([&, t] {
+      for (int i = 0; i < per_thread; ++i) {
+        const int key = i * threads + t;
+        EXPECT_TRUE(s21_map.insert(key, key).second);
+        if (i % 2) {
+          EXPECT_EQ(s21_map.erase(key - threads), size_t(1));
+        }
+      }
+    });
+  }
+  std::thread reader([&] {
+    while (!done.load()) {
+      int prev = -1;
+      for (const auto& item : s21_map) {
+        EXPECT_LT(prev, item.first);
+        EXPECT_EQ(item.first, item.second);
+        prev = item.first;
+      }
+      std::this_thread::yield();
+    }
+  });
+  for (auto& worker : workers) worker.join();
+  done.store(true);
+  reader.join();
+  EXPECT_EQ(s21_map.size(), size_t(threads * per_thread / 2));
+  int count = 0;
+  for (auto it = s21_map.begin(); it != s21_map.end(); ++it, ++count) {
+    EXPECT_EQ(it->first / threads % 2, 1);
+  }
+  EXPECT_EQ(count, threads * per_thread / 2);
+}
+
+// intrusiveListTest
+
+namespace {
+
+struct by_order;
+struct by_priority;
+
+// Private data and a virtual function: not a standard-layout type.
+class intrusive_item : public s21::list_hook<by_order>,
+                       public s21::list_hook<by_priority> {
+ public:
+  explicit intrusive_item(int value) : value(value) {}
+  virtual ~intrusive_item() = default;
+  bool operator<(const intrusive_item& o) const { return value < o.value; }
+  bool in_order_list() const {
+    return static_cast<const s21::list_hook<by_order>&>(*this).is_linked();
+  }
+
+  int value;
+
+ private:
+  std::string name_ = "item";
+};
+
+using order_list = s21::intrusive_list<intrusive_item, by_order>;
+using priority_list = s21::intrusive_list<intrusive_item, by_priority>;
+
+std::vector<int> values(const order_list& list) {
+  std::vector<int> res;
+  for (const auto& item : list) res.push_back(item.value);
+  return res;
+}
+
+}  // namespace
+
+TEST(intrusiveList, PushEraseByObject) {
+  std::vector<intrusive_item> items;
+  for (int i = 0; i < 5; ++i) items.emplace_back(i);
+  order_list list;
+  for (auto& item : items) list.push_back(item);
+  list.pop_front();
+  list.push_back(items[0]);
+  EXPECT_EQ(list.size(), size_t(5));
+  EXPECT_TRUE(items[2].in_order_list());
+  list.erase(items[2]);
+  EXPECT_FALSE(items[2].in_order_list());
+  EXPECT_EQ(values(list), std::vector<int>({1, 3, 4, 0}));
+  list.pop_back();
+  EXPECT_EQ(list.back().value, 4);
+  EXPECT_EQ(list.front().value, 1);
+  list.clear();
+  EXPECT_TRUE(list.empty());
+  for (const auto& item : items) EXPECT_FALSE(item.in_order_list());
+}
+
+TEST(intrusiveList, TwoHooksSortMergeSplice) {
+  std::vector<intrusive_item> items;
+  for (int i = 0; i < 10; ++i) items.emplace_back(i * 7 % 10);
+  order_list odd, even;
+  priority_list all;
+  for (auto& item : items) {
+    (item.value % 2 ? odd : even).push_back(item);
+    all.push_front(item);
+  }
+  odd.sort();
+  even.sort();
+  odd.merge(even);
+  EXPECT_TRUE(even.empty());
+  EXPECT_EQ(values(odd), std::vector<int>({0, 1, 2, 3, 4, 5, 6, 7, 8, 9}));
+  EXPECT_EQ(all.size(), size_t(10));
+  EXPECT_EQ(all.front().value, items.back().value);
+  odd.erase(order_list::iterator_to(items[1]));
+  odd.erase(items[0]);
+  even.push_back(items[0]);
+  odd.splice(odd.begin(), even);
+  EXPECT_EQ(odd.size(), size_t(9));
+  EXPECT_EQ(odd.front().value, items[0].value);
+  odd.reverse();
+  EXPECT_EQ(odd.back().value, items[0].value);
+  order_list moved(std::move(odd));
+  EXPECT_TRUE(odd.empty());
+  EXPECT_EQ(moved.size(), size_t(9));
+}
+
+// unrolledListTest
+
+TEST(unrolledList, RandomInsertEraseMatchesStd) {
+  s21::unrolled_list<int, 4> s21_list;
+  std::list<int> std_list;
+  unsigned seed = 12345;
+
+  for (int step = 0; step < 4000; ++step) {
+    seed = seed * 1103515245 + 12345;
+    const std::size_t at = (seed >> 8) % (std_list.size() + 1);
+    auto s21_it = std::next(s21_list.begin(), at);
+    auto std_it = std::next(std_list.begin(), at);
+
+    if ((seed >> 4) % 3 != 0 || std_list.empty() || at == std_list.size()) {
+      EXPECT_EQ(*s21_list.insert(s21_it, step), *std_list.insert(std_it, step));
+    } else {
+      auto s21_next = s21_list.erase(s21_it);
+      auto std_next = std_list.erase(std_it);
+
+      EXPECT_EQ(std::distance(s21_list.begin(), s21_next),
+                std::distance(std_list.begin(), std_next));
+    }
+  }
+
+  EXPECT_EQ(s21_list.size(), std_list.size());
+  EXPECT_TRUE(std::equal(s21_list.begin(), s21_list.end(), std_list.begin(),
+                         std_list.end()));
+  EXPECT_TRUE(std::equal(std::make_reverse_iterator(s21_list.end()),
+                         std::make_reverse_iterator(s21_list.begin()),
+                         std_list.rbegin(), std_list.rend()));
+}
+
+TEST(unrolledList, FrontBackCopyReverseUnique) {
+  s21::unrolled_list<std::string, 3> s21_list{"b", "b", "c"};
+
+  s21_list.push_front("a");
+  s21_list.emplace_front(1, 'a');
+  s21_list.push_back("d");
+  s21_list.insert_many_back("d", "e");
+  s21_list.insert_many_front("0");
+  s21_list.emplace(s21_list.end(), s21_list.front());
+
+  s21::unrolled_list<std::string, 3> copy(s21_list);
+  EXPECT_EQ(copy.unique(), 3U);
+  std::list<std::string> expected{"0", "a", "b", "c", "d", "e", "0"};
+  EXPECT_TRUE(std::equal(copy.begin(), copy.end(), expected.begin(),
+                         expected.end()));
+
+  copy.reverse();
+  expected.reverse();
+  EXPECT_TRUE(std::equal(copy.begin(), copy.end(), expected.begin(),
+                         expected.end()));
+  EXPECT_EQ(s21_list.size(), 10U);
+
+  s21_list = std::move(copy);
+  EXPECT_EQ(s21_list.front(), "0");
+  EXPECT_EQ(s21_list.back(), "0");
+  s21_list.pop_front();
+  s21_list.pop_back();
+  EXPECT_EQ(s21_list.front(), "e");
+  EXPECT_EQ(s21_list.back(), "a");
+  EXPECT_TRUE(copy.empty());
+
+  s21_list.clear();
+  EXPECT_TRUE(s21_list.empty());
+  EXPECT_EQ(s21_list.begin(), s21_list.end());
+}
+
+TEST(unrolledList, SpliceMergeSortMatchStd) {
+  using item = std::pair<int, int>;
+  auto by_first = [](const item& lhs, const item& rhs) {
+    return lhs.first < rhs.first;
+  };
+  std::mt19937 gen(34);
+
+  for (int round = 0; round < 20; ++round) {
+    s21::unrolled_list<item, 4> s21_lhs, s21_rhs;
+    std::list<item> std_lhs, std_rhs;
+
+    for (int i = 0, n = int(gen() % 40); i < n; ++i) {
+      s21_lhs.push_back({int(gen() % 10), i});
+      std_lhs.push_back(s21_lhs.back());
+    }
+    for (int i = 0, n = int(gen() % 40); i < n; ++i) {
+      s21_rhs.push_back({int(gen() % 10), 100 + i});
+      std_rhs.push_back(s21_rhs.back());
+    }
+
+    auto s21_copy = s21_lhs;
+    auto std_copy = std_lhs;
+    const std::size_t at = gen() % (std_copy.size() + 1);
+    auto s21_rhs_copy = s21_rhs;
+    auto std_rhs_copy = std_rhs;
+    s21_copy.splice(std::next(s21_copy.begin(), at), s21_rhs_copy);
+    std_copy.splice(std::next(std_copy.begin(), at), std_rhs_copy);
+    EXPECT_TRUE(s21_rhs_copy.empty());
+    EXPECT_EQ(s21_copy.size(), std_copy.size());
+    EXPECT_TRUE(std::equal(s21_copy.begin(), s21_copy.end(), std_copy.begin(),
+                           std_copy.end()));
+    EXPECT_TRUE(std::equal(std::make_reverse_iterator(s21_copy.end()),
+                           std::make_reverse_iterator(s21_copy.begin()),
+                           std_copy.rbegin(), std_copy.rend()));
+
+    s21_copy.sort(by_first);
+    std_copy.sort(by_first);
+    EXPECT_TRUE(std::equal(s21_copy.begin(), s21_copy.end(), std_copy.begin(),
+                           std_copy.end()));
+
+    s21_lhs.sort(by_first), std_lhs.sort(by_first);
+    s21_rhs.sort(by_first), std_rhs.sort(by_first);
+    s21_lhs.merge(s21_rhs, by_first);
+    std_lhs.merge(std_rhs, by_first);
+    EXPECT_TRUE(s21_rhs.empty());
+    EXPECT_EQ(s21_lhs.size(), std_lhs.size());
+    EXPECT_TRUE(std::equal(s21_lhs.begin(), s21_lhs.end(), std_lhs.begin(),
+                           std_lhs.end()));
+  }
+
+  s21::unrolled_list<int, 4> s21_list{5, 3, 1, 4, 2};
+  s21_list.sort();
+  s21::unrolled_list<int, 4> other{0, 6};
+  s21_list.merge(other);
+  EXPECT_EQ(std::vector<int>(s21_list.begin(), s21_list.end()),
+            std::vector<int>({0, 1, 2, 3, 4, 5, 6}));
+}
+
+TEST(unrolledList, ThrowingSplitKeepsList) {
+  s21::unrolled_list<ring_throwing, 4> s21_list;
+  for (int i = 0; i < 4; ++i) {
+    s21_list.emplace_back(i);
+  }
+
+  ring_throwing::copies_left_ = 1;
+  EXPECT_THROW(s21_list.emplace(std::next(s21_list.begin(), 2), 9),
+               std::runtime_error);
+  ring_throwing::copies_left_ = 0;
+
+  EXPECT_EQ(s21_list.size(), 4u);
+  EXPECT_EQ(std::distance(s21_list.begin(), s21_list.end()), 4);
+  s21_list.emplace(std::next(s21_list.begin(), 2), 9);
+  std::vector<std::string> values;
+  for (const auto& val : s21_list) {
+    values.push_back(val.val_.substr(0, 1));
+  }
+  EXPECT_EQ(values, std::vector<std::string>({"0", "1", "9", "2", "3"}));
+}
+
+TEST(unrolledList, ThrowingMergeKeepsList) {
+  s21::unrolled_list<ring_throwing, 8> s21_list;
+  for (int i = 0; i < 16; ++i) {
+    s21_list.emplace_back(i);
+  }
+  for (int i = 0; i < 5; ++i) {
+    s21_list.erase(std::next(s21_list.begin(), 8));
+  }
+  for (int i = 0; i < 6; ++i) {
+    s21_list.erase(s21_list.begin());
+  }
+
+  // Leaves one element in the first block, which then takes in the next.
+  ring_throwing::copies_left_ = 2;
+  s21_list.erase(s21_list.begin());
+  ring_throwing::copies_left_ = 0;
+
+  std::vector<std::string> values;
+  for (const auto& val : s21_list) {
+    values.push_back(val.val_.substr(0, 2));
+  }
+  EXPECT_EQ(values, std::vector<std::string>({"7 ", "13", "14", "15"}));
+  EXPECT_EQ(s21_list.size(), 4u);
+}
+
+// compactListTest
+
+TEST(compactList, RandomOpsMatchStd) {
+  s21::compact_list_pool<int> pool;
+  s21::compact_list<int> s21_list(pool);
+  std::list<int> std_list;
+  unsigned seed = 777;
+
+  EXPECT_EQ(pool.node_size(), 12U);
+  for (int step = 0; step < 3000; ++step) {
+    seed = seed * 1103515245 + 12345;
+    const std::size_t at = (seed >> 8) % (std_list.size() + 1);
+    auto s21_it = std::next(s21_list.begin(), at);
+    auto std_it = std::next(std_list.begin(), at);
+
+    if ((seed >> 4) % 3 != 0 || at == std_list.size()) {
+      EXPECT_EQ(*s21_list.insert(s21_it, step), *std_list.insert(std_it, step));
+    } else {
+      s21_list.erase(s21_it);
+      std_list.erase(std_it);
+    }
+  }
+
+  EXPECT_EQ(s21_list.size(), std_list.size());
+  EXPECT_EQ(pool.size(), s21_list.size() + 1);
+  EXPECT_TRUE(std::equal(s21_list.begin(), s21_list.end(), std_list.begin(),
+                         std_list.end()));
+  s21_list.reverse();
+  std_list.reverse();
+  EXPECT_TRUE(std::equal(std::make_reverse_iterator(s21_list.end()),
+                         std::make_reverse_iterator(s21_list.begin()),
+                         std_list.rbegin(), std_list.rend()));
+  s21_list.sort();
+  std_list.sort();
+  EXPECT_TRUE(std::equal(s21_list.begin(), s21_list.end(), std_list.begin(),
+                         std_list.end()));
+}
+
+TEST(compactList, SpliceMergeRemoveCopy) {
+  s21::compact_list_pool<std::string> pool;
+  s21::compact_list<std::string> a(pool, {"a", "c", "e"});
+  s21::compact_list<std::string> b(pool, {"b", "d", "f", "x"});
+
+  a.splice(a.end(), b, --b.end());
+  EXPECT_EQ(a.back(), "x");
+  a.pop_back();
+  b.splice(b.begin(), a, a.begin(), ++a.begin(), 1);
+  EXPECT_EQ(b.front(), "a");
+  a.merge(b);
+  EXPECT_TRUE(b.empty());
+  std::list<std::string> expected{"a", "b", "c", "d", "e", "f"};
+  EXPECT_TRUE(std::equal(a.begin(), a.end(), expected.begin(),
+                         expected.end()));
+
+  s21::compact_list<std::string> copy(a);
+  EXPECT_EQ(copy.remove(copy.front()), 1U);
+  EXPECT_EQ(copy.remove_if([](const std::string& s) { return s > "d"; }), 2U);
+  expected = {"b", "c", "d"};
+  EXPECT_TRUE(std::equal(copy.begin(), copy.end(), expected.begin(),
+                         expected.end()));
+
+  s21::compact_list_pool<std::string> other;
+  s21::compact_list<std::string> moved(other, {"z"});
+  moved = std::move(copy);
+  EXPECT_EQ(&moved.pool(), &pool);
+  EXPECT_EQ(moved.size(), 3U);
+  EXPECT_TRUE(copy.empty());
+  b.splice(b.end(), a);
+  EXPECT_EQ(b.size(), 6U);
+  // Elements plus one sentinel for each of a, b and moved; the moved-from
+  // copy gave its sentinel away.
+  EXPECT_EQ(pool.size(), 6U + 3U + 3U);
+}
+
+TEST(compactList, MoveDoesNotAllocate) {
+  using list_type = s21::compact_list<int>;
+  static_assert(std::is_nothrow_move_constructible_v<list_type>);
+  static_assert(std::is_nothrow_move_assignable_v<list_type>);
+
+  s21::compact_list_pool<int> pool;
+  s21::vector<list_type> lists;
+  for (int i = 0; i < 40; ++i) {
+    lists.emplace_back(pool, std::initializer_list<int>{i, i + 1});
+  }
+  EXPECT_EQ(pool.size(), 40U * 3U);
+  EXPECT_EQ(lists[39].back(), 40);
+
+  list_type taken(std::move(lists[0]));
+  list_type& empty = lists[0];
+  EXPECT_TRUE(empty.empty());
+  EXPECT_EQ(empty.begin(), empty.end());
+  empty.reverse();
+  empty.sort();
+  EXPECT_EQ(pool.size(), 40U * 3U);
+
+  empty.splice(empty.end(), taken, taken.begin());
+  empty.push_front(-1);
+  empty.merge(taken);
+  EXPECT_EQ(std::vector<int>(empty.begin(), empty.end()),
+            std::vector<int>({-1, 0, 1}));
+  EXPECT_EQ(pool.size(), 40U * 3U + 2U);
+}
+
+// executionTest
+
+TEST(execution, VectorAlgorithmsMatchStd) {
+  s21::vector<int> s21_vec;
+  std::vector<int> std_vec;
+  unsigned seed = 99;
+
+  for (int i = 0; i < 100000; ++i) {
+    seed = seed * 1103515245 + 12345;
+    s21_vec.push_back(int(seed >> 8) % 100000);
+    std_vec.push_back(int(seed >> 8) % 100000);
+  }
+
+  s21::for_each(s21::par, s21_vec, [](int& val) { val = val * 2 + 1; });
+  std::for_each(std_vec.begin(), std_vec.end(),
+                [](int& val) { val = val * 2 + 1; });
+  EXPECT_TRUE(std::equal(s21_vec.begin(), s21_vec.end(), std_vec.begin(),
+                         std_vec.end()));
+
+  std::vector<long long> squares(s21_vec.size());
+  EXPECT_EQ(s21::transform(s21::par, s21_vec, squares.begin(),
+                           [](int val) { return 1LL * val * val; }),
+            squares.end());
+  EXPECT_EQ(squares[777], 1LL * std_vec[777] * std_vec[777]);
+
+  EXPECT_EQ(s21::reduce(s21::par, s21_vec, 0LL),
+            std::accumulate(std_vec.begin(), std_vec.end(), 0LL));
+  auto is_small = [](int val) { return val < 1000; };
+  EXPECT_EQ(s21::count_if(s21::par, s21_vec, is_small),
+            std::count_if(std_vec.begin(), std_vec.end(), is_small));
+  EXPECT_EQ(s21::find_if(s21::par, s21_vec, is_small) - s21_vec.begin(),
+            std::find_if(std_vec.begin(), std_vec.end(), is_small) -
+                std_vec.begin());
+  EXPECT_EQ(s21::find_if(s21::par, s21_vec, [](int val) { return val < 0; }),
+            s21_vec.end());
+
+  std::vector<int> copied(s21_vec.size());
+  s21::copy(s21::par, s21_vec, copied.begin());
+  EXPECT_EQ(copied, std_vec);
+
+  s21::sort(s21::par, s21_vec);
+  std::sort(std_vec.begin(), std_vec.end());
+  EXPECT_TRUE(std::equal(s21_vec.begin(), s21_vec.end(), std_vec.begin(),
+                         std_vec.end()));
+  s21::sort(s21::par, s21_vec, std::greater<int>());
+  EXPECT_TRUE(std::is_sorted(s21_vec.begin(), s21_vec.end(),
+                             std::greater<int>()));
+}
+
+TEST(execution, TreeAndArrayAlgorithms) {
+  s21::set<int> s21_set;
+  s21::map<int, int> s21_map;
+
+  for (int i = 0; i < 60000; ++i) {
+    s21_set.insert(i * 7 % 60000);
+    s21_map.insert({i, 0});
+  }
+
+  std::vector<int> keys(s21_set.size());
+  s21::copy(s21::par, s21_set, keys.begin());
+  for (int i = 0; i < 60000; ++i) {
+    EXPECT_EQ(keys[i], i);
+  }
+
+  EXPECT_EQ(s21::reduce(s21::par, s21_set, 0LL), 60000LL * 59999 / 2);
+  EXPECT_EQ(s21::count_if(s21::par, s21_set, [](int val) { return val % 3; }),
+            40000);
+  EXPECT_EQ(*s21::find_if(s21::par, s21_set, [](int val) { return val > 123; }),
+            124);
+
+  s21::for_each(s21::par, s21_map,
+                [](auto& item) { item.second = -item.first; });
+  EXPECT_EQ(s21_map[31337], -31337);
+  EXPECT_EQ(s21::count_if(s21::par, s21_map,
+                          [](const auto& item) {
+                            return item.first + item.second == 0;
+                          }),
+            60000);
+
+  s21::set<int> empty;
+  EXPECT_EQ(s21::reduce(s21::par, empty, 5), 5);
+  EXPECT_EQ(s21::find_if(s21::par, empty, [](int) { return true; }),
+            empty.end());
+
+  s21::array<int, 20000> arr;
+  for (int i = 0; i < 20000; ++i) {
+    arr[i] = 20000 - i;
+  }
+  s21::sort(s21::par, arr);
+  EXPECT_TRUE(std::is_sorted(arr.begin(), arr.end()));
+  EXPECT_EQ(s21::reduce(s21::par, arr, 0LL), 20000LL * 20001 / 2);
+}
+
+TEST(execution, ExceptionReachesCaller) {
+  s21::vector<int> vec(50000, 1);
+  vec[40000] = 0;
+
+  EXPECT_THROW(s21::for_each(s21::par, vec,
+                             [](int val) {
+                               if (val == 0) {
+                                 throw std::runtime_error("zero");
+                               }
+                             }),
+               std::runtime_error);
+}
+
+TEST(execution, StableSortKeepsTiesAndReusesScratch) {
+  std::mt19937 gen(39);
+  s21::vector<std::pair<int, int>> s21_vec;
+  std::vector<std::pair<int, int>> std_vec;
+  auto by_first = [](const auto& lhs, const auto& rhs) {
+    return lhs.first < rhs.first;
+  };
+
+  for (int i = 0; i < 70000; ++i) {
+    s21_vec.push_back({int(gen() % 500), i});
+    std_vec.push_back(s21_vec.back());
+  }
+
+  s21::vector<std::pair<int, int>> scratch;
+  s21::stable_sort(s21::par, s21_vec, by_first, scratch);
+  std::stable_sort(std_vec.begin(), std_vec.end(), by_first);
+  EXPECT_TRUE(std::equal(s21_vec.begin(), s21_vec.end(), std_vec.begin(),
+                         std_vec.end()));
+
+  const auto* buffer = scratch.data();
+  EXPECT_GE(scratch.size(), s21_vec.size());
+  s21::sort(s21::par, s21_vec, std::greater<>(), scratch);
+  EXPECT_EQ(scratch.data(), buffer);
+  EXPECT_TRUE(std::is_sorted(s21_vec.begin(), s21_vec.end(),
+                             std::greater<>()));
+
+  s21::vector<std::string> words;
+  for (int i = 0; i < 9000; ++i) {
+    words.push_back(std::to_string(gen() % 100000));
+  }
+  s21::stable_sort(s21::par, words);
+  EXPECT_TRUE(std::is_sorted(words.begin(), words.end()));
+}
+
+TEST(execution, RadixSortIntegersAndFloats) {
+  std::mt19937_64 gen(39);
+  s21::vector<long long> ints;
+  s21::vector<unsigned char> bytes;
+  s21::vector<double> doubles;
+  s21::vector<float> floats;
+
+  for (int i = 0; i < 50000; ++i) {
+    ints.push_back(static_cast<long long>(gen()));
+    bytes.push_back(gen() % 256);
+    doubles.push_back(std::ldexp(double(gen() % 2000) - 1000.0, i % 40 - 20));
+    floats.push_back(float(int(gen() % 20000) - 10000) / 7.0f);
+  }
+  std::vector<long long> std_ints(ints.begin(), ints.end());
+  std::vector<double> std_doubles(doubles.begin(), doubles.end());
+
+  s21::radix_sort(s21::par, ints);
+  std::sort(std_ints.begin(), std_ints.end());
+  EXPECT_TRUE(std::equal(ints.begin(), ints.end(), std_ints.begin(),
+                         std_ints.end()));
+
+  s21::vector<double> scratch;
+  s21::radix_sort(doubles, scratch);
+  std::sort(std_doubles.begin(), std_doubles.end());
+  EXPECT_TRUE(std::equal(doubles.begin(), doubles.end(), std_doubles.begin(),
+                         std_doubles.end()));
+
+  s21::radix_sort(bytes);
+  EXPECT_TRUE(std::is_sorted(bytes.begin(), bytes.end()));
+  s21::sort(s21::par, floats);
+  EXPECT_TRUE(std::is_sorted(floats.begin(), floats.end()));
+
+  s21::vector<int> same(10000, -3);
+  s21::radix_sort(s21::par, same);
+  EXPECT_EQ(std::count(same.begin(), same.end(), -3), 10000);
+}
+
+// threadPoolTest
+
+TEST(threadPool, NestedWaitGroups) {
+  s21::thread_pool pool(3);
+  std::function<long long(int, int)> sum = [&](int from, int to) {
+    if (to - from <= 100) {
+      long long res = 0;
+      for (int i = from; i < to; ++i) {
+        res += i;
+      }
+      return res;
+    }
+
+    long long left = 0;
+    s21::wait_group group(pool);
+    group.run([&] { left = sum(from, from + (to - from) / 2); });
+    const long long right = sum(from + (to - from) / 2, to);
+    group.wait();
+
+    return left + right;
+  };
+
+  EXPECT_EQ(sum(0, 100000), 100000LL * 99999 / 2);
+  EXPECT_EQ(pool.concurrency(), 4U);
+}
+
+TEST(threadPool, SubmitAndParallelFor) {
+  s21::thread_pool pool(2);
+  std::future<int> answer = pool.submit([] { return 42; });
+  std::future<void> failure =
+      pool.submit([] { throw std::runtime_error("task failed"); });
+  std::vector<std::atomic<int>> hits(10007);
+
+  pool.parallel_for(0, 10007, [&](int i) { hits[i].fetch_add(i % 7 + 1); });
+  pool.parallel_for(5, 5, [&](int) { hits[0] = -1; });
+  for (int i = 0; i < 10007; ++i) {
+    EXPECT_EQ(hits[i].load(), i % 7 + 1);
+  }
+  EXPECT_EQ(answer.get(), 42);
+  EXPECT_THROW(failure.get(), std::runtime_error);
+
+  s21::wait_group group(pool);
+  group.run([] { throw std::logic_error("first"); });
+  EXPECT_THROW(group.wait(), std::logic_error);
+  group.wait();
+}
+
+TEST(threadPool, WaitGroupDestroysTasksBeforeWait) {
+  s21::thread_pool pool(3);
+  auto token = std::make_shared<int>(0);
+
+  // Only the copy inside the task is slow to let go of the token.
+  struct slow_release {
+    explicit slow_release(std::shared_ptr<int> token)
+        : token_(std::move(token)) {}
+    slow_release(slow_release&&) = default;
+    ~slow_release() {
+      if (token_) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(5));
+      }
+    }
+
+    std::shared_ptr<int> token_;
+  };
+
+  for (int round = 0; round < 5; ++round) {
+    s21::wait_group group(pool);
+    for (int i = 0; i < 8; ++i) {
+      group.run([held = slow_release(token)] { (void)held; });
+    }
+    group.wait();
+    EXPECT_EQ(token.use_count(), 1);
+  }
+}
+
+TEST(chaseLevDeque, OwnerAndThieves) {
+  s21::details::chase_lev_deque<int*> deque;
+  constexpr int n = 20000;
+  std::vector<int> items(n);
+  std::atomic<long long> stolen_sum{0};
+  std::atomic<bool> done{false};
+  long long taken_sum = 0;
+
+  std::vector<std::thread> thieves;
+  for (int t = 0; t < 2; ++t) {
+    thieves.emplace_back([&] {
+      int* item = nullptr;
+      while (!done.load()) {
+        if (deque.steal(item)) {
+          stolen_sum += *item;
+        } else {
+          std::this_thread::yield();
+        }
+      }
+    });
+  }
+
+  int* item = nullptr;
+  for (int i = 0; i < n; ++i) {
+    items[i] = i;
+    deque.push(&items[i]);
+    if (i % 3 == 0 && deque.take(item)) {
+      taken_sum += *item;
+    }
+  }
+  while (deque.take(item)) {
+    taken_sum += *item;
+  }
+  done = true;
+  for (auto& thief : thieves) {
+    thief.join();
+  }
+
+  EXPECT_TRUE(deque.empty());
+  EXPECT_EQ(taken_sum + stolen_sum.load(), 1LL * n * (n - 1) / 2);
+}
+
+// staticMapTest
+
+constexpr s21::static_map<std::string_view, int, 8> http_methods({
+    {"GET", 1},
+    {"HEAD", 2},
+    {"POST", 3},
+    {"PUT", 4},
+    {"DELETE", 5},
+    {"CONNECT", 6},
+    {"OPTIONS", 7},
+    {"TRACE", 8},
+});
+
+TEST(staticMap, ConstexprLookup) {
+  static_assert(http_methods.at("PUT") == 4);
+  static_assert(http_methods.contains("TRACE"));
+  static_assert(!http_methods.contains("PATCH"));
+  static_assert(http_methods.find("") == http_methods.end());
+  static_assert(http_methods.size() == 8);
+
+  std::string method = "OPTIONS";
+  EXPECT_EQ(http_methods.at(method), 7);
+  EXPECT_EQ(http_methods.count(std::string("GETS")), 0U);
+  EXPECT_THROW(http_methods.at("get"), std::out_of_range);
+
+  int sum = 0;
+  for (const auto& [name, code] : http_methods) {
+    EXPECT_EQ(http_methods.find(name)->second, code);
+    sum += code;
+  }
+  EXPECT_EQ(sum, 36);
+}
+
+TEST(staticMap, IntegerKeysAndRuntimeBuild) {
+  constexpr s21::static_map<int, char, 4> digits(
+      {{10, 'a'}, {-3, 'b'}, {700, 'c'}, {0, 'd'}});
+  static_assert(digits.at(700) == 'c' && digits.at(-3) == 'b');
+  static_assert(!digits.contains(1));
+
+  s21::array<std::pair<std::uint32_t, std::uint32_t>, 300> squares;
+  for (std::uint32_t i = 0; i < 300; ++i) {
+    squares[i] = {i * 7919, i * i};
+  }
+  s21::static_map<std::uint32_t, std::uint32_t, 300> lookup(squares);
+  for (std::uint32_t i = 0; i < 300; ++i) {
+    EXPECT_EQ(lookup.at(i * 7919), i * i);
+    EXPECT_FALSE(lookup.contains(i * 7919 + 1));
+  }
+  lookup.find(7919)->second = 0;
+  EXPECT_EQ(lookup.at(7919), 0U);
+
+  EXPECT_THROW((s21::static_map<int, int, 2>({{1, 1}, {1, 2}})),
+               std::invalid_argument);
+}
+
+// alignedAllocatorTest
+
+template <std::size_t Align, typename T>
+bool is_aligned(const T* p) {
+  return reinterpret_cast<std::uintptr_t>(p) % Align == 0;
+}
+
+constexpr s21::aligned_array<int, 4, 32> sorted_quad() {
+  s21::aligned_array<int, 4, 32> quad{3, 1, 2, 0};
+  quad.sort();
+  return quad;
+}
+
+TEST(alignedAllocator, VectorDataIsAligned) {
+  s21::aligned_vector<float> s21_vec;
+  static_assert(decltype(s21_vec)::alignment_ == 64);
+  static_assert(s21::vector<double>::alignment_ == alignof(double));
+
+  for (int i = 0; i < 1000; ++i) {
+    s21_vec.push_back(float(i));
+    EXPECT_TRUE(is_aligned<64>(s21_vec.data()));
+  }
+  s21_vec.shrink_to_fit();
+  EXPECT_TRUE(is_aligned<64>(s21_vec.data()));
+
+  s21::vector<double, s21::aligned_allocator<double, 32>> doubles(37, 1.5);
+  auto copy = doubles;
+  EXPECT_TRUE(is_aligned<32>(copy.data()));
+  EXPECT_EQ(std::accumulate(copy.begin(), copy.end(), 0.0), 37 * 1.5);
+
+  // Rebinding there and back gives the original allocator type, and a
+  // more aligned type still gets its own alignment.
+  struct alignas(128) wide_node {
+    char c;
+  };
+  using node_alloc = std::allocator_traits<
+      s21::aligned_allocator<int, 32>>::rebind_alloc<wide_node>;
+  static_assert(
+      std::is_same_v<std::allocator_traits<node_alloc>::rebind_alloc<int>,
+                     s21::aligned_allocator<int, 32>>);
+  static_assert(node_alloc::alignment == 128);
+  wide_node* node = node_alloc().allocate(3);
+  EXPECT_TRUE(is_aligned<128>(node));
+  node_alloc().deallocate(node, 3);
+
+  s21::list<int, s21::aligned_allocator<int, 32>> s21_list{1, 2, 3};
+  s21_list.push_front(0);
+  EXPECT_EQ(s21_list.front(), 0);
+  EXPECT_EQ(s21_list.size(), 4U);
+}
+
+TEST(alignedAllocator, AlignedArray) {
+  static_assert(alignof(s21::aligned_array<char, 3, 64>) == 64);
+  static_assert(sizeof(s21::aligned_array<float, 8, 32>) == 32);
+
+  constexpr auto quad = sorted_quad();
+  static_assert(s21::get<0>(quad) == 0 && quad.back() == 3);
+  static_assert(quad == s21::to_array({0, 1, 2, 3}));
+
+  s21::aligned_array<double, 5> values{};
+  values.fill(2.0);
+  auto& [a, b, c, d, e] = values;
+  EXPECT_EQ(a + b + c + d + e, 10.0);
+  EXPECT_TRUE(is_aligned<64>(values.data()));
+  EXPECT_TRUE(is_aligned<64>(s21::assume_aligned<64>(values.data())));
+}
+
+// mdspanTest
+
+TEST(mdspan, LayoutsMapIndices) {
+  using grid = s21::extents<3, s21::dynamic_extent>;
+  static_assert(grid::rank() == 2 && grid::rank_dynamic() == 1);
+  static_assert(s21::dextents<3>::rank_dynamic() == 3);
+
+  s21::vector<int> storage(12, 0);
+  s21::mdspan<int, grid> rows(storage.data(), 4);
+  s21::mdspan<int, grid, s21::layout_left> cols(storage.data(), 4);
+
+  EXPECT_EQ(rows.extent(0), 3U);
+  EXPECT_EQ(rows.extent(1), 4U);
+  EXPECT_EQ(rows.size(), 12U);
+  for (std::size_t i = 0; i < 3; ++i) {
+    for (std::size_t j = 0; j < 4; ++j) {
+      EXPECT_EQ(&rows(i, j), storage.data() + i * 4 + j);
+      EXPECT_EQ(&cols(i, j), storage.data() + j * 3 + i);
+    }
+  }
+  EXPECT_EQ(rows.mapping().stride(0), 4U);
+  EXPECT_EQ(cols.mapping().stride(1), 3U);
+
+  s21::mdspan<const int, grid> read_only = rows;
+  rows(2, 3) = 7;
+  EXPECT_EQ(read_only.at(2, 3), 7);
+  EXPECT_THROW(read_only.at(3, 0), std::out_of_range);
+  EXPECT_THROW(read_only.at(0, 4), std::out_of_range);
+}
+
+TEST(mdspan, TiledLayoutIsBijective) {
+  using tiled = s21::layout_tiled<4, 8>::mapping<s21::dextents<2>>;
+  const tiled map(s21::dextents<2>(10, 13));
+
+  // 3 x 2 tiles of 32 elements, padding included.
+  EXPECT_EQ(map.required_span_size(), 192U);
+  EXPECT_EQ(map(0, 7), 7U);
+  EXPECT_EQ(map(1, 0), 8U);
+  EXPECT_EQ(map(0, 8), 32U);
+  EXPECT_EQ(map(4, 0), 64U);
+
+  std::vector<bool> used(map.required_span_size());
+  for (std::size_t i = 0; i < 10; ++i) {
+    for (std::size_t j = 0; j < 13; ++j) {
+      ASSERT_LT(map(i, j), used.size());
+      EXPECT_FALSE(used[map(i, j)]);
+      used[map(i, j)] = true;
+    }
+  }
+}
+
+TEST(mdspan, ForEachIndexFollowsStorage) {
+  s21::mdarray<int, s21::dextents<3>> rows(2, 3, 4);
+  s21::mdarray<int, s21::dextents<3>, s21::layout_left> cols(2, 3, 4);
+  s21::mdarray<int, s21::extents<5, 7>, s21::layout_tiled<2, 4>> tiles;
+
+  for (auto* m : {&rows.container(), &cols.container()}) {
+    EXPECT_EQ(m->size(), 24U);
+  }
+  static_assert(std::is_same_v<decltype(tiles)::container_type,
+                               s21::array<int, 48>>);
+
+  std::size_t visits = 0;
+  std::size_t last = 0;
+  bool ascending = true;
+  auto check = [&](const auto& m) {
+    visits = 0;
+    ascending = true;
+    s21::for_each_index(m, [&](auto... i) {
+      const std::size_t offset = m.mapping()(i...);
+      ascending = ascending && (visits == 0 || offset > last);
+      last = offset;
+      ++visits;
+    });
+  };
+
+  check(rows);
+  EXPECT_EQ(visits, 24U);
+  EXPECT_TRUE(ascending);
+  check(cols);
+  EXPECT_EQ(visits, 24U);
+  EXPECT_TRUE(ascending);
+  check(tiles.view());
+  EXPECT_EQ(visits, 35U);
+  EXPECT_TRUE(ascending);
+}
+
+TEST(mdspan, MdarrayOwnsStorage) {
+  s21::mdarray<double, s21::extents<2, 3>> fixed;
+  static_assert(sizeof(fixed.container()) == 6 * sizeof(double));
+  EXPECT_EQ(fixed(1, 2), 0.0);
+
+  s21::mdarray<double, s21::extents<s21::dynamic_extent, 3>> grid(
+      s21::extents<s21::dynamic_extent, 3>(2), 1.5);
+  EXPECT_EQ(grid.extent(0), 2U);
+  EXPECT_EQ(grid.size(), 6U);
+  EXPECT_EQ(std::accumulate(grid.data(), grid.data() + grid.size(), 0.0), 9.0);
+
+  // A 3-point stencil written against the view.
+  auto in = grid.view();
+  s21::mdarray<double, s21::extents<s21::dynamic_extent, 3>> out(2);
+  s21::for_each_index(out, [&](std::size_t i, std::size_t j) {
+    const double left = j > 0 ? in(i, j - 1) : 0.0;
+    const double right = j + 1 < in.extent(1) ? in(i, j + 1) : 0.0;
+    out(i, j) = left + in(i, j) + right;
+  });
+  EXPECT_EQ(out(0, 0), 3.0);
+  EXPECT_EQ(out(1, 1), 4.5);
+
+  const auto& cout = out;
+  EXPECT_EQ(cout.at(1, 2), 3.0);
+  EXPECT_THROW(cout.at(2, 0), std::out_of_range);
+  EXPECT_EQ(fixed.extents(), (s21::extents<2, 3>()));
+  EXPECT_NE(grid.extents(), (s21::extents<s21::dynamic_extent, 3>(3)));
+}
+
+// soaVectorTest
+
+struct throws_on_copy {
+  throws_on_copy() = default;
+  throws_on_copy(const throws_on_copy& o) : fail(o.fail) {
+    if (fail) {
+      throw std::runtime_error("copy");
+    }
+  }
+  throws_on_copy(throws_on_copy&&) noexcept = default;
+  throws_on_copy& operator=(const throws_on_copy&) = default;
+  bool fail = false;
+};
+
+TEST(soaVector, FieldsAreContiguous) {
+  s21::soa_vector<float, int, std::string> rows;
+
+  for (int i = 0; i < 100; ++i) {
+    rows.emplace_back(float(i) / 2, i * i, std::to_string(i));
+  }
+  rows.push_back({-1.0f, -1, "last"});
+
+  EXPECT_EQ(rows.size(), 101U);
+  EXPECT_GE(rows.capacity(), rows.size());
+  s21::span<int> squares = rows.field<1>();
+  EXPECT_EQ(squares.size(), 101U);
+  EXPECT_EQ(&squares[1], &squares[0] + 1);
+  EXPECT_EQ(std::accumulate(squares.begin(), squares.end() - 1, 0), 328350);
+
+  auto [x, sq, name] = rows[10];
+  EXPECT_EQ(x, 5.0f);
+  EXPECT_EQ(sq, 100);
+  name = "ten";
+  EXPECT_EQ(rows.field<2>()[10], "ten");
+  EXPECT_EQ(std::get<2>(std::tuple<float, int, std::string>(rows.back())),
+            "last");
+  EXPECT_TRUE(rows.front() == std::make_tuple(0.0f, 0, std::string("0")));
+  EXPECT_THROW(rows.at(101), std::out_of_range);
+
+  rows.pop_back();
+  const auto& crows = rows;
+  s21::span<const float> xs = crows.field<0>();
+  EXPECT_EQ(xs.back(), 49.5f);
+  EXPECT_EQ(crows.end() - crows.begin(), 100);
+  EXPECT_EQ(crows.at(99).get<1>(), 99 * 99);
+}
+
+TEST(soaVector, AlgorithmsOnRows) {
+  s21::soa_vector<int, char> rows;
+  std::vector<std::tuple<int, char>> expected;
+  std::mt19937 gen(45);
+
+  for (int i = 0; i < 1000; ++i) {
+    const int key = int(gen() % 100);
+    rows.emplace_back(key, char('a' + i % 26));
+    expected.emplace_back(key, char('a' + i % 26));
+  }
+
+  std::sort(rows.begin(), rows.end());
+  std::sort(expected.begin(), expected.end());
+  EXPECT_TRUE(std::equal(rows.begin(), rows.end(), expected.begin()));
+
+  std::stable_sort(rows.begin(), rows.end(),
+                   [](const auto& lhs, const auto& rhs) {
+                     return std::get<1>(std::tuple<int, char>(lhs)) <
+                            std::get<1>(std::tuple<int, char>(rhs));
+                   });
+  EXPECT_TRUE(std::is_sorted(rows.field<1>().begin(), rows.field<1>().end()));
+
+  std::reverse(rows.begin(), rows.end());
+  EXPECT_EQ(rows.front().get<1>(), 'z');
+  auto it = std::find(rows.begin(), rows.end(), std::make_tuple(7, 'h'));
+  EXPECT_TRUE(it == rows.end() || (*it).get<0>() == 7);
+
+  s21::soa_vector<int, char> copy = rows;
+  EXPECT_TRUE(copy == rows);
+  copy[0] = std::make_tuple(-1, '?');
+  EXPECT_TRUE(copy != rows);
+  copy.clear();
+  EXPECT_TRUE(copy.empty());
+}
+
+TEST(soaVector, FailedPushLeavesColumnsEqual) {
+  s21::soa_vector<int, throws_on_copy> rows(3);
+  throws_on_copy bad;
+  bad.fail = true;
+
+  rows.shrink_to_fit();
+  EXPECT_THROW(rows.emplace_back(1, bad), std::runtime_error);
+  EXPECT_EQ(rows.size(), 3U);
+  EXPECT_EQ(rows.field<0>().size(), rows.field<1>().size());
+
+  rows.emplace_back(4, throws_on_copy());
+  EXPECT_EQ(rows.size(), 4U);
+  EXPECT_EQ(rows.back().get<0>(), 4);
+}
+
+TEST(soaVector, EmplaceOwnRowWhenFull) {
+  s21::soa_vector<std::string, int> s;
+  s.emplace_back("a string too long for the small buffer", 1);
+  s.shrink_to_fit();
+  ASSERT_EQ(s.size(), s.capacity());
+
+  s.emplace_back(s.field<0>()[0], s.field<1>()[0]);
+  ASSERT_EQ(s.size(), 2u);
+  EXPECT_EQ(s.field<0>()[1], "a string too long for the small buffer");
+  EXPECT_EQ(s.field<1>()[1], 1);
+  while (s.size() != s.capacity()) {
+    s.push_back(s[0]);
+  }
+  s.push_back(s[1]);
+  EXPECT_EQ(s.field<0>().back(), "a string too long for the small buffer");
+}
+
+// spanTest
+
+TEST(span, Views) {
+  int raw[] = {1, 2, 3, 4, 5};
+  s21::span<int> all(raw);
+  s21::vector<int> vec{6, 7, 8};
+  s21::span<const int> from_vec(vec);
+  const s21::array<int, 2> arr{9, 10};
+  s21::span<const int> from_arr(arr);
+
+  EXPECT_EQ(all.size(), 5U);
+  EXPECT_EQ(all.size_bytes(), 5 * sizeof(int));
+  EXPECT_EQ(all.subspan(1, 3).back(), 4);
+  EXPECT_EQ(all.subspan(3).size(), 2U);
+  EXPECT_EQ(all.first(2).back(), 2);
+  EXPECT_EQ(all.last(2).front(), 4);
+  EXPECT_EQ(from_vec[2], 8);
+  EXPECT_EQ(from_arr.data(), arr.data());
+  EXPECT_THROW(from_arr.at(2), std::out_of_range);
+  EXPECT_TRUE(s21::span<int>().empty());
+
+  s21::span<const int> read_only = all;
+  all[0] = 11;
+  EXPECT_EQ(read_only.front(), 11);
+}
+
+// serializeTest
+
+TEST(serialize, VectorRoundTrip) {
+  std::stringstream stream;
+  s21::vector<double> doubles;
+  s21::vector<std::string> words{"", "one", std::string(1000, 'x')};
+  s21::vector<s21::vector<int>> nested{{1, 2}, {}, {3}};
+
+  for (int i = 0; i < 10000; ++i) {
+    doubles.push_back(i * 0.25);
+  }
+  s21::serialize(stream, doubles);
+  s21::serialize(stream, words);
+  s21::serialize(stream, nested);
+  s21::serialize(stream, s21::vector<int>());
+
+  s21::vector<double> doubles_in{1.0};
+  s21::vector<std::string> words_in;
+  s21::vector<s21::vector<int>> nested_in;
+  s21::vector<int> empty_in{1, 2, 3};
+  s21::deserialize(stream, doubles_in);
+  s21::deserialize(stream, words_in);
+  s21::deserialize(stream, nested_in);
+  s21::deserialize(stream, empty_in);
+
+  EXPECT_TRUE(std::equal(doubles.begin(), doubles.end(), doubles_in.begin(),
+                         doubles_in.end()));
+  EXPECT_TRUE(
+      std::equal(words.begin(), words.end(), words_in.begin(), words_in.end()));
+  ASSERT_EQ(nested_in.size(), 3U);
+  EXPECT_EQ(nested_in[0][1], 2);
+  EXPECT_TRUE(nested_in[1].empty());
+  EXPECT_EQ(nested_in[2][0], 3);
+  EXPECT_TRUE(empty_in.empty());
+  EXPECT_EQ(stream.peek(), EOF);
+}
+
+TEST(serialize, OrderedRoundTrip) {
+  std::mt19937 gen(46);
+  s21::set<int> numbers;
+  s21::multiset<std::string> names;
+  s21::map<int, std::string> labels;
+
+  for (int i = 0; i < 5000; ++i) {
+    const int key = int(gen() % 100000);
+    numbers.insert(key);
+    names.insert(std::to_string(key % 50));
+    labels.insert(key, std::to_string(i));
+  }
+
+  std::stringstream stream;
+  s21::serialize(stream, numbers);
+  s21::serialize(stream, names);
+  s21::serialize(stream, labels);
+
+  s21::set<int> numbers_in{-1};
+  s21::multiset<std::string> names_in;
+  s21::map<int, std::string> labels_in;
+  s21::deserialize(stream, numbers_in);
+  s21::deserialize(stream, names_in);
+  s21::deserialize(stream, labels_in);
+
+  EXPECT_TRUE(std::equal(numbers.begin(), numbers.end(), numbers_in.begin(),
+                         numbers_in.end()));
+  EXPECT_TRUE(std::equal(names.begin(), names.end(), names_in.begin(),
+                         names_in.end()));
+  EXPECT_TRUE(std::equal(labels.begin(), labels.end(), labels_in.begin(),
+                         labels_in.end()));
+  EXPECT_GT(black_height(numbers_in.end().node_base_->parent_), 0);
+  EXPECT_GT(black_height(labels_in.end().node_base_->parent_), 0);
+  labels_in.insert(-5, "new");
+  EXPECT_EQ(labels_in.begin()->second, "new");
+}
+
+TEST(serialize, BoolsAndEnums) {
+  enum class shade : std::uint8_t { light, dark };
+  std::stringstream stream;
+  s21::serialize(stream, s21::map<int, bool>{{1, true}, {2, false}});
+  s21::serialize(stream, s21::vector<shade>{shade::dark, shade::light});
+
+  s21::map<int, bool> flags;
+  s21::vector<shade> shades;
+  s21::deserialize(stream, flags);
+  s21::deserialize(stream, shades);
+  EXPECT_TRUE(flags.at(1));
+  EXPECT_FALSE(flags.at(2));
+  ASSERT_EQ(shades.size(), 2U);
+  EXPECT_EQ(shades[0], shade::dark);
+
+  // A bool is one byte, 0 or 1; anything else is rejected.
+  std::stringstream bools;
+  s21::serialize(bools, s21::vector<bool>{true});
+  std::string bad = bools.str();
+  bad[20] = 2;
+  std::stringstream bad_stream(bad);
+  s21::vector<bool> bools_in;
+  EXPECT_THROW(s21::deserialize(bad_stream, bools_in), std::runtime_error);
+}
+
+TEST(serialize, RejectsBadStreams) {
+  std::stringstream stream;
+  s21::serialize(stream, s21::vector<int>{1, 2, 3});
+  const std::string bytes = stream.str();
+
+  s21::vector<int> ints{9};
+  s21::vector<long long> longs;
+  s21::set<int> set_ints;
+
+  std::stringstream wrong_type(bytes);
+  EXPECT_THROW(s21::deserialize(wrong_type, longs), std::runtime_error);
+  std::stringstream wrong_kind(bytes);
+  EXPECT_THROW(s21::deserialize(wrong_kind, set_ints), std::runtime_error);
+  std::stringstream truncated(bytes.substr(0, bytes.size() - 1));
+  EXPECT_THROW(s21::deserialize(truncated, ints), std::runtime_error);
+  EXPECT_EQ(ints.size(), 1U);
+
+  std::string newer = bytes;
+  newer[4] = 2;
+  std::stringstream newer_stream(newer);
+  EXPECT_THROW(s21::deserialize(newer_stream, ints), std::runtime_error);
+  std::stringstream garbage("not a container");
+  EXPECT_THROW(s21::deserialize(garbage, ints), std::runtime_error);
+  std::stringstream empty;
+  EXPECT_THROW(s21::deserialize(empty, ints), std::runtime_error);
+  EXPECT_EQ(ints[0], 9);
+
+  // Counts and lengths far beyond the data must not be allocated up front.
+  for (std::uint64_t count : {std::uint64_t(1) << 34, std::uint64_t(1) << 60,
+                              ~std::uint64_t(0)}) {
+    std::string huge = bytes;
+    std::memcpy(&huge[12], &count, sizeof(count));
+    std::stringstream huge_stream(huge);
+    EXPECT_THROW(s21::deserialize(huge_stream, ints), std::runtime_error);
+
+    std::stringstream strings;
+    s21::serialize(strings, s21::vector<std::string>{"abc"});
+    std::string long_string = strings.str();
+    std::memcpy(&long_string[20], &count, sizeof(count));
+    std::stringstream long_stream(long_string);
+    s21::vector<std::string> words;
+    EXPECT_THROW(s21::deserialize(long_stream, words), std::runtime_error);
+  }
+  EXPECT_EQ(ints.size(), 1U);
+
+  std::stringstream nothing;
+  s21::serialize(nothing, s21::vector<int>());
+  s21::deserialize(nothing, ints);
+  EXPECT_TRUE(ints.empty());
+}
+
+// frozenMapTest
+
+TEST(frozenMap, LookupsMatchMap) {
+  std::mt19937 gen(47);
+
+  for (auto layout : {s21::frozen_layout::sorted,
+                      s21::frozen_layout::eytzinger}) {
+    for (int n : {0, 1, 2, 6, 7, 8, 1000}) {
+      s21::map<int, double> tree;
+      while (int(tree.size()) < n) {
+        tree.insert(int(gen() % 5000) * 2, double(tree.size()));
+      }
+
+      const std::string path = testing::TempDir() + "s21_frozen_map_test";
+      tree.write_frozen(path, layout);
+      const s21::frozen_map_view<int, double> view(path);
+      std::remove(path.c_str());
+
+      EXPECT_EQ(view.layout(), layout);
+      EXPECT_EQ(view.size(), tree.size());
+      EXPECT_EQ(view.empty(), tree.empty());
+      EXPECT_TRUE(std::equal(
+          tree.begin(), tree.end(), view.begin(), view.end(),
+          [](const auto& lhs, const auto& rhs) {
+            return lhs.first == rhs.first && lhs.second == rhs.second;
+          }));
+
+      for (int key = -1; key <= 10001; ++key) {
+        const auto lower = tree.lower_bound(key);
+        const auto upper = tree.upper_bound(key);
+        const auto view_lower = view.lower_bound(key);
+        const auto view_upper = view.upper_bound(key);
+
+        ASSERT_EQ(lower == tree.end(), view_lower == view.end());
+        ASSERT_EQ(upper == tree.end(), view_upper == view.end());
+        if (lower != tree.end()) {
+          ASSERT_EQ(lower->first, view_lower->first);
+        }
+        if (upper != tree.end()) {
+          ASSERT_EQ(upper->first, view_upper->first);
+        }
+        ASSERT_EQ(tree.contains(key), view.contains(key));
+      }
+      if (n > 0) {
+        EXPECT_EQ(view.at(tree.begin()->first), tree.begin()->second);
+      }
+      EXPECT_THROW(view.at(1), std::out_of_range);
+    }
+  }
+}
+
+TEST(frozenMap, RejectsBadFiles) {
+  const std::string path = testing::TempDir() + "s21_frozen_map_bad";
+  s21::map<std::uint64_t, float> tree{{1, 1.5f}, {2, 2.5f}};
+
+  tree.write_frozen(path, s21::frozen_layout::sorted);
+  using wrong_value = s21::frozen_map_view<std::uint64_t, double>;
+  EXPECT_THROW(wrong_value view(path), std::runtime_error);
+
+  s21::frozen_map_view<std::uint64_t, float> view(path);
+  s21::frozen_map_view<std::uint64_t, float> moved(std::move(view));
+  EXPECT_EQ(moved.at(2), 2.5f);
+  EXPECT_TRUE(view.empty());
+
+  // Offsets that wrap the file size around must not pass the checks.
+  s21::map<std::uint64_t, float> wide;
+  for (std::uint64_t i = 0; i < 20; ++i) {
+    wide.insert(i, float(i));
+  }
+  for (std::size_t field : {offsetof(s21::details::frozen_map_header,
+                                     keys_offset_),
+                            offsetof(s21::details::frozen_map_header,
+                                     values_offset_)}) {
+    wide.write_frozen(path, s21::frozen_layout::sorted);
+    const std::uint64_t huge = ~std::uint64_t(63);
+    std::fstream file(path, std::ios::binary | std::ios::in | std::ios::out);
+    file.seekp(std::streamoff(field));
+    file.write(reinterpret_cast<const char*>(&huge), sizeof(huge));
+    file.close();
+    EXPECT_THROW((s21::frozen_map_view<std::uint64_t, float>(path)),
+                 std::runtime_error);
+  }
+
+  std::stringstream serialized;
+  s21::serialize(serialized, tree);
+  std::ofstream(path, std::ios::binary) << serialized.str();
+  using view_type = s21::frozen_map_view<std::uint64_t, float>;
+  EXPECT_THROW(view_type bad(path), std::runtime_error);
+  std::remove(path.c_str());
+  EXPECT_THROW(view_type missing(path), std::runtime_error);
+}
+
+// statsTest
+
+TEST(stats, CountsOnlyWhenEnabled) {
+  s21::stats::reset();
+
+  s21::vector<int> v;
+  for (int i = 0; i < 100; ++i) {
+    v.push_back(i);
+  }
+  s21::set<int> s;
+  for (int i = 0; i < 100; ++i) {
+    s.insert(i);
+  }
+  s21::list<int> l(3);
+
+  const auto values = s21::stats::snapshot();
+  using s21::stats::container;
+  using s21::stats::event;
+
+  if (s21::stats::enabled_) {
+    EXPECT_GT(values(container::vector, event::relocations), 0u);
+    EXPECT_EQ(values(container::set, event::allocations), 100u);
+    EXPECT_GT(values(container::set, event::rotations), 0u);
+    EXPECT_EQ(values(container::set, event::insert_searches), 100u);
+    EXPECT_LE(values(container::set, event::max_insert_depth), 14u);
+    EXPECT_EQ(values(container::list, event::allocations), 3u);
+  } else {
+    for (const auto& row : values.values_) {
+      for (auto value : row) {
+        EXPECT_EQ(value, 0u);
+      }
+    }
+  }
+}
+
+TEST(stats, Dump) {
+  s21::stats::counters values{};
+  values.values_[size_t(s21::stats::container::map)]
+                [size_t(s21::stats::event::rotations)] = 7;
+
+  std::ostringstream text;
+  s21::stats::dump_text(text, values);
+  EXPECT_EQ(text.str(), "map.rotations 7\n");
+
+  std::ostringstream json;
+  s21::stats::dump_json(json, values);
+  EXPECT_NE(json.str().find("\"map\": {\"allocations\": 0"), std::string::npos);
+  EXPECT_NE(json.str().find("\"rotations\": 7"), std::string::npos);
+  EXPECT_EQ(json.str().front(), '{');
+}
+
+// treeProfileTest
+
+// Depths of the nodes below node, node itself at depth, summed.
+std::size_t depth_sum(const s21::details::rb_tree_node_base* node,
+                      std::size_t depth) {
+  return node ? depth + depth_sum(node->left_, depth + 1) +
+                    depth_sum(node->right_, depth + 1)
+              : 0;
+}
+
+TEST(treeProfile, Exact) {
+  s21::set<int> s;
+  for (int i = 0; i < 1000; ++i) {
+    s.insert(i * 7919 % 1000);
+  }
+
+  const s21::tree_profile p = s.profile();
+  const auto* root = s.end().node_base_->parent_;
+
+  EXPECT_EQ(p.size_, 1000u);
+  EXPECT_EQ(p.paths_, 1000u);
+  EXPECT_EQ(p.red_ + p.black_, 1000u);
+  EXPECT_EQ(int(p.black_height_) + 1, black_height(root));
+  EXPECT_EQ(p.depth_sum_, depth_sum(root, 1));
+  EXPECT_GE(p.height_, 10u);
+  EXPECT_LE(p.height_, 20u);
+  EXPECT_LT(p.average_depth(), double(p.height_));
+  EXPECT_GE(p.max_pages_, 1u);
+  EXPECT_LE(p.max_pages_, p.height_);
+  EXPECT_GE(p.fragmentation(), 0.0);
+  EXPECT_LE(p.fragmentation(), 1.0);
+  EXPECT_GT(p.red_ratio(), 0.0);
+  EXPECT_LT(p.red_ratio(), 1.0);
+
+  const s21::tree_profile empty = s21::map<int, int>().profile();
+  EXPECT_EQ(empty.paths_, 0u);
+  EXPECT_EQ(empty.average_depth(), 0.0);
+  EXPECT_EQ(empty.fragmentation(), 0.0);
+}
+
+TEST(treeProfile, Sampled) {
+  s21::multiset<int> s;
+  for (int i = 0; i < 5000; ++i) {
+    s.insert(i % 100);
+  }
+
+  const s21::tree_profile exact = s.profile();
+  const s21::tree_profile sampled = s.profile(64, 7);
+
+  EXPECT_EQ(sampled.paths_, 64u);
+  EXPECT_EQ(sampled.black_height_, exact.black_height_);
+  EXPECT_EQ(sampled.red_ + sampled.black_, sampled.depth_sum_);
+  EXPECT_LE(sampled.height_, exact.height_);
+  EXPECT_GE(sampled.average_depth(), double(exact.black_height_));
+  EXPECT_EQ(s.profile(64, 7).depth_sum_, sampled.depth_sum_);
+}
+
+// treeCompactTest
+
+TEST(treeCompact, InOrderKeepsShape) {
+  s21::map<int, std::string> m;
+  std::map<int, std::string> expected;
+  std::mt19937 gen(50);
+
+  for (int i = 0; i < 3000; ++i) {
+    const int key = int(gen() % 2000);
+
+    if (gen() % 3 == 0) {
+      m.erase(key), expected.erase(key);
+    } else {
+      m.insert({key, std::to_string(key)});
+      expected.insert({key, std::to_string(key)});
+    }
+  }
+
+  const s21::tree_profile before = m.profile();
+  m.compact(s21::compact_order::in_order);
+  const s21::tree_profile after = m.profile();
+
+  EXPECT_EQ(after.depth_sum_, before.depth_sum_);
+  EXPECT_EQ(after.height_, before.height_);
+  EXPECT_EQ(after.red_, before.red_);
+  EXPECT_GT(black_height(m.end().node_base_->parent_), 0);
+  EXPECT_TRUE(std::equal(m.begin(), m.end(), expected.begin(), expected.end()));
+
+  auto prev = m.begin();
+  for (auto it = std::next(prev); it != m.end(); prev = it++) {
+    EXPECT_EQ(reinterpret_cast<const char*>(&*it) -
+                  reinterpret_cast<const char*>(&*prev),
+              std::ptrdiff_t(sizeof(s21::details::rb_tree_node<
+                                    std::pair<const int, std::string>>)));
+  }
+
+  for (int i = 0; i < 2000; i += 2) {
+    m.erase(i), expected.erase(i);
+  }
+  m.insert({5000, "5000"}), expected.insert({5000, "5000"});
+  EXPECT_GT(black_height(m.end().node_base_->parent_), 0);
+  EXPECT_TRUE(std::equal(m.begin(), m.end(), expected.begin(), expected.end()));
+}
+
+TEST(treeCompact, VanEmdeBoas) {
+  s21::set<int> s;
+  for (int i = 0; i < 1000; ++i) {
+    s.insert(i * 7919 % 1000);
+  }
+
+  const s21::tree_profile before = s.profile();
+  s.compact(s21::compact_order::in_order);
+  const s21::tree_profile in_order = s.profile();
+  s.compact();
+  const s21::tree_profile after = s.profile();
+  const auto* root = s.end().node_base_->parent_;
+
+  EXPECT_EQ(after.depth_sum_, before.depth_sum_);
+  EXPECT_EQ(black_height(root), int(before.black_height_) + 1);
+  EXPECT_LT(after.average_pages(), in_order.average_pages());
+  int expected = 0;
+  for (auto it = s.begin(); it != s.end(); ++it) {
+    EXPECT_EQ(*it, expected++);
+    EXPECT_TRUE(std::less_equal<const void*>()(root, it.node_base_));
+  }
+
+  s.compact();
+  s.clear();
+  EXPECT_TRUE(s.empty());
+  s.compact();
+}
+
+TEST(treeCompact, Incremental) {
+  s21::multiset<int> s;
+  for (int i = 0; i < 1000; ++i) {
+    s.insert(i % 300);
+  }
+
+  int steps = 0;
+  for (auto it = s.begin(); it != s.end(); it = s.compact(it, 128)) {
+    EXPECT_EQ(s.count(7), 4u);
+    ++steps;
+  }
+  EXPECT_EQ(steps, 8);
+  EXPECT_EQ(s.size(), 1000u);
+  EXPECT_TRUE(std::is_sorted(s.begin(), s.end()));
+  EXPECT_GT(black_height(s.end().node_base_->parent_), 0);
+
+  for (int i = 0; i < 300; i += 3) {
+    s.erase(i);
+  }
+  EXPECT_EQ(s.size(), 666u);
+  EXPECT_GT(black_height(s.end().node_base_->parent_), 0);
+}
+
+// Copies, since its move may throw, and fails on the copy given.
+struct compact_throwing {
+  compact_throwing(int val) : val_(val) {}
+  compact_throwing(const compact_throwing& o) : val_(o.val_) {
+    if (--copies_left_ == 0) {
+      throw std::runtime_error("copy");
+    }
+  }
+  bool operator<(const compact_throwing& o) const { return val_ < o.val_; }
+
+  int val_;
+  static inline int copies_left_ = 0;
+};
+
+TEST(treeCompact, ThrowLeavesTree) {
+  s21::set<compact_throwing> s;
+  for (int i = 0; i < 100; ++i) {
+    s.insert(compact_throwing(i));
+  }
+  const auto* root = s.end().node_base_->parent_;
+
+  compact_throwing::copies_left_ = 50;
+  EXPECT_THROW(s.compact(), std::runtime_error);
+  compact_throwing::copies_left_ = 0;
+
+  EXPECT_EQ(s.end().node_base_->parent_, root);
+  EXPECT_EQ(s.size(), 100u);
+  int expected = 0;
+  for (const auto& item : s) {
+    EXPECT_EQ(item.val_, expected++);
+  }
+}
+
 int main(int argc, char** argv) {
   ::testing::InitGoogleTest(&argc, argv);
   return RUN_ALL_TESTS();